@@ -0,0 +1,152 @@
+//standard library
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "arn.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+/*
+ *  Each chunk holds twice as many objects as the one before it, up to
+ *  ARN_MAX_CHUNK_CAP. Small containers stay small, while large ones are
+ *  made of few chunks. A chunk holds at least min_cap objects, so a known
+ *  number of objects can be reserved with a single allocation.
+ */
+
+DBG_STATIC
+struct _arn_chunk * _arn_new_chunk(struct _cm_arn * arn, const int min_cap) {
+
+    struct _arn_chunk * chunk;
+    int cap;
+
+    if (arn->chunks == NULL) {
+        cap = ARN_MIN_CHUNK_CAP;
+    } else {
+        cap = arn->chunk_cap * 2;
+        if (cap > ARN_MAX_CHUNK_CAP) cap = ARN_MAX_CHUNK_CAP;
+    }
+    if (cap < min_cap) cap = min_cap;
+
+    chunk = malloc(sizeof(struct _arn_chunk) + (arn->obj_sz * cap));
+    if (!chunk) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    chunk->next = arn->chunks;
+    arn->chunks = chunk;
+    arn->chunk_cap = cap;
+    arn->used = 0;
+
+    return chunk;
+}
+
+
+
+/*
+ *  --- [SHARED] ---
+ */
+
+struct _cm_arn * _arn_new(const size_t obj_sz) {
+
+    struct _cm_arn * arn;
+
+    arn = malloc(sizeof(struct _cm_arn));
+    if (!arn) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    //freed objects must be able to hold the free list link
+    arn->obj_sz = ARN_ROUND(obj_sz < sizeof(void *) ? sizeof(void *) : obj_sz);
+    arn->chunk_cap = 0;
+    arn->used = 0;
+    arn->chunks = NULL;
+    arn->free_objs = NULL;
+
+    return arn;
+}
+
+
+
+void _arn_del(struct _cm_arn * arn) {
+
+    _arn_emp(arn);
+    free(arn);
+
+    return;
+}
+
+
+
+void _arn_emp(struct _cm_arn * arn) {
+
+    struct _arn_chunk * chunk = arn->chunks, * next_chunk;
+
+    while (chunk != NULL) {
+        next_chunk = chunk->next;
+        free(chunk);
+        chunk = next_chunk;
+    }
+
+    arn->chunk_cap = 0;
+    arn->used = 0;
+    arn->chunks = NULL;
+    arn->free_objs = NULL;
+
+    return;
+}
+
+
+
+void * _arn_alloc(struct _cm_arn * arn) {
+
+    void * obj;
+
+    //reuse a freed object first
+    if (arn->free_objs != NULL) {
+        obj = arn->free_objs;
+        arn->free_objs = *(void **) obj;
+        return obj;
+    }
+
+    //start a new chunk if the newest one is used up
+    if (arn->chunks == NULL || arn->used == arn->chunk_cap) {
+        if (_arn_new_chunk(arn, 0) == NULL) return NULL;
+    }
+
+    obj = arn->chunks->mem + (arn->obj_sz * arn->used);
+    arn->used++;
+
+    return obj;
+}
+
+
+
+//make sure the next n objects are handed out without allocating
+int _arn_reserve(struct _cm_arn * arn, const int n) {
+
+    if (arn->chunks != NULL && arn->chunk_cap - arn->used >= n) return 0;
+    if (_arn_new_chunk(arn, n) == NULL) return -1;
+
+    return 0;
+}
+
+
+
+void _arn_free(struct _cm_arn * arn, void * obj) {
+
+    *(void **) obj = arn->free_objs;
+    arn->free_objs = obj;
+
+    return;
+}
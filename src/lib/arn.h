@@ -0,0 +1,65 @@
+#ifndef ARN_H
+#define ARN_H
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+//number of objects in the first chunk of an arena
+#define ARN_MIN_CHUNK_CAP 16
+//chunks stop doubling in size once they hold this many objects
+#define ARN_MAX_CHUNK_CAP 4096
+//alignment of every object handed out by an arena
+#define ARN_ALIGN 16
+
+//round a size up to the alignment of arena objects
+#define ARN_ROUND(sz) (((sz) + ARN_ALIGN - 1) & ~((size_t) ARN_ALIGN - 1))
+
+
+/*
+ *  Arenas hand out fixed-size objects from large chunks by bumping a
+ *  pointer. Freed objects are kept on a free list and handed out again.
+ *  Emptying an arena frees only its chunks, so a container whose nodes
+ *  come from an arena is torn down without visiting its nodes.
+ */
+
+struct _arn_chunk {
+
+    struct _arn_chunk * next;
+    cm_byte mem[] __attribute__((aligned(ARN_ALIGN)));
+
+};
+
+
+struct _cm_arn {
+
+    size_t obj_sz;
+    int chunk_cap;               //number of objects in the newest chunk
+    int used;                    //objects handed out from the newest chunk
+    struct _arn_chunk * chunks;  //newest chunk first
+
+    void * free_objs; //freed objects, linked through their first word
+
+};
+
+
+#ifdef DEBUG
+//internal
+struct _arn_chunk * _arn_new_chunk(struct _cm_arn * arn, const int min_cap);
+#endif
+
+
+//shared with other containers
+struct _cm_arn * _arn_new(const size_t obj_sz);
+void _arn_del(struct _cm_arn * arn);
+void _arn_emp(struct _cm_arn * arn);
+
+void * _arn_alloc(struct _cm_arn * arn);
+int _arn_reserve(struct _cm_arn * arn, const int n);
+void _arn_free(struct _cm_arn * arn, void * obj);
+
+#endif
@@ -0,0 +1,701 @@
+//standard library
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "btr.h"
+#include "arn.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+//size of a node with room for cap keys, and one more
+DBG_STATIC
+size_t _btr_node_sz(const cm_btr * btr, const int cap, const bool leaf) {
+
+    size_t sz = sizeof(_btr_node) + ARN_ROUND(btr->key_sz * (cap + 1));
+
+    if (leaf) return sz + (btr->data_sz * (cap + 1));
+
+    return sz + (sizeof(_btr_node *) * (cap + 2));
+}
+
+
+
+DBG_STATIC
+_btr_node * _btr_new_node(const cm_btr * btr, const bool leaf) {
+
+    _btr_node * node;
+
+    node = aligned_alloc(BTR_LINE, leaf ? btr->leaf_sz : btr->inner_sz);
+    if (!node) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    node->len = 0;
+    node->leaf = leaf;
+    node->next = NULL;
+
+    return node;
+}
+
+
+
+/*
+ *  Returns the index of the first key of a node that is not less than a
+ *  key. found is set if that key is equal.
+ */
+
+DBG_STATIC DBG_INLINE
+int _btr_lower(const cm_btr * btr, const _btr_node * node, 
+               const void * key, bool * found) {
+
+    int lo = 0, hi = node->len, mid;
+    enum cm_rbt_side side;
+
+    *found = false;
+
+    //the keys of a node are contiguous, so this touches few cache lines
+    while (lo < hi) {
+
+        mid = lo + ((hi - lo) / 2);
+        side = btr->compare(BTR_KEY(btr, node, mid), key);
+
+        if (side == LESS) {
+            lo = mid + 1;
+        } else {
+            if (side == EQUAL) *found = true;
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+
+
+/*
+ *  Descends to the leaf that holds a key if it is present. If path is not
+ *  NULL, the inner nodes passed and the index of the child taken in each
+ *  are stored in path and idxs, from the root down.
+ */
+
+DBG_STATIC
+_btr_node * _btr_find_leaf(const cm_btr * btr, const void * key,
+                           _btr_node ** path, int * idxs) {
+
+    int idx;
+    bool found;
+    _btr_node * node = btr->root;
+
+    for (int level = 0; level < btr->height; ++level) {
+
+        //keys equal to a separator are under the child to its right
+        idx = _btr_lower(btr, node, key, &found);
+        if (found) ++idx;
+
+        if (path != NULL) {
+            path[level] = node;
+            idxs[level] = idx;
+        }
+
+        node = BTR_CHILDREN(btr, node)[idx];
+    }
+
+    return node;
+}
+
+
+
+DBG_STATIC
+void _btr_leaf_ins(const cm_btr * btr, _btr_node * leaf, const int idx,
+                   const void * key, const void * data) {
+
+    int tail = leaf->len - idx;
+
+    memmove(BTR_KEY(btr, leaf, idx + 1), 
+            BTR_KEY(btr, leaf, idx), btr->key_sz * tail);
+    memmove(BTR_DATA(btr, leaf, idx + 1), 
+            BTR_DATA(btr, leaf, idx), btr->data_sz * tail);
+
+    memcpy(BTR_KEY(btr, leaf, idx), key, btr->key_sz);
+
+    //copy the data, unless the caller will fill it in place
+    if (data != NULL) memcpy(BTR_DATA(btr, leaf, idx), data, btr->data_sz);
+
+    leaf->len += 1;
+
+    return;
+}
+
+
+
+DBG_STATIC
+void _btr_leaf_rem(const cm_btr * btr, _btr_node * leaf, const int idx) {
+
+    int tail = leaf->len - idx - 1;
+
+    memmove(BTR_KEY(btr, leaf, idx), 
+            BTR_KEY(btr, leaf, idx + 1), btr->key_sz * tail);
+    memmove(BTR_DATA(btr, leaf, idx), 
+            BTR_DATA(btr, leaf, idx + 1), btr->data_sz * tail);
+
+    leaf->len -= 1;
+
+    return;
+}
+
+
+
+//insert a key at an index of an inner node, and a child to its right
+DBG_STATIC
+void _btr_inner_ins(const cm_btr * btr, _btr_node * node, const int idx,
+                    const void * key, _btr_node * child) {
+
+    int tail = node->len - idx;
+    _btr_node ** children = BTR_CHILDREN(btr, node);
+
+    memmove(BTR_KEY(btr, node, idx + 1), 
+            BTR_KEY(btr, node, idx), btr->key_sz * tail);
+    memmove(&children[idx + 2], 
+            &children[idx + 1], sizeof(_btr_node *) * tail);
+
+    memcpy(BTR_KEY(btr, node, idx), key, btr->key_sz);
+    children[idx + 1] = child;
+
+    node->len += 1;
+
+    return;
+}
+
+
+
+//remove a key at an index of an inner node, and the child to its right
+DBG_STATIC
+void _btr_inner_rem(const cm_btr * btr, _btr_node * node, const int idx) {
+
+    int tail = node->len - idx - 1;
+    _btr_node ** children = BTR_CHILDREN(btr, node);
+
+    memmove(BTR_KEY(btr, node, idx), 
+            BTR_KEY(btr, node, idx + 1), btr->key_sz * tail);
+    memmove(&children[idx + 1], 
+            &children[idx + 2], sizeof(_btr_node *) * tail);
+
+    node->len -= 1;
+
+    return;
+}
+
+
+
+/*
+ *  Moves the upper half of an overfull node into an empty one. The middle 
+ *  key of an inner node moves up to its parent, so it is left in place 
+ *  past the end of the node for the caller to copy.
+ */
+
+DBG_STATIC
+void _btr_split(const cm_btr * btr, _btr_node * node, _btr_node * right) {
+
+    int mid = node->len / 2;
+
+    if (node->leaf) {
+
+        right->len = node->len - mid;
+        memcpy(BTR_KEY(btr, right, 0), 
+               BTR_KEY(btr, node, mid), btr->key_sz * right->len);
+        memcpy(BTR_DATA(btr, right, 0), 
+               BTR_DATA(btr, node, mid), btr->data_sz * right->len);
+
+        //link the new leaf in key order
+        right->next = node->next;
+        node->next = right;
+
+    } else {
+
+        right->len = node->len - mid - 1;
+        memcpy(BTR_KEY(btr, right, 0), 
+               BTR_KEY(btr, node, mid + 1), btr->key_sz * right->len);
+        memcpy(BTR_CHILDREN(btr, right), &BTR_CHILDREN(btr, node)[mid + 1],
+               sizeof(_btr_node *) * (right->len + 1));
+    }
+
+    node->len = mid;
+
+    return;
+}
+
+
+
+//move the greatest key of the left sibling of a child into it
+DBG_STATIC
+void _btr_borrow_left(const cm_btr * btr, _btr_node * parent, const int idx) {
+
+    _btr_node * left = BTR_CHILDREN(btr, parent)[idx - 1];
+    _btr_node * node = BTR_CHILDREN(btr, parent)[idx];
+    _btr_node ** children;
+
+    if (node->leaf) {
+
+        _btr_leaf_ins(btr, node, 0, BTR_KEY(btr, left, left->len - 1),
+                      BTR_DATA(btr, left, left->len - 1));
+        left->len -= 1;
+
+        memcpy(BTR_KEY(btr, parent, idx - 1), 
+               BTR_KEY(btr, node, 0), btr->key_sz);
+
+    } else {
+
+        //the separator moves down, and the greatest key of the left moves up
+        children = BTR_CHILDREN(btr, node);
+        memmove(BTR_KEY(btr, node, 1), 
+                BTR_KEY(btr, node, 0), btr->key_sz * node->len);
+        memmove(&children[1], &children[0], 
+                sizeof(_btr_node *) * (node->len + 1));
+
+        memcpy(BTR_KEY(btr, node, 0), 
+               BTR_KEY(btr, parent, idx - 1), btr->key_sz);
+        children[0] = BTR_CHILDREN(btr, left)[left->len];
+        node->len += 1;
+        left->len -= 1;
+
+        memcpy(BTR_KEY(btr, parent, idx - 1), 
+               BTR_KEY(btr, left, left->len), btr->key_sz);
+    }
+
+    return;
+}
+
+
+
+//move the smallest key of the right sibling of a child into it
+DBG_STATIC
+void _btr_borrow_right(const cm_btr * btr, _btr_node * parent, const int idx) {
+
+    _btr_node * node = BTR_CHILDREN(btr, parent)[idx];
+    _btr_node * right = BTR_CHILDREN(btr, parent)[idx + 1];
+    _btr_node ** children;
+
+    if (node->leaf) {
+
+        _btr_leaf_ins(btr, node, node->len, BTR_KEY(btr, right, 0),
+                      BTR_DATA(btr, right, 0));
+        _btr_leaf_rem(btr, right, 0);
+
+        memcpy(BTR_KEY(btr, parent, idx), 
+               BTR_KEY(btr, right, 0), btr->key_sz);
+
+    } else {
+
+        //the separator moves down, and the smallest key of the right moves up
+        memcpy(BTR_KEY(btr, node, node->len), 
+               BTR_KEY(btr, parent, idx), btr->key_sz);
+        BTR_CHILDREN(btr, node)[node->len + 1] = BTR_CHILDREN(btr, right)[0];
+        node->len += 1;
+
+        memcpy(BTR_KEY(btr, parent, idx), 
+               BTR_KEY(btr, right, 0), btr->key_sz);
+
+        children = BTR_CHILDREN(btr, right);
+        memmove(BTR_KEY(btr, right, 0), 
+                BTR_KEY(btr, right, 1), btr->key_sz * (right->len - 1));
+        memmove(&children[0], &children[1], sizeof(_btr_node *) * right->len);
+        right->len -= 1;
+    }
+
+    return;
+}
+
+
+
+//merge the child at an index with its right sibling, freeing the sibling
+DBG_STATIC
+void _btr_merge(const cm_btr * btr, _btr_node * parent, const int idx) {
+
+    _btr_node * left = BTR_CHILDREN(btr, parent)[idx];
+    _btr_node * right = BTR_CHILDREN(btr, parent)[idx + 1];
+
+    if (left->leaf) {
+
+        memcpy(BTR_KEY(btr, left, left->len), 
+               BTR_KEY(btr, right, 0), btr->key_sz * right->len);
+        memcpy(BTR_DATA(btr, left, left->len), 
+               BTR_DATA(btr, right, 0), btr->data_sz * right->len);
+        left->len += right->len;
+        left->next = right->next;
+
+    } else {
+
+        //the separator moves down between the keys of both nodes
+        memcpy(BTR_KEY(btr, left, left->len), 
+               BTR_KEY(btr, parent, idx), btr->key_sz);
+        memcpy(BTR_KEY(btr, left, left->len + 1), 
+               BTR_KEY(btr, right, 0), btr->key_sz * right->len);
+        memcpy(&BTR_CHILDREN(btr, left)[left->len + 1], 
+               BTR_CHILDREN(btr, right), 
+               sizeof(_btr_node *) * (right->len + 1));
+        left->len += right->len + 1;
+    }
+
+    _btr_inner_rem(btr, parent, idx);
+    free(right);
+
+    return;
+}
+
+
+
+/*
+ *  Refills nodes left less than half full by a removal, from the leaf up. 
+ *  A node borrows a key from a sibling that can spare one, or else merges 
+ *  with it, which takes a key from the parent in turn.
+ */
+
+DBG_STATIC
+void _btr_fix_rem(cm_btr * btr, _btr_node * node, 
+                  _btr_node ** path, const int * idxs) {
+
+    int level = btr->height, min, idx;
+    _btr_node * parent, ** children;
+
+    while (level > 0) {
+
+        min = node->leaf ? (btr->leaf_cap + 1) / 2 : btr->inner_cap / 2;
+        if (node->len >= min) return;
+
+        parent = path[level - 1];
+        idx = idxs[level - 1];
+        children = BTR_CHILDREN(btr, parent);
+
+        if (idx > 0 && children[idx - 1]->len > min) {
+            _btr_borrow_left(btr, parent, idx);
+            return;
+        }
+
+        if (idx < parent->len && children[idx + 1]->len > min) {
+            _btr_borrow_right(btr, parent, idx);
+            return;
+        }
+
+        _btr_merge(btr, parent, idx > 0 ? idx - 1 : idx);
+        node = parent;
+        --level;
+
+    } //end while
+
+    //the root only needs a single key, or a single child
+    if (node->len == 0) {
+
+        if (node->leaf) {
+            btr->root = NULL;
+        } else {
+            btr->root = BTR_CHILDREN(btr, node)[0];
+            btr->height -= 1;
+        }
+        free(node);
+    }
+
+    return;
+}
+
+
+
+//move an iterator past the end of a leaf on to the next leaf
+DBG_STATIC DBG_INLINE
+void _btr_iter_load(const cm_btr * btr, cm_btr_iter * iter) {
+
+    while (iter->leaf != NULL && iter->idx >= iter->leaf->len) {
+        iter->leaf = iter->leaf->next;
+        iter->idx = 0;
+    }
+
+    if (iter->leaf == NULL) {
+        iter->key = iter->data = NULL;
+        return;
+    }
+
+    iter->key = BTR_KEY(btr, iter->leaf, iter->idx);
+    iter->data = BTR_DATA(btr, iter->leaf, iter->idx);
+
+    return;
+}
+
+
+
+DBG_STATIC
+void _btr_emp_recurse(const cm_btr * btr, _btr_node * node, const int height) {
+
+    if (height > 0) {
+        for (int i = 0; i <= node->len; ++i) {
+            _btr_emp_recurse(btr, BTR_CHILDREN(btr, node)[i], height - 1);
+        }
+    }
+    free(node);
+
+    return;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_btr_get(const cm_btr * btr, const void * key, void * buf) {
+
+    void * data = cm_btr_get_p(btr, key);
+    if (!data) return -1;
+
+    memcpy(buf, data, btr->data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_btr_get_p(const cm_btr * btr, const void * key) {
+
+    int idx = 0;
+    bool found = false;
+    _btr_node * leaf = NULL;
+
+    if (btr->root != NULL) {
+        leaf = _btr_find_leaf(btr, key, NULL, NULL);
+        idx = _btr_lower(btr, leaf, key, &found);
+    }
+
+    if (!found) {
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    return BTR_DATA(btr, leaf, idx);
+}
+
+
+
+void cm_btr_first_i(const cm_btr * btr, cm_btr_iter * iter) {
+
+    _btr_node * node = btr->root;
+
+    for (int level = 0; level < btr->height; ++level) {
+        node = BTR_CHILDREN(btr, node)[0];
+    }
+
+    iter->leaf = node;
+    iter->idx = 0;
+    _btr_iter_load(btr, iter);
+
+    return;
+}
+
+
+
+void cm_btr_ceil_i(const cm_btr * btr, const void * key, cm_btr_iter * iter) {
+
+    bool found;
+
+    iter->leaf = NULL;
+    iter->idx = 0;
+
+    if (btr->root != NULL) {
+        iter->leaf = _btr_find_leaf(btr, key, NULL, NULL);
+        iter->idx = _btr_lower(btr, iter->leaf, key, &found);
+    }
+
+    //the smallest key not less than key may start the next leaf
+    _btr_iter_load(btr, iter);
+
+    return;
+}
+
+
+
+void cm_btr_next_i(const cm_btr * btr, cm_btr_iter * iter) {
+
+    iter->idx += 1;
+    _btr_iter_load(btr, iter);
+
+    return;
+}
+
+
+
+void * cm_btr_set(cm_btr * btr, const void * key, const void * data) {
+
+    _btr_node * path[BTR_MAX_HEIGHT], * spares[BTR_MAX_HEIGHT + 1];
+    _btr_node * leaf, * node, * right, * parent;
+    int idxs[BTR_MAX_HEIGHT];
+    int idx, level, splits = 0, spare_count;
+    bool found;
+    const void * sep;
+    void * slot;
+
+    //the first key creates the root
+    if (btr->root == NULL) {
+        btr->root = _btr_new_node(btr, true);
+        if (btr->root == NULL) return NULL;
+    }
+
+    leaf = _btr_find_leaf(btr, key, path, idxs);
+    idx = _btr_lower(btr, leaf, key, &found);
+
+    //if the key is present, update its data
+    if (found) {
+        slot = BTR_DATA(btr, leaf, idx);
+        if (data != NULL) memcpy(slot, data, btr->data_sz);
+        return slot;
+    }
+
+    //count the full nodes that will split, from the leaf up
+    node = leaf;
+    level = btr->height;
+    while (node->len == (node->leaf ? btr->leaf_cap : btr->inner_cap)) {
+        ++splits;
+        if (level == 0) break;
+        node = path[--level];
+    }
+
+    //allocate every new node first, so a failure leaves the tree unchanged
+    spare_count = splits == btr->height + 1 ? splits + 1 : splits;
+    for (int i = 0; i < spare_count; ++i) {
+
+        spares[i] = _btr_new_node(btr, i == 0);
+        if (spares[i] == NULL) {
+            while (i > 0) free(spares[--i]);
+            return NULL;
+        }
+    }
+
+    _btr_leaf_ins(btr, leaf, idx, key, data);
+    slot = BTR_DATA(btr, leaf, idx);
+    btr->size += 1;
+
+    //split overfull nodes, passing each right half up to the parent
+    node = leaf;
+    level = btr->height;
+    for (int i = 0; i < splits; ++i) {
+
+        right = spares[i];
+        _btr_split(btr, node, right);
+
+        //the new key may have moved to the right half of the leaf
+        if (i == 0 && idx >= node->len) {
+            slot = BTR_DATA(btr, right, idx - node->len);
+        }
+
+        sep = node->leaf ? BTR_KEY(btr, right, 0) 
+                         : BTR_KEY(btr, node, node->len);
+
+        //a split root is replaced by a new root above both halves
+        if (level == 0) {
+            parent = spares[splits];
+            BTR_CHILDREN(btr, parent)[0] = node;
+            _btr_inner_ins(btr, parent, 0, sep, right);
+            btr->root = parent;
+            btr->height += 1;
+        } else {
+            parent = path[level - 1];
+            _btr_inner_ins(btr, parent, idxs[level - 1], sep, right);
+        }
+
+        node = parent;
+        --level;
+
+    } //end for
+
+    return slot;
+}
+
+
+
+int cm_btr_rem(cm_btr * btr, const void * key) {
+
+    _btr_node * path[BTR_MAX_HEIGHT], * leaf = NULL;
+    int idxs[BTR_MAX_HEIGHT];
+    int idx = 0;
+    bool found = false;
+
+    if (btr->root != NULL) {
+        leaf = _btr_find_leaf(btr, key, path, idxs);
+        idx = _btr_lower(btr, leaf, key, &found);
+    }
+
+    if (!found) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    _btr_leaf_rem(btr, leaf, idx);
+    btr->size -= 1;
+
+    _btr_fix_rem(btr, leaf, path, idxs);
+
+    return 0;
+}
+
+
+
+void cm_btr_emp(cm_btr * btr) {
+
+    if (btr->root != NULL) _btr_emp_recurse(btr, btr->root, btr->height);
+
+    btr->root = NULL;
+    btr->size = 0;
+    btr->height = 0;
+
+    return;
+}
+
+
+
+void cm_new_btr(cm_btr * btr, const size_t key_sz, const size_t data_sz,
+                enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    btr->size    = 0;
+    btr->key_sz  = key_sz;
+    btr->data_sz = data_sz;
+    btr->root    = NULL;
+    btr->compare = compare;
+    btr->height  = 0;
+
+    //fit as many keys into each node as BTR_NODE_SZ allows
+    btr->leaf_cap = BTR_MIN_CAP;
+    while (_btr_node_sz(btr, btr->leaf_cap + 1, true) <= BTR_NODE_SZ) {
+        ++btr->leaf_cap;
+    }
+
+    btr->inner_cap = BTR_MIN_CAP;
+    while (_btr_node_sz(btr, btr->inner_cap + 1, false) <= BTR_NODE_SZ) {
+        ++btr->inner_cap;
+    }
+
+    //nodes are whole cache lines
+    btr->leaf_sz = BTR_ROUND(_btr_node_sz(btr, btr->leaf_cap, true));
+    btr->inner_sz = BTR_ROUND(_btr_node_sz(btr, btr->inner_cap, false));
+
+    btr->data_off = ARN_ROUND(key_sz * (btr->leaf_cap + 1));
+    btr->child_off = ARN_ROUND(key_sz * (btr->inner_cap + 1));
+
+    return;
+}
+
+
+
+void cm_del_btr(cm_btr * btr) {
+
+    cm_btr_emp(btr);
+
+    return;
+}
@@ -0,0 +1,107 @@
+#ifndef BTR_H
+#define BTR_H
+
+//standard library
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+//size of a cache line, nodes are aligned to it
+#define BTR_LINE 64
+//nodes hold as many keys as fit in this many bytes
+#define BTR_NODE_SZ 256
+//fewest keys a node is sized for, however large the keys
+#define BTR_MIN_CAP 4
+//round a size up to a whole number of cache lines
+#define BTR_ROUND(sz) (((sz) + BTR_LINE - 1) & ~((size_t) BTR_LINE - 1))
+//deepest a tree can grow, each level at least doubles the number of leaves
+#define BTR_MAX_HEIGHT 32
+
+
+/*
+ *  Each node is a single allocation holding its keys next to each other,
+ *  followed by the data of each key in a leaf, or by the children of an
+ *  inner node. Every node has room for one key more than its capacity, so
+ *  a full node takes the new key first and is split afterwards.
+ *
+ *  The i-th key of an inner node is the smallest key under its (i + 1)-th
+ *  child.
+ */
+
+struct _cm_btr_node {
+
+    int len;
+    bool leaf;
+    struct _cm_btr_node * next; //next leaf in key order, or NULL
+
+    cm_byte mem[] __attribute__((aligned(16)));
+
+};
+typedef struct _cm_btr_node _btr_node;
+
+
+//get the key at an index of a node
+#define BTR_KEY(btr, node, idx) \
+    ((void *) ((node)->mem + ((size_t) (idx) * (btr)->key_sz)))
+
+//get the data at an index of a leaf
+#define BTR_DATA(btr, leaf, idx) \
+    ((void *) ((leaf)->mem + (btr)->data_off \
+               + ((size_t) (idx) * (btr)->data_sz)))
+
+//get the children of an inner node
+#define BTR_CHILDREN(btr, node) \
+    ((_btr_node **) ((node)->mem + (btr)->child_off))
+
+
+#ifdef DEBUG
+//internal
+size_t _btr_node_sz(const cm_btr * btr, const int cap, const bool leaf);
+_btr_node * _btr_new_node(const cm_btr * btr, const bool leaf);
+int _btr_lower(const cm_btr * btr, const _btr_node * node, 
+               const void * key, bool * found);
+_btr_node * _btr_find_leaf(const cm_btr * btr, const void * key,
+                           _btr_node ** path, int * idxs);
+
+void _btr_leaf_ins(const cm_btr * btr, _btr_node * leaf, const int idx,
+                   const void * key, const void * data);
+void _btr_leaf_rem(const cm_btr * btr, _btr_node * leaf, const int idx);
+void _btr_inner_ins(const cm_btr * btr, _btr_node * node, const int idx,
+                    const void * key, _btr_node * child);
+void _btr_inner_rem(const cm_btr * btr, _btr_node * node, const int idx);
+void _btr_split(const cm_btr * btr, _btr_node * node, _btr_node * right);
+
+void _btr_borrow_left(const cm_btr * btr, _btr_node * parent, const int idx);
+void _btr_borrow_right(const cm_btr * btr, _btr_node * parent, const int idx);
+void _btr_merge(const cm_btr * btr, _btr_node * parent, const int idx);
+void _btr_fix_rem(cm_btr * btr, _btr_node * node, 
+                  _btr_node ** path, const int * idxs);
+
+void _btr_iter_load(const cm_btr * btr, cm_btr_iter * iter);
+void _btr_emp_recurse(const cm_btr * btr, _btr_node * node, const int height);
+#endif
+
+
+//external
+int cm_btr_get(const cm_btr * btr, const void * key, void * buf);
+void * cm_btr_get_p(const cm_btr * btr, const void * key);
+
+void cm_btr_first_i(const cm_btr * btr, cm_btr_iter * iter);
+void cm_btr_ceil_i(const cm_btr * btr, const void * key, cm_btr_iter * iter);
+void cm_btr_next_i(const cm_btr * btr, cm_btr_iter * iter);
+
+void * cm_btr_set(cm_btr * btr, const void * key, const void * data);
+int cm_btr_rem(cm_btr * btr, const void * key);
+void cm_btr_emp(cm_btr * btr);
+
+void cm_new_btr(cm_btr * btr, const size_t key_sz, const size_t data_sz,
+                enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_del_btr(cm_btr * btr);
+
+#endif
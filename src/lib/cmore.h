@@ -7,6 +7,9 @@ extern "C"{
 
 //standard library
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 //system headers
 #include <unistd.h>
@@ -22,6 +25,11 @@ typedef unsigned char cm_byte;
 
 
 
+// [arena]
+struct _cm_arn; //chunked node allocator, opaque
+
+
+
 // [list]
 struct _cm_lst_node {
 
@@ -29,18 +37,187 @@ struct _cm_lst_node {
     struct _cm_lst_node * next;
     struct _cm_lst_node * prev;
 
+    //holds the data of CM_LST_INLINE & CM_LST_ARENA lists
+    cm_byte inl[] __attribute__((aligned(16)));
+
 };
 typedef struct _cm_lst_node cm_lst_node;
 
 
+//where the data of each node is stored
+enum cm_lst_mode {CM_LST_SEPARATE, CM_LST_INLINE, CM_LST_ARENA};
+
+
 typedef struct {
 
     int len;
     size_t data_sz;
     cm_lst_node * head;
 
+    enum cm_lst_mode mode;
+
+    cm_lst_node * cursor; //last node traversed to, NULL if unknown
+    int cursor_idx;
+
+    struct _cm_arn * arn; //node allocator of CM_LST_ARENA lists
+
 } cm_lst;
 
+/*
+ *  By default each node of a list points to a separate allocation holding 
+ *  its data. Lists created with cm_new_lst_inl() instead store the data 
+ *  at the end of the node itself, in the same allocation. In both cases 
+ *  node->data points to the data, so the two modes are used identically.
+ *
+ *  Lists created with cm_new_lst_arn() store the data inline too, but take 
+ *  their nodes from chunks owned by the list. Emptying or deleting such a 
+ *  list frees only the chunks, without visiting each node. Nodes unlinked 
+ *  from an arena list remain valid until the list is emptied or deleted, 
+ *  and must not be passed to cm_del_lst_node().
+ */
+
+
+typedef struct {
+
+    cm_lst_node * next; //next node to visit
+    int remaining;      //number of nodes left to visit
+
+} cm_lst_iter;
+
+/*
+ *  cm_lst_foreach() visits every node of a list from the head, and 
+ *  cm_lst_foreach_rev() from the tail. The next node is fetched before the 
+ *  body runs, so the body may remove the current node, but no other:
+ *
+ *      cm_lst_node * node;
+ *
+ *      cm_lst_foreach(&list, node) {
+ *          if (((struct region *) node->data)->start == 0) 
+ *              cm_lst_rem_n(&list, node);
+ *      }
+ */
+
+#define cm_lst_foreach(list, node) \
+    for (cm_lst_iter _iter_##node = {(list)->head, (list)->len}; \
+         _iter_##node.remaining-- > 0 \
+         && ((node) = _iter_##node.next, \
+             _iter_##node.next = (node)->next, 1); )
+
+#define cm_lst_foreach_rev(list, node) \
+    for (cm_lst_iter _iter_##node \
+             = {(list)->len > 1 ? (list)->head->prev : (list)->head, \
+                (list)->len}; \
+         _iter_##node.remaining-- > 0 \
+         && ((node) = _iter_##node.next, \
+             _iter_##node.next = (node)->prev, 1); )
+
+
+
+// [intrusive list]
+struct _cm_ilst_link {
+
+    struct _cm_ilst_link * next;
+    struct _cm_ilst_link * prev;
+
+};
+typedef struct _cm_ilst_link cm_ilst_link;
+
+
+typedef struct {
+
+    int len;
+    cm_ilst_link * head;
+
+} cm_ilst;
+
+/*
+ *  An intrusive list does not allocate anything. Instead, the user embeds 
+ *  a cm_ilst_link inside their own structure and links that. The structure 
+ *  a link belongs to is recovered with cm_ilst_entry():
+ *
+ *      struct region {
+ *          uintptr_t start;
+ *          cm_ilst_link link;
+ *      };
+ *
+ *      struct region * r = cm_ilst_entry(list.head, struct region, link);
+ */
+
+#define cm_ilst_entry(link, type, member) \
+    ((type *) ((cm_byte *) (link) - offsetof(type, member)))
+
+
+
+// [unrolled list]
+struct _cm_ulst_node {
+
+    int len; //number of elements stored in this node
+    struct _cm_ulst_node * next;
+    struct _cm_ulst_node * prev;
+
+    cm_byte data[];
+
+};
+typedef struct _cm_ulst_node cm_ulst_node;
+
+
+typedef struct {
+
+    int len;
+    int node_cap; //maximum number of elements per node
+    size_t data_sz;
+    cm_ulst_node * head;
+
+    cm_ulst_node * cursor; //last node traversed to, NULL if unknown
+    int cursor_idx;        //index of the first element of the cursor node
+
+} cm_ulst;
+
+/*
+ *  An unrolled list stores a small array of elements in each node, so 
+ *  neighbouring elements usually share a cache line and an allocation. 
+ *  Like a cm_lst, it is circular. Elements are addressed by index, or by a 
+ *  node and a position inside that node. Because elements move between 
+ *  nodes as the list changes, pointers to elements and nodes are only 
+ *  valid until the list is next modified.
+ */
+
+#define cm_ulst_elem(list, node, pos) \
+    ((void *) ((node)->data + ((size_t) (pos) * (list)->data_sz)))
+
+
+
+// [lock-free queues]
+struct _cm_ebr; //memory reclamation state, opaque
+
+
+typedef struct {
+
+    cm_lst_node * head; //popped from by the consumer
+    cm_lst_node * tail __attribute__((aligned(64))); //pushed to by producers
+    size_t data_sz;
+
+} cm_mpsc;
+
+
+typedef struct {
+
+    cm_lst_node * head;
+    cm_lst_node * tail __attribute__((aligned(64)));
+    size_t data_sz;
+
+    struct _cm_ebr * ebr;
+
+} cm_mpmc;
+
+/*
+ *  Lock-free queues are made of cm_lst_node nodes linked through their 
+ *  next pointer, with each element stored inline at the end of its node. 
+ *  The head is always a dummy node whose element was already popped. The 
+ *  head and the tail sit on separate cache lines, so producers and 
+ *  consumers do not contend with each other.
+ */
+
 
 
 // [vector]
@@ -53,12 +230,42 @@ typedef struct {
 
 } cm_vct;
 
+/*
+ *  cm_vct_foreach() points elem at each element of a vector in turn, and 
+ *  cm_vct_foreach_rev() does so from the last element. elem may be a 
+ *  pointer to any type. The vector must not be resized by the body:
+ *
+ *      struct region * r;
+ *
+ *      cm_vct_foreach(&vector, r) {
+ *          r->start += offset;
+ *      }
+ */
+
+#define cm_vct_foreach(vector, elem) \
+    for (cm_byte * _end_##elem = ((elem) = (vector)->data, \
+             (cm_byte *) (vector)->data \
+             + ((size_t) (vector)->len * (vector)->data_sz)); \
+         (cm_byte *) (elem) < _end_##elem; \
+         (elem) = (void *) ((cm_byte *) (elem) + (vector)->data_sz))
+
+#define cm_vct_foreach_rev(vector, elem) \
+    for (cm_byte * _pos_##elem = (cm_byte *) (vector)->data \
+             + ((size_t) (vector)->len * (vector)->data_sz); \
+         _pos_##elem > (cm_byte *) (vector)->data \
+         && ((elem) = (void *) (_pos_##elem -= (vector)->data_sz), 1); )
+
 
 
 // [red-black tree]
 enum cm_rbt_colour {RED, BLACK};
 enum cm_rbt_side {LESS, EQUAL, MORE, ROOT};
 
+//where the nodes of a tree are allocated from
+enum cm_rbt_mode {CM_RBT_SEPARATE, CM_RBT_INLINE, CM_RBT_ARENA};
+
+struct _cm_rbt_sync; //concurrent access state, opaque
+
 
 struct _cm_rbt_node {
 
@@ -67,15 +274,31 @@ struct _cm_rbt_node {
 
     struct _cm_rbt_node * left;
     struct _cm_rbt_node * right;
-    
-    struct _cm_rbt_node * parent;
-    enum cm_rbt_side parent_side; //if this node is parent's left or right
 
-    enum cm_rbt_colour colour; 
+    /*
+     *  Nodes are at least 8 byte aligned, so the low bits of the parent 
+     *  pointer are free. Bits 0-1 hold whether this node is its parent's 
+     *  left or right, and bit 2 holds its colour.
+     */
+    uintptr_t parent_bits;
+
+    //holds the key & data of CM_RBT_INLINE & CM_RBT_ARENA trees, aligned 
+    //to 16 bytes like a malloc()ed key & data
+    cm_byte inl[] __attribute__((aligned(16)));
 };
 typedef struct _cm_rbt_node cm_rbt_node;
 
 
+//get the parent, parent side & colour of a node, these replace the 
+//parent, parent_side & colour fields of earlier versions
+#define cm_rbt_parent(node) \
+    ((cm_rbt_node *) ((node)->parent_bits & ~(uintptr_t) 7))
+#define cm_rbt_parent_side(node) \
+    ((enum cm_rbt_side) ((node)->parent_bits & 3))
+#define cm_rbt_colour(node) \
+    ((enum cm_rbt_colour) (((node)->parent_bits >> 2) & 1))
+
+
 typedef struct {
 
     int size;
@@ -85,8 +308,32 @@ typedef struct {
 
     enum cm_rbt_side (*compare)(const void *, const void *);
 
+    enum cm_rbt_mode mode;
+    struct _cm_arn * arn; //node allocator of CM_RBT_ARENA trees
+
+    //subtree aggregate stored after the data of each node, if aug != NULL
+    size_t aug_sz;
+    size_t aug_off;
+    void (*aug)(void * aug, const void * key, const void * data,
+                const void * left_aug, const void * right_aug);
+
+    //set only for trees created with cm_new_rbt_sync()
+    struct _cm_rbt_sync * sync;
+
 } cm_rbt;
 
+
+#define cm_rbt_aug(tree, node) ((void *) ((node)->inl + (tree)->aug_off))
+
+
+//half-open interval [start, end), the key of an interval tree
+typedef struct {
+
+    uintptr_t start;
+    uintptr_t end;
+
+} cm_rbt_itv;
+
 /*
  *  When using cmore's red-black trees, you must implement a 
  *  compare() function for use with the data held by the nodes of 
@@ -97,20 +344,270 @@ typedef struct {
  *          LESS, EQUAL, MORE
  *
  *  The ROOT value is reserved for internal use.
+ *
+ *  By default the key and data of each node are separate allocations. 
+ *  Trees created with cm_new_rbt_inl() instead store both at the end of 
+ *  the node itself, so a node is a single allocation and compare() reads 
+ *  keys from next to the child pointers. node->key and node->data point to 
+ *  the key and data in every mode.
+ *
+ *  Trees created with cm_new_rbt_aug() are inline trees whose nodes also 
+ *  hold an aggregate of their subtree, such as its size or its greatest 
+ *  key. The aug() function computes a node's aggregate from its own key 
+ *  and data and the aggregates of its children, which are NULL if absent. 
+ *  It is called for every node whose subtree changes, so the aggregate of 
+ *  any node can be read with cm_rbt_aug(). If the data of a node is 
+ *  changed in place, cm_rbt_upd_n() must be called to update aggregates 
+ *  that depend on it. Trees created with cm_new_rbt_ost() keep the size of 
+ *  each subtree, which cm_rbt_rank() and cm_rbt_select() use.
+ *
+ *  Trees created with cm_new_rbt_itv() are inline trees keyed by 
+ *  cm_rbt_itv intervals, ordered by start and then by end. Each node also 
+ *  keeps the greatest end in its subtree, so the intervals overlapping a 
+ *  query are found without visiting the whole tree.
+ *
+ *  Trees created with cm_new_rbt_arn() allocate each node together with 
+ *  its key and data from chunks owned by the tree, so emptying or deleting 
+ *  the tree frees only the chunks. As with arena lists, unlinked nodes 
+ *  remain valid until the tree is emptied or deleted, and must not be 
+ *  passed to cm_del_rbt_node().
+ *
+ *  Trees created with cm_new_rbt_sync() are inline trees that many threads 
+ *  may use at once through cm_rbt_get_sync(), cm_rbt_set_sync() and 
+ *  cm_rbt_rem_sync(). Lookups take no locks and copy the data out, while 
+ *  writers are serialised. The other functions that modify a tree fail 
+ *  with CM_ERR_USER_MISMATCH on these trees, cm_rbt_emp() included, and 
+ *  other lookups may only be used while a single thread uses the tree.
+ *
+ *  cm_rbt_split(), cm_rbt_join(), cm_rbt_union(), cm_rbt_intersect() and 
+ *  cm_rbt_diff() move nodes between two trees of the same kind rather than 
+ *  copying them. Arena and concurrent trees can not be used with them.
+ */
+
+/*
+ *  cm_rbt_foreach() visits every node of a tree in key order, and 
+ *  cm_rbt_foreach_rev() in reverse key order. Each step follows parent 
+ *  pointers, so a whole traversal takes linear time. As with lists, the 
+ *  body may remove the current node, but no other.
+ */
+
+#define cm_rbt_foreach(tree, node) \
+    for (cm_rbt_node * _next_##node = cm_rbt_first_n(tree); \
+         ((node) = _next_##node) != NULL \
+         && (_next_##node = cm_rbt_next_n(node), 1); )
+
+#define cm_rbt_foreach_rev(tree, node) \
+    for (cm_rbt_node * _next_##node = cm_rbt_last_n(tree); \
+         ((node) = _next_##node) != NULL \
+         && (_next_##node = cm_rbt_prev_n(node), 1); )
+
+/*
+ *  cm_rbt_foreach_range() visits, in key order, the nodes whose keys lie in 
+ *  [lo, hi). Finding the first node takes logarithmic time, after which 
+ *  each step is the same as for cm_rbt_foreach().
+ */
+
+#define cm_rbt_foreach_range(tree, lo, hi, node) \
+    for (cm_rbt_node * _next_##node = cm_rbt_ceil(tree, lo); \
+         ((node) = _next_##node) != NULL \
+         && (tree)->compare((node)->key, (hi)) == LESS \
+         && (_next_##node = cm_rbt_next_n(node), 1); )
+
+/*
+ *  cm_rbt_foreach_overlap() visits, in key order, the nodes of an interval 
+ *  tree whose intervals overlap the interval pointed to by query. A query 
+ *  of [addr, addr + 1) finds the intervals containing addr.
+ */
+
+#define cm_rbt_foreach_overlap(tree, query, node) \
+    for (cm_rbt_node * _next_##node = cm_rbt_itv_first(tree, query); \
+         ((node) = _next_##node) != NULL \
+         && (_next_##node = cm_rbt_itv_next(tree, node, query), 1); )
+
+
+// [concurrent skip list]
+struct _cm_skl_node; //opaque
+
+
+typedef struct {
+
+    int size;
+    size_t key_sz;
+    size_t data_sz;
+    struct _cm_skl_node * head;
+
+    enum cm_rbt_side (*compare)(const void *, const void *);
+
+    struct _cm_ebr * ebr;
+
+} cm_skl;
+
+/*
+ *  A skip list is an ordered map that many threads may use at once. It 
+ *  takes the same key_sz, data_sz and compare() arguments as a red-black 
+ *  tree. Lookups take no locks and are lock-free, but not wait-free, as 
+ *  they may retry while the reclamation epoch advances. Insertions and 
+ *  removals lock only the few nodes next to the affected key. Nodes 
+ *  may be freed as soon as they are removed, so elements are copied out 
+ *  rather than handed out by pointer.
  */
 
 
+
+// [lru cache]
+//how the entry to evict is chosen
+enum cm_lru_mode {CM_LRU_LIST, CM_LRU_CLOCK};
+
+
+typedef struct {
+
+    int len;
+    int cap;
+    size_t key_sz;
+    size_t data_sz;
+
+    enum cm_lru_mode mode;
+
+    size_t entry_sz;
+    cm_byte * entries;   //every entry, allocated up front
+    int * buckets;       //hash index, first entry of each bucket or -1
+    int bucket_mask;
+    int free_idx;        //first unused entry, or -1
+
+    cm_ilst recency;     //least recently used entry first (CM_LRU_LIST)
+    int hand;            //next entry considered for eviction (CM_LRU_CLOCK)
+
+} cm_lru;
+
+/*
+ *  An LRU cache holds up to a fixed number of key and data pairs. Once it 
+ *  is full, caching a new key evicts the least recently used one. Entries 
+ *  are allocated up front and found through a hash of their key bytes, so 
+ *  lookups, insertions and evictions take constant time and never allocate. 
+ *  Caches created with cm_new_lru_clk() approximate recency with the CLOCK 
+ *  algorithm instead, so a hit only sets a flag.
+ */
+
+
+
+// [b+ tree]
+struct _cm_btr_node; //opaque
+
+
+typedef struct {
+
+    int size;
+    size_t key_sz;
+    size_t data_sz;
+    struct _cm_btr_node * root; //NULL while the tree is empty
+
+    enum cm_rbt_side (*compare)(const void *, const void *);
+
+    int height;       //number of inner levels above the leaves
+    int leaf_cap;     //most keys held by a leaf
+    int inner_cap;    //most keys held by an inner node
+    size_t leaf_sz;
+    size_t inner_sz;
+    size_t data_off;  //offset of the data after the keys of a leaf
+    size_t child_off; //offset of the children after the keys of an inner node
+
+} cm_btr;
+
+
+//position of a key in a b+ tree
+typedef struct {
+
+    struct _cm_btr_node * leaf; //NULL once past the greatest key
+    int idx;
+
+    void * key;
+    void * data;
+
+} cm_btr_iter;
+
+/*
+ *  A b+ tree is an ordered map that takes the same key_sz, data_sz and 
+ *  compare() arguments as a red-black tree. Each node spans a few cache 
+ *  lines and stores its keys next to each other, so a lookup visits a few 
+ *  wide nodes instead of many narrow ones. All keys and data are held by 
+ *  the leaves, which are linked in order for range scans. Keys and data 
+ *  move between nodes as the tree changes, so pointers to them are only 
+ *  valid until the next insertion or removal.
+ */
+
+
+#define cm_btr_foreach(btr, iter) \
+    for (cm_btr_first_i(btr, &(iter)); \
+         (iter).leaf != NULL; cm_btr_next_i(btr, &(iter)))
+
+//keys from lo up to, but not including, hi
+#define cm_btr_foreach_range(btr, lo, hi, iter) \
+    for (cm_btr_ceil_i(btr, lo, &(iter)); \
+         (iter).leaf != NULL && (btr)->compare((iter).key, hi) == LESS; \
+         cm_btr_next_i(btr, &(iter)))
+
+
+
+
+// [persistent red-black tree]
+struct _cm_prbt_node; //opaque
+
+//deepest a persistent tree can grow, twice the black height of 2^31 nodes
+#define CM_PRBT_MAX_HEIGHT 64
+
+
+typedef struct {
+
+    int size;
+    size_t key_sz;
+    size_t data_sz;
+    struct _cm_prbt_node * root; //shared with other versions
+
+    enum cm_rbt_side (*compare)(const void *, const void *);
+
+    //nodes reserved for the next update, so that it cannot fail halfway
+    struct _cm_prbt_node * spare;
+    int spare_len;
+
+} cm_prbt;
+
+
+//position of a key in a persistent tree
+typedef struct {
+
+    struct _cm_prbt_node * path[CM_PRBT_MAX_HEIGHT]; //keys still to visit
+    int depth;
+
+    const void * key; //NULL once past the greatest key
+    const void * data;
+
+} cm_prbt_iter;
+
+/*
+ *  A persistent tree is an ordered map whose versions share nodes. Each 
+ *  cm_prbt is one version, and cm_prbt_snap() takes another in constant 
+ *  time. Updating a version copies only the nodes on the path to the 
+ *  change, so that every other version is left as it was. Nodes are freed 
+ *  once no version reaches them. A version must only be used by one thread 
+ *  at a time, but snapshots may be handed to other threads.
+ */
+
+
+#define cm_prbt_foreach(tree, iter) \
+    for (cm_prbt_first_i(tree, &(iter)); \
+         (iter).key != NULL; cm_prbt_next_i(tree, &(iter)))
+
 /*
  *  --- [FUNCTIONS] ---
  */
 
 // [list]
 //0 = success, -1 = error, see cm_errno
-extern int cm_lst_get(const cm_lst * list, const int index, void * buf);
+extern int cm_lst_get(cm_lst * list, const int index, void * buf);
 //pointer = success, NULL = error, see cm_errno
-extern void * cm_lst_get_p(const cm_lst * list, const int index);
+extern void * cm_lst_get_p(cm_lst * list, const int index);
 //pointer = success, NULL = error, see cm_errno
-extern cm_lst_node * cm_lst_get_n(const cm_lst * list, const int index);
+extern cm_lst_node * cm_lst_get_n(cm_lst * list, const int index);
 
 //pointer = success, NULL = error, see cm_errno
 extern cm_lst_node * cm_lst_set(cm_lst * list, 
@@ -128,6 +625,7 @@ extern cm_lst_node * cm_lst_ins_na(cm_lst * list,
 
 //pointer = success, NULL = error, see cm_errno
 extern cm_lst_node * cm_lst_apd(cm_lst * list, const void * data);
+extern void * cm_lst_apd_slot(cm_lst * list);
 
 //pointer = success, NULL = error, see cm_errno
 extern cm_lst_node * cm_lst_uln(cm_lst * list, const int index);
@@ -137,11 +635,24 @@ extern cm_lst_node * cm_lst_uln_n(cm_lst * list, cm_lst_node * node);
 extern int cm_lst_rem(cm_lst * list, const int index);
 extern int cm_lst_rem_n(cm_lst * list, cm_lst_node * node);
 
+//0 = success, -1 = error, see cm_errno
+extern int cm_lst_splice(cm_lst * list, const int index, cm_lst * src);
+extern int cm_lst_cat(cm_lst * list, cm_lst * src);
+extern int cm_lst_split(cm_lst * list, const int index, cm_lst * dst);
+extern int cm_lst_split_n(cm_lst * list, cm_lst_node * node, cm_lst * dst);
+
+//void return
+extern void cm_lst_sort(cm_lst * list, 
+                        enum cm_rbt_side (*compare)(const void *, const void *));
+
 //0 = success, -1 = error, see cm_errno
 extern int cm_lst_emp(cm_lst * list);
 
 //void return
 extern void cm_new_lst(cm_lst * list, const size_t data_sz);
+extern void cm_new_lst_inl(cm_lst * list, const size_t data_sz);
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_lst_arn(cm_lst * list, const size_t data_sz);
 //0 = success, -1 = error, see cm_errno
 extern void cm_del_lst(cm_lst * list);
 //void return
@@ -149,6 +660,87 @@ void cm_del_lst_node(cm_lst_node * node);
 
 
 
+// [intrusive list]
+//pointer = success, NULL = error, see cm_errno
+extern cm_ilst_link * cm_ilst_get_n(const cm_ilst * list, const int index);
+
+//pointer = success, NULL = error, see cm_errno
+extern cm_ilst_link * cm_ilst_ins(cm_ilst * list, 
+                                  const int index, cm_ilst_link * link);
+//pointer return
+extern cm_ilst_link * cm_ilst_ins_nb(cm_ilst * list,
+                                     cm_ilst_link * node, cm_ilst_link * link);
+extern cm_ilst_link * cm_ilst_ins_na(cm_ilst * list,
+                                     cm_ilst_link * node, cm_ilst_link * link);
+extern cm_ilst_link * cm_ilst_apd(cm_ilst * list, cm_ilst_link * link);
+
+//pointer = success, NULL = error, see cm_errno
+extern cm_ilst_link * cm_ilst_uln(cm_ilst * list, const int index);
+//pointer return
+extern cm_ilst_link * cm_ilst_uln_n(cm_ilst * list, cm_ilst_link * link);
+
+//void return
+extern void cm_ilst_emp(cm_ilst * list);
+
+//void return
+extern void cm_new_ilst(cm_ilst * list);
+extern void cm_del_ilst(cm_ilst * list);
+
+
+
+// [unrolled list]
+//0 = success, -1 = error, see cm_errno
+extern int cm_ulst_get(cm_ulst * list, const int index, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_ulst_get_p(cm_ulst * list, const int index);
+extern cm_ulst_node * cm_ulst_get_n(cm_ulst * list, 
+                                    const int index, int * pos);
+
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_ulst_set(cm_ulst * list, 
+                          const int index, const void * data);
+
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_ulst_ins(cm_ulst * list, 
+                          const int index, const void * data);
+extern void * cm_ulst_ins_n(cm_ulst * list, cm_ulst_node * node, 
+                            const int pos, const void * data);
+extern void * cm_ulst_apd(cm_ulst * list, const void * data);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_ulst_rem(cm_ulst * list, const int index);
+extern int cm_ulst_rem_n(cm_ulst * list, cm_ulst_node * node, const int pos);
+
+//void return
+extern void cm_ulst_emp(cm_ulst * list);
+
+//void return
+extern void cm_new_ulst(cm_ulst * list, const size_t data_sz);
+extern void cm_del_ulst(cm_ulst * list);
+
+
+
+// [lock-free queues]
+//0 = success, -1 = error, see cm_errno
+extern int cm_mpsc_push(cm_mpsc * queue, const void * data);
+extern int cm_mpsc_pop(cm_mpsc * queue, void * buf);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_mpsc(cm_mpsc * queue, const size_t data_sz);
+//void return
+extern void cm_del_mpsc(cm_mpsc * queue);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_mpmc_push(cm_mpmc * queue, const void * data);
+extern int cm_mpmc_pop(cm_mpmc * queue, void * buf);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_mpmc(cm_mpmc * queue, const size_t data_sz);
+//void return
+extern void cm_del_mpmc(cm_mpmc * queue);
+
+
+
 // [vector]
 //0 = success, -1 = error, see cm_errno
 extern int cm_vct_get(const cm_vct * vector, const int index, void * buf);
@@ -159,6 +751,9 @@ extern void * cm_vct_get_p(const cm_vct * vector, const int index);
 extern int cm_vct_set(cm_vct * vector, const int index, const void * data);
 extern int cm_vct_ins(cm_vct * vector, const int index, const void * data);
 extern int cm_vct_apd(cm_vct * vector, const void * data);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_vct_apd_slot(cm_vct * vector);
+//0 = success, -1 = error, see cm_errno
 extern int cm_vct_rem(cm_vct * vector, const int index);
 extern int cm_vct_fit(cm_vct * vector);
 //void return
@@ -177,23 +772,322 @@ extern int cm_rbt_get(const cm_rbt * tree, const void * key, void * buf);
 //pointer = success, NULL = error, see cm_errno
 extern void * cm_rbt_get_p(const cm_rbt * tree, const void * key);
 extern cm_rbt_node * cm_rbt_get_n(const cm_rbt * tree, const void * key);
+extern cm_rbt_node * cm_rbt_get_hint(const cm_rbt * tree, 
+                                     cm_rbt_node * hint, const void * key);
+
+//pointer = node, NULL = no such node
+extern cm_rbt_node * cm_rbt_first_n(const cm_rbt * tree);
+extern cm_rbt_node * cm_rbt_last_n(const cm_rbt * tree);
+extern cm_rbt_node * cm_rbt_next_n(const cm_rbt_node * node);
+extern cm_rbt_node * cm_rbt_prev_n(const cm_rbt_node * node);
+
+//pointer = success, NULL = error, see cm_errno
+extern cm_rbt_node * cm_rbt_floor(const cm_rbt * tree, const void * key);
+extern cm_rbt_node * cm_rbt_ceil(const cm_rbt * tree, const void * key);
+extern cm_rbt_node * cm_rbt_next(const cm_rbt * tree, const void * key);
+extern cm_rbt_node * cm_rbt_prev(const cm_rbt * tree, const void * key);
+
+//rank = success, -1 = error, see cm_errno
+extern int cm_rbt_rank(const cm_rbt * tree, const void * key);
+//pointer = success, NULL = error, see cm_errno
+extern cm_rbt_node * cm_rbt_select(const cm_rbt * tree, int index);
+
+//pointer = node, NULL = no such node
+extern cm_rbt_node * cm_rbt_itv_first(const cm_rbt * tree, 
+                                      const cm_rbt_itv * query);
+extern cm_rbt_node * cm_rbt_itv_next(const cm_rbt * tree, 
+                                     const cm_rbt_node * node,
+                                     const cm_rbt_itv * query);
 
 //pointer = success, NULL = error, see cm_errno
 extern cm_rbt_node * cm_rbt_set(cm_rbt * tree, 
                                 const void * key, const void * data);
+extern cm_rbt_node * cm_rbt_set_hint(cm_rbt * tree, cm_rbt_node * hint,
+                                     const void * key, const void * data);
+extern void * cm_rbt_set_slot(cm_rbt * tree, const void * key);
+extern cm_rbt_node * cm_rbt_ins_at(cm_rbt * tree, cm_rbt_node * parent, 
+                                   const enum cm_rbt_side side, 
+                                   const void * key, const void * data);
 //0 = success, -1 = error, see cm_errno
 extern int cm_rbt_rem(cm_rbt * tree, const void * key);
+extern int cm_rbt_rem_n(cm_rbt * tree, cm_rbt_node * node);
+//count = success, -1 = error, see cm_errno
+extern int cm_rbt_rem_range(cm_rbt * tree, const void * lo, const void * hi);
 //pointer = success, NULL = error, see cm_errno
 extern cm_rbt_node * cm_rbt_uln(cm_rbt * tree, const void * key);
+extern cm_rbt_node * cm_rbt_uln_n(cm_rbt * tree, cm_rbt_node * node);
+//void return
+extern void cm_rbt_upd_n(cm_rbt * tree, cm_rbt_node * node);
+//0 = success, -1 = error, see cm_errno
+extern int cm_rbt_from_sorted(cm_rbt * tree, const void * keys, 
+                              const void * datas, const int n);
+extern int cm_rbt_split(cm_rbt * tree, const void * key, cm_rbt * right);
+extern int cm_rbt_join(cm_rbt * tree, cm_rbt * other);
+extern int cm_rbt_union(cm_rbt * tree, cm_rbt * other);
+extern int cm_rbt_intersect(cm_rbt * tree, cm_rbt * other);
+extern int cm_rbt_diff(cm_rbt * tree, cm_rbt * other);
 //void return
 extern void cm_rbt_emp(cm_rbt * tree);
 
+//0 = success, -1 = error, see cm_errno
+extern int cm_rbt_get_sync(const cm_rbt * tree, const void * key, void * buf);
+extern int cm_rbt_set_sync(cm_rbt * tree, const void * key, const void * data);
+extern int cm_rbt_rem_sync(cm_rbt * tree, const void * key);
+
 //void return
 extern void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
                        enum cm_rbt_side (*compare)(const void *, const void *));
+extern void cm_new_rbt_inl(cm_rbt * tree, 
+                           const size_t key_sz, const size_t data_sz,
+                           enum cm_rbt_side (*compare)(const void *, const void *));
+extern void cm_new_rbt_itv(cm_rbt * tree, const size_t data_sz);
+extern void cm_new_rbt_aug(cm_rbt * tree, 
+                           const size_t key_sz, const size_t data_sz,
+                           enum cm_rbt_side (*compare)(const void *, const void *),
+                           const size_t aug_sz,
+                           void (*aug)(void * aug, const void * key, 
+                                       const void * data, const void * left_aug,
+                                       const void * right_aug));
+extern void cm_new_rbt_ost(cm_rbt * tree, 
+                           const size_t key_sz, const size_t data_sz,
+                           enum cm_rbt_side (*compare)(const void *, const void *));
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_rbt_arn(cm_rbt * tree, 
+                          const size_t key_sz, const size_t data_sz,
+                          enum cm_rbt_side (*compare)(const void *, const void *));
+extern int cm_new_rbt_sync(cm_rbt * tree, 
+                           const size_t key_sz, const size_t data_sz,
+                           enum cm_rbt_side (*compare)(const void *, const void *));
+//void return
 extern void cm_del_rbt(cm_rbt * tree);
 extern void cm_del_rbt_node(cm_rbt_node * node);
 
+//side of the first key relative to the second
+extern enum cm_rbt_side cm_rbt_cmp_int(const void * k_1, const void * k_2);
+extern enum cm_rbt_side cm_rbt_cmp_uptr(const void * k_1, const void * k_2);
+
+
+/*
+ *  A tree's compare() is called through a pointer at every level of every 
+ *  lookup. CM_RBT_DEFINE(name, key_t, data_t, cmp) instead generates static 
+ *  inline functions that look keys up with cmp() inlined:
+ *
+ *      name_new(tree)                  - cm_new_rbt_inl() for key_t & data_t
+ *      name_get(tree, key, buf)        - as cm_rbt_get()
+ *      name_get_p(tree, key)           - as cm_rbt_get_p()
+ *      name_get_n(tree, key)           - as cm_rbt_get_n()
+ *      name_floor(tree, key)           - as cm_rbt_floor()
+ *      name_ceil(tree, key)            - as cm_rbt_ceil()
+ *      name_set(tree, key, data)       - as cm_rbt_set()
+ *      name_set_slot(tree, key)        - as cm_rbt_set_slot()
+ *      name_rem(tree, key)             - as cm_rbt_rem()
+ *
+ *  Keys and data are passed as key_t values and data_t pointers. cmp() is 
+ *  given two const key_t pointers and returns an enum cm_rbt_side, exactly 
+ *  like compare(). CM_RBT_CMP_NUM compares integer and pointer keys, and 
+ *  CM_RBT_CMP_MEM compares the bytes of keys. The generated tree is an 
+ *  ordinary cm_rbt, so every other cm_rbt function may also be used on it:
+ *
+ *      CM_RBT_DEFINE(rgn, uintptr_t, struct region, CM_RBT_CMP_NUM)
+ *
+ *      cm_rbt regions;
+ *      struct region * r;
+ *
+ *      rgn_new(&regions);
+ *      r = rgn_get_p(&regions, 0x400000);
+ */
+
+#define CM_RBT_CMP_NUM(k_1, k_2) \
+    (*(k_1) > *(k_2) ? MORE : (*(k_1) < *(k_2) ? LESS : EQUAL))
+
+#define CM_RBT_CMP_MEM(k_1, k_2) \
+    cm_rbt_side_of(memcmp((k_1), (k_2), sizeof(*(k_1))))
+
+//convert the sign of a memcmp() style result to a side
+static inline enum cm_rbt_side cm_rbt_side_of(const int diff) {
+
+    return diff > 0 ? MORE : (diff < 0 ? LESS : EQUAL);
+}
+
+#define CM_RBT_DEFINE(name, key_t, data_t, cmp) \
+\
+static inline enum cm_rbt_side name##_compare(const void * k_1, \
+                                              const void * k_2) { \
+    return cmp((const key_t *) k_1, (const key_t *) k_2); \
+} \
+\
+static inline void name##_new(cm_rbt * tree) { \
+    cm_new_rbt_inl(tree, sizeof(key_t), sizeof(data_t), name##_compare); \
+} \
+\
+/* returns the node holding a key, or the parent a new key would join */ \
+static inline cm_rbt_node * name##_traverse(const cm_rbt * tree, \
+                                            const key_t * key, \
+                                            enum cm_rbt_side * side) { \
+    cm_rbt_node * node = tree->root, * next_node; \
+    *side = ROOT; \
+    while (node != NULL) { \
+        *side = cmp(key, (const key_t *) node->key); \
+        if (*side == EQUAL) break; \
+        next_node = *side == LESS ? node->left : node->right; \
+        if (next_node == NULL) break; \
+        node = next_node; \
+    } \
+    return node; \
+} \
+\
+static inline cm_rbt_node * name##_get_n(const cm_rbt * tree, \
+                                         const key_t key) { \
+    enum cm_rbt_side side; \
+    cm_rbt_node * node = name##_traverse(tree, &key, &side); \
+    if (side != EQUAL) { \
+        cm_errno = CM_ERR_USER_KEY; \
+        return NULL; \
+    } \
+    return node; \
+} \
+\
+static inline cm_rbt_node * name##_floor(const cm_rbt * tree, \
+                                         const key_t key) { \
+    enum cm_rbt_side side; \
+    cm_rbt_node * node = name##_traverse(tree, &key, &side); \
+    if (node != NULL && side == LESS) node = cm_rbt_prev_n(node); \
+    if (node == NULL) cm_errno = CM_ERR_USER_KEY; \
+    return node; \
+} \
+\
+static inline cm_rbt_node * name##_ceil(const cm_rbt * tree, \
+                                        const key_t key) { \
+    enum cm_rbt_side side; \
+    cm_rbt_node * node = name##_traverse(tree, &key, &side); \
+    if (node != NULL && side == MORE) node = cm_rbt_next_n(node); \
+    if (node == NULL) cm_errno = CM_ERR_USER_KEY; \
+    return node; \
+} \
+\
+static inline data_t * name##_get_p(const cm_rbt * tree, const key_t key) { \
+    cm_rbt_node * node = name##_get_n(tree, key); \
+    return node == NULL ? NULL : (data_t *) node->data; \
+} \
+\
+static inline int name##_get(const cm_rbt * tree, \
+                             const key_t key, data_t * buf) { \
+    data_t * slot = name##_get_p(tree, key); \
+    if (slot == NULL) return -1; \
+    *buf = *slot; \
+    return 0; \
+} \
+\
+static inline cm_rbt_node * name##_set(cm_rbt * tree, \
+                                       const key_t key, const data_t * src) { \
+    enum cm_rbt_side side; \
+    cm_rbt_node * node = name##_traverse(tree, &key, &side); \
+    if (side != EQUAL) return cm_rbt_ins_at(tree, node, side, &key, src); \
+    *(data_t *) node->data = *src; \
+    return node; \
+} \
+\
+static inline data_t * name##_set_slot(cm_rbt * tree, const key_t key) { \
+    enum cm_rbt_side side; \
+    cm_rbt_node * node = name##_traverse(tree, &key, &side); \
+    if (side != EQUAL) node = cm_rbt_ins_at(tree, node, side, &key, NULL); \
+    return node == NULL ? NULL : (data_t *) node->data; \
+} \
+\
+static inline int name##_rem(cm_rbt * tree, const key_t key) { \
+    cm_rbt_node * node = name##_get_n(tree, key); \
+    if (node == NULL) return -1; \
+    return cm_rbt_rem_n(tree, node); \
+}
+
+
+
+// [concurrent skip list]
+//0 = success, -1 = error, see cm_errno
+extern int cm_skl_get(const cm_skl * skl, const void * key, void * buf);
+extern int cm_skl_ins(cm_skl * skl, const void * key, const void * data);
+extern int cm_skl_rem(cm_skl * skl, const void * key);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_skl(cm_skl * skl, const size_t key_sz, const size_t data_sz,
+                      enum cm_rbt_side (*compare)(const void *, const void *));
+//void return
+extern void cm_del_skl(cm_skl * skl);
+
+
+
+// [lru cache]
+//0 = success, -1 = error, see cm_errno
+extern int cm_lru_get(cm_lru * lru, const void * key, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_lru_get_p(cm_lru * lru, const void * key);
+
+//pointer return
+extern void * cm_lru_put(cm_lru * lru, const void * key, const void * data);
+//0 = success, -1 = error, see cm_errno
+extern int cm_lru_rem(cm_lru * lru, const void * key);
+extern int cm_lru_evict(cm_lru * lru, void * key_buf, void * data_buf);
+//void return
+extern void cm_lru_emp(cm_lru * lru);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_new_lru(cm_lru * lru, const int cap,
+                      const size_t key_sz, const size_t data_sz);
+extern int cm_new_lru_clk(cm_lru * lru, const int cap,
+                          const size_t key_sz, const size_t data_sz);
+//void return
+extern void cm_del_lru(cm_lru * lru);
+
+
+
+// [b+ tree]
+//0 = success, -1 = error, see cm_errno
+extern int cm_btr_get(const cm_btr * btr, const void * key, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_btr_get_p(const cm_btr * btr, const void * key);
+
+//void return
+extern void cm_btr_first_i(const cm_btr * btr, cm_btr_iter * iter);
+extern void cm_btr_ceil_i(const cm_btr * btr, 
+                          const void * key, cm_btr_iter * iter);
+extern void cm_btr_next_i(const cm_btr * btr, cm_btr_iter * iter);
+
+//pointer = success, NULL = error, see cm_errno
+extern void * cm_btr_set(cm_btr * btr, const void * key, const void * data);
+//0 = success, -1 = error, see cm_errno
+extern int cm_btr_rem(cm_btr * btr, const void * key);
+//void return
+extern void cm_btr_emp(cm_btr * btr);
+
+//void return
+extern void cm_new_btr(cm_btr * btr, const size_t key_sz, const size_t data_sz,
+                       enum cm_rbt_side (*compare)(const void *, const void *));
+extern void cm_del_btr(cm_btr * btr);
+
+
+
+// [persistent red-black tree]
+//0 = success, -1 = error, see cm_errno
+extern int cm_prbt_get(const cm_prbt * tree, const void * key, void * buf);
+//pointer = success, NULL = error, see cm_errno
+extern const void * cm_prbt_get_p(const cm_prbt * tree, const void * key);
+
+//void return
+extern void cm_prbt_first_i(const cm_prbt * tree, cm_prbt_iter * iter);
+extern void cm_prbt_next_i(const cm_prbt * tree, cm_prbt_iter * iter);
+
+//0 = success, -1 = error, see cm_errno
+extern int cm_prbt_set(cm_prbt * tree, const void * key, const void * data);
+extern int cm_prbt_rem(cm_prbt * tree, const void * key);
+//void return
+extern void cm_prbt_snap(const cm_prbt * tree, cm_prbt * snap);
+
+//void return
+extern void cm_new_prbt(cm_prbt * tree, 
+                        const size_t key_sz, const size_t data_sz,
+                        enum cm_rbt_side (*compare)(const void *, const void *));
+extern void cm_del_prbt(cm_prbt * tree);
+
 
 
 // [error handling]
@@ -215,6 +1109,10 @@ extern __thread int cm_errno;
 // 1XX - user errors
 #define CM_ERR_USER_INDEX       1100
 #define CM_ERR_USER_KEY         1101
+#define CM_ERR_USER_MISMATCH    1102
+#define CM_ERR_USER_EMPTY       1103
+#define CM_ERR_USER_DUPLICATE   1104
+#define CM_ERR_USER_ORDER       1105
 
 // 2XX - internal errors
 #define CM_ERR_INTERNAL_INDEX   1200
@@ -223,6 +1121,7 @@ extern __thread int cm_errno;
 // 3XX - environment errors
 #define CM_ERR_MALLOC           1300
 #define CM_ERR_REALLOC          1301
+#define CM_ERR_THREAD_LIMIT     1302
 
 
 // [error code messages]
@@ -230,6 +1129,10 @@ extern __thread int cm_errno;
 // 1XX - user errors
 #define CM_ERR_USER_INDEX_MSG       "Index out of range.\n"
 #define CM_ERR_USER_KEY_MSG         "Key not present in tree.\n"
+#define CM_ERR_USER_MISMATCH_MSG    "Containers are incompatible.\n"
+#define CM_ERR_USER_EMPTY_MSG       "Container is empty.\n"
+#define CM_ERR_USER_DUPLICATE_MSG   "Key already present.\n"
+#define CM_ERR_USER_ORDER_MSG       "Keys are not in sorted order.\n"
 
 // 2XX - internal errors
 #define CM_ERR_INTERNAL_INDEX_MSG   "Internal indexing error.\n"
@@ -238,6 +1141,7 @@ extern __thread int cm_errno;
 // 3XX - environmental errors
 #define CM_ERR_MALLOC_MSG           "Internal malloc() failed.\n"
 #define CM_ERR_REALLOC_MSG          "Internal realloc() failed.\n"
+#define CM_ERR_THREAD_LIMIT_MSG     "Too many threads use lock-free containers.\n"
 
 
 #ifdef __cplusplus
@@ -0,0 +1,243 @@
+//standard library
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+#include <pthread.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "ebr.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+/*
+ *  Every thread that uses a lock-free container is given an id, which
+ *  indexes its slot in every reclamation domain. Ids are returned when
+ *  their thread exits, so they are reused by later threads.
+ */
+
+static bool _ebr_tid_used[EBR_MAX_THREADS];
+static int _ebr_tid_max = -1;
+
+static pthread_key_t _ebr_tid_key;
+static pthread_once_t _ebr_tid_once = PTHREAD_ONCE_INIT;
+
+static __thread int _ebr_tid = -1;
+
+
+
+DBG_STATIC
+void _ebr_release_thread_id(void * tid) {
+
+    //ids are stored off by one, as NULL values are not passed to destructors
+    __atomic_store_n(&_ebr_tid_used[(long) tid - 1], false, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+static void _ebr_create_key() {
+
+    pthread_key_create(&_ebr_tid_key, _ebr_release_thread_id);
+
+    return;
+}
+
+
+
+DBG_STATIC
+int _ebr_thread_id() {
+
+    bool expected;
+    int max;
+
+    if (_ebr_tid != -1) return _ebr_tid;
+
+    pthread_once(&_ebr_tid_once, _ebr_create_key);
+
+    //claim the first free id
+    for (int i = 0; i < EBR_MAX_THREADS; ++i) {
+
+        expected = false;
+        if (!__atomic_compare_exchange_n(&_ebr_tid_used[i], &expected, true,
+                                         false, __ATOMIC_ACQ_REL,
+                                         __ATOMIC_RELAXED)) continue;
+
+        //raise the highest id in use
+        max = __atomic_load_n(&_ebr_tid_max, __ATOMIC_SEQ_CST);
+        while (max < i
+               && !__atomic_compare_exchange_n(&_ebr_tid_max, &max, i,
+                                               true, __ATOMIC_SEQ_CST,
+                                               __ATOMIC_SEQ_CST));
+
+        pthread_setspecific(_ebr_tid_key, (void *) (long) (i + 1));
+        _ebr_tid = i;
+        return i;
+
+    } //end for
+
+    cm_errno = CM_ERR_THREAD_LIMIT;
+    return -1;
+}
+
+
+
+DBG_STATIC
+void _ebr_free_limbo(const struct _cm_ebr * ebr, void * node) {
+
+    void * next_node;
+
+    while (node != NULL) {
+        next_node = EBR_LINK(ebr, node);
+        free(node);
+        node = next_node;
+    }
+
+    return;
+}
+
+
+
+/*
+ *  The epoch advances once every thread inside a critical section has
+ *  observed the current epoch.
+ */
+
+DBG_STATIC
+void _ebr_try_advance(struct _cm_ebr * ebr) {
+
+    unsigned long epoch = __atomic_load_n(&ebr->epoch, __ATOMIC_SEQ_CST);
+    int max = __atomic_load_n(&_ebr_tid_max, __ATOMIC_SEQ_CST);
+    _ebr_slot * slot;
+
+    for (int i = 0; i <= max; ++i) {
+
+        slot = &ebr->slots[i];
+        if (__atomic_load_n(&slot->active, __ATOMIC_SEQ_CST)
+            && __atomic_load_n(&slot->epoch, __ATOMIC_SEQ_CST) != epoch) {
+            return;
+        }
+    } //end for
+
+    __atomic_compare_exchange_n(&ebr->epoch, &epoch, epoch + 1, false,
+                                __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+
+    return;
+}
+
+
+
+/*
+ *  --- [SHARED] ---
+ */
+
+struct _cm_ebr * _ebr_new(const size_t link_off) {
+
+    struct _cm_ebr * ebr;
+
+    ebr = aligned_alloc(EBR_CACHE_LINE, sizeof(struct _cm_ebr));
+    if (!ebr) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    memset(ebr, 0, sizeof(struct _cm_ebr));
+    ebr->link_off = link_off;
+
+    return ebr;
+}
+
+
+
+/*
+ *  Must only be called once no other thread uses the domain.
+ */
+
+void _ebr_del(struct _cm_ebr * ebr) {
+
+    for (int i = 0; i < EBR_MAX_THREADS; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            _ebr_free_limbo(ebr, ebr->slots[i].limbo[j]);
+        }
+    } //end for
+
+    free(ebr);
+
+    return;
+}
+
+
+
+_ebr_slot * _ebr_enter(struct _cm_ebr * ebr) {
+
+    unsigned long epoch, last_epoch;
+    _ebr_slot * slot;
+
+    int tid = _ebr_thread_id();
+    if (tid == -1) return NULL;
+
+    slot = &ebr->slots[tid];
+    last_epoch = slot->epoch;
+
+    __atomic_store_n(&slot->active, true, __ATOMIC_SEQ_CST);
+
+    /*
+     *  The epoch may advance between reading it and publishing it. Retry
+     *  until the published epoch is still current, so that the epoch can
+     *  advance at most once while this thread is inside.
+     */
+
+    do {
+        epoch = __atomic_load_n(&ebr->epoch, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&slot->epoch, epoch, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    } while (epoch != __atomic_load_n(&ebr->epoch, __ATOMIC_SEQ_CST));
+
+    /*
+     *  A node retired in epoch e may still be read by threads in epoch 
+     *  e + 1. Once the epoch reaches e + 3, all of them have exited, so 
+     *  the limbo list about to be reused is freed.
+     */
+
+    if (last_epoch != epoch) {
+        _ebr_free_limbo(ebr, slot->limbo[epoch % 3]);
+        slot->limbo[epoch % 3] = NULL;
+    }
+
+    return slot;
+}
+
+
+
+void _ebr_exit(_ebr_slot * slot) {
+
+    __atomic_store_n(&slot->active, false, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+void _ebr_retire(struct _cm_ebr * ebr, _ebr_slot * slot, void * node) {
+
+    void ** limbo = &slot->limbo[slot->epoch % 3];
+
+    EBR_LINK(ebr, node) = *limbo;
+    *limbo = node;
+
+    if (++slot->retired >= EBR_ADVANCE_FREQ) {
+        slot->retired = 0;
+        _ebr_try_advance(ebr);
+    }
+
+    return;
+}
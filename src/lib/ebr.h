@@ -0,0 +1,76 @@
+#ifndef EBR_H
+#define EBR_H
+
+//standard library
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+//maximum number of threads that may use lock-free containers at once
+#define EBR_MAX_THREADS 128
+//number of retirements between attempts to advance the epoch
+#define EBR_ADVANCE_FREQ 64
+//size of a cache line
+#define EBR_CACHE_LINE 64
+
+//pointer chaining a retired node to the next one
+#define EBR_LINK(ebr, node) \
+    (*(void **) ((cm_byte *) (node) + (ebr)->link_off))
+
+
+/*
+ *  Epoch-based reclamation. A thread enters a critical section before it
+ *  reads any shared node, and exits it once done. Unlinked nodes are
+ *  retired rather than freed, and are only freed once every thread that
+ *  could still hold a pointer to them has exited its critical section.
+ *
+ *  Retired nodes are chained through a pointer inside each node, found at
+ *  an offset given when the domain is created. Concurrent readers must
+ *  never read that pointer, as it is overwritten on retirement.
+ */
+
+//per-thread state, kept on its own cache line
+typedef struct {
+
+    unsigned long epoch; //last epoch observed by the thread
+    bool active;         //true while inside a critical section
+    int retired;         //retirements since the last advance attempt
+
+    void * limbo[3]; //nodes retired in each of the last 3 epochs
+
+} __attribute__((aligned(EBR_CACHE_LINE))) _ebr_slot;
+
+
+struct _cm_ebr {
+
+    unsigned long epoch;
+    size_t link_off; //offset of the pointer chaining retired nodes
+    _ebr_slot slots[EBR_MAX_THREADS];
+
+};
+
+
+#ifdef DEBUG
+//internal
+int _ebr_thread_id();
+void _ebr_release_thread_id(void * tid);
+void _ebr_free_limbo(const struct _cm_ebr * ebr, void * node);
+void _ebr_try_advance(struct _cm_ebr * ebr);
+#endif
+
+
+//shared with other containers
+struct _cm_ebr * _ebr_new(const size_t link_off);
+void _ebr_del(struct _cm_ebr * ebr);
+
+_ebr_slot * _ebr_enter(struct _cm_ebr * ebr);
+void _ebr_exit(_ebr_slot * slot);
+void _ebr_retire(struct _cm_ebr * ebr, _ebr_slot * slot, void * node);
+
+#endif
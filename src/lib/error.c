@@ -22,6 +22,22 @@ void cm_perror(const char * prefix) {
             fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_KEY_MSG);
             break;
 
+        case CM_ERR_USER_MISMATCH:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_MISMATCH_MSG);
+            break;
+
+        case CM_ERR_USER_EMPTY:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_EMPTY_MSG);
+            break;
+
+        case CM_ERR_USER_DUPLICATE:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_DUPLICATE_MSG);
+            break;
+
+        case CM_ERR_USER_ORDER:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_USER_ORDER_MSG);
+            break;
+
         // 2XX - internal errors
         case CM_ERR_INTERNAL_INDEX:
             fprintf(stderr, "%s: %s", prefix, CM_ERR_INTERNAL_INDEX_MSG);
@@ -40,6 +56,10 @@ void cm_perror(const char * prefix) {
             fprintf(stderr, "%s: %s", prefix, CM_ERR_REALLOC_MSG);
             break;
 
+        case CM_ERR_THREAD_LIMIT:
+            fprintf(stderr, "%s: %s", prefix, CM_ERR_THREAD_LIMIT_MSG);
+            break;
+
         default:
             fprintf(stderr, "%s: %s", prefix, "Undefined error code.\n");
             break;
@@ -61,6 +81,18 @@ const char * cm_strerror(const int cm_errnum) {
         case CM_ERR_USER_KEY:
             return CM_ERR_USER_KEY_MSG;
 
+        case CM_ERR_USER_MISMATCH:
+            return CM_ERR_USER_MISMATCH_MSG;
+
+        case CM_ERR_USER_EMPTY:
+            return CM_ERR_USER_EMPTY_MSG;
+
+        case CM_ERR_USER_DUPLICATE:
+            return CM_ERR_USER_DUPLICATE_MSG;
+
+        case CM_ERR_USER_ORDER:
+            return CM_ERR_USER_ORDER_MSG;
+
         // 2XX - internal errors
         case CM_ERR_INTERNAL_INDEX:
             return CM_ERR_INTERNAL_INDEX_MSG;
@@ -74,6 +106,9 @@ const char * cm_strerror(const int cm_errnum) {
 
         case CM_ERR_REALLOC:
             return CM_ERR_REALLOC_MSG;
+
+        case CM_ERR_THREAD_LIMIT:
+            return CM_ERR_THREAD_LIMIT_MSG;
         
         default:
             return "Undefined error code.\n";
@@ -0,0 +1,234 @@
+//standard library
+#include <stdlib.h>
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "ilst.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+/*
+ *  Unlike cm_lst, an intrusive list is circular at every length; a single 
+ *  link points to itself.
+ */
+
+DBG_STATIC 
+cm_ilst_link * _ilst_traverse(const cm_ilst * list, int index) {
+
+    cm_ilst_link * link = list->head;
+
+    //walk whichever way around the list is shorter
+    if (index < 0) index += list->len;
+    if (index > list->len / 2) index -= list->len;
+
+    //traverse
+    while (index > 0) {
+        link = link->next;
+        --index;
+    }
+
+    while (index < 0) {
+        link = link->prev;
+        ++index;
+    }
+
+    return link;
+}
+
+
+
+DBG_STATIC DBG_INLINE 
+void _ilst_add_link(cm_ilst_link * link, 
+                    cm_ilst_link * prev_link, cm_ilst_link * next_link) {
+
+    link->prev = prev_link;
+    link->next = next_link;
+
+    prev_link->next = link;
+    next_link->prev = link;
+
+    return;
+}
+
+
+
+DBG_STATIC DBG_INLINE 
+void _ilst_set_head_link(cm_ilst * list, cm_ilst_link * link) {
+
+    link->next = link->prev = link;
+    list->head = link;
+
+    return;
+}
+
+
+
+DBG_STATIC DBG_INLINE 
+int _ilst_assert_index_range(const cm_ilst * list, 
+                             const int index, enum _ilst_index_mode mode) {
+   
+    /*
+     *  If inserting, maximum index needs to be +1 higher than other operations.
+     */
+
+    if (abs(index) >= (list->len + (int) mode)) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+cm_ilst_link * cm_ilst_get_n(const cm_ilst * list, const int index) {
+
+    if (_ilst_assert_index_range(list, index, INDEX)) return NULL;
+
+    //get the link
+    return _ilst_traverse(list, index);
+}
+
+
+
+cm_ilst_link * cm_ilst_ins(cm_ilst * list, 
+                           const int index, cm_ilst_link * link) {
+
+    cm_ilst_link * next_link;
+
+    if (_ilst_assert_index_range(list, index, ADD_INDEX)) return NULL;
+
+    //inserting past the last link is an append
+    if (list->len == 0 || index == list->len || index == -1) {
+        return cm_ilst_apd(list, link);
+    }
+
+    //get the link that will follow the new link
+    next_link = _ilst_traverse(list, index >= 0 ? index : index + 1);
+    _ilst_add_link(link, next_link->prev, next_link);
+
+    if (index == 0) list->head = link;
+    ++list->len;
+
+    return link;
+}
+
+
+
+cm_ilst_link * cm_ilst_ins_nb(cm_ilst * list,
+                              cm_ilst_link * node, cm_ilst_link * link) {
+
+    _ilst_add_link(link, node->prev, node);
+
+    if (list->head == node) list->head = link;
+    ++list->len;
+
+    return link;
+}
+
+
+
+cm_ilst_link * cm_ilst_ins_na(cm_ilst * list,
+                              cm_ilst_link * node, cm_ilst_link * link) {
+
+    _ilst_add_link(link, node, node->next);
+    ++list->len;
+
+    return link;
+}
+
+
+
+cm_ilst_link * cm_ilst_apd(cm_ilst * list, cm_ilst_link * link) {
+
+    //add link to list
+    if (list->len == 0) {
+        _ilst_set_head_link(list, link);
+
+    } else {
+        _ilst_add_link(link, list->head->prev, list->head);
+    }
+
+    ++list->len;
+
+    return link;
+}
+
+
+
+cm_ilst_link * cm_ilst_uln(cm_ilst * list, const int index) {
+
+    if (_ilst_assert_index_range(list, index, INDEX)) return NULL;
+
+    //get the link and unlink it from the list
+    return cm_ilst_uln_n(list, _ilst_traverse(list, index));
+}
+
+
+
+cm_ilst_link * cm_ilst_uln_n(cm_ilst * list, cm_ilst_link * link) {
+
+    //if this is the last link
+    if (list->len == 1) {
+        list->head = NULL;
+
+    } else {
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+        if (list->head == link) list->head = link->next;
+    }
+
+    --list->len;
+
+    //null out pointers
+    link->next = link->prev = NULL;
+
+    return link;
+}
+
+
+
+void cm_ilst_emp(cm_ilst * list) {
+
+    /*
+     *  Links are owned by the user, so nothing is freed. The links of an 
+     *  emptied list are left as they were.
+     */
+
+    list->len = 0;
+    list->head = NULL;
+
+    return;
+}
+
+
+
+void cm_new_ilst(cm_ilst * list) {
+
+    list->len = 0;
+    list->head = NULL;
+
+    return;
+}
+
+
+
+void cm_del_ilst(cm_ilst * list) {
+
+    cm_ilst_emp(list);
+
+    return;
+}
@@ -0,0 +1,50 @@
+#ifndef ILST_H
+#define ILST_H
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+//controls if user provided index should be verified for accessing elements
+//or for adding new elements
+enum _ilst_index_mode {INDEX = 0, ADD_INDEX = 1};
+
+
+#ifdef DEBUG
+//internal
+cm_ilst_link * _ilst_traverse(const cm_ilst * list, int index);
+
+void _ilst_add_link(cm_ilst_link * link, 
+                    cm_ilst_link * prev_link, cm_ilst_link * next_link);
+void _ilst_set_head_link(cm_ilst * list, cm_ilst_link * link);
+
+int _ilst_assert_index_range(const cm_ilst * list, 
+                             const int index, enum _ilst_index_mode mode);
+#endif
+
+
+//external
+cm_ilst_link * cm_ilst_get_n(const cm_ilst * list, const int index);
+
+cm_ilst_link * cm_ilst_ins(cm_ilst * list, 
+                           const int index, cm_ilst_link * link);
+cm_ilst_link * cm_ilst_ins_nb(cm_ilst * list,
+                              cm_ilst_link * node, cm_ilst_link * link);
+cm_ilst_link * cm_ilst_ins_na(cm_ilst * list,
+                              cm_ilst_link * node, cm_ilst_link * link);
+
+cm_ilst_link * cm_ilst_apd(cm_ilst * list, cm_ilst_link * link);
+
+cm_ilst_link * cm_ilst_uln(cm_ilst * list, const int index);
+cm_ilst_link * cm_ilst_uln_n(cm_ilst * list, cm_ilst_link * link);
+
+void cm_ilst_emp(cm_ilst * list);
+
+void cm_new_ilst(cm_ilst * list);
+void cm_del_ilst(cm_ilst * list);
+
+#endif
@@ -0,0 +1,363 @@
+//standard library
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "lru.h"
+#include "arn.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+//FNV-1a over the bytes of the key
+DBG_STATIC DBG_INLINE
+size_t _lru_hash(const cm_lru * lru, const void * key) {
+
+    const cm_byte * byte = key;
+    uint64_t hash = 0xcbf29ce484222325;
+
+    for (size_t i = 0; i < lru->key_sz; ++i) {
+        hash ^= byte[i];
+        hash *= 0x100000001b3;
+    }
+
+    return (size_t) hash;
+}
+
+
+
+/*
+ *  Returns the index of the entry holding a key, or -1. The index of the
+ *  entry before it in its bucket is stored in prev_idx, or -1 if it is
+ *  first.
+ */
+
+DBG_STATIC
+int _lru_find(const cm_lru * lru, const void * key, int * prev_idx) {
+
+    int idx = lru->buckets[_lru_hash(lru, key) & lru->bucket_mask];
+
+    *prev_idx = -1;
+
+    while (idx != -1) {
+
+        if (!memcmp(LRU_ENTRY(lru, idx)->mem, key, lru->key_sz)) return idx;
+
+        *prev_idx = idx;
+        idx = LRU_ENTRY(lru, idx)->chain;
+    }
+
+    return -1;
+}
+
+
+
+//remove an entry from the hash index
+DBG_STATIC
+void _lru_unhash(cm_lru * lru, const int idx) {
+
+    int prev_idx;
+    _lru_entry * entry = LRU_ENTRY(lru, idx);
+
+    _lru_find(lru, entry->mem, &prev_idx);
+
+    if (prev_idx == -1) {
+        lru->buckets[_lru_hash(lru, entry->mem) & lru->bucket_mask]
+            = entry->chain;
+    } else {
+        LRU_ENTRY(lru, prev_idx)->chain = entry->chain;
+    }
+
+    return;
+}
+
+
+
+//record a use of an entry
+DBG_STATIC DBG_INLINE
+void _lru_touch(cm_lru * lru, _lru_entry * entry) {
+
+    //the clock only sets a flag, so hits do not write to the recency list
+    if (lru->mode == CM_LRU_CLOCK) {
+        entry->ref = true;
+        return;
+    }
+
+    //move the entry to the most recently used end
+    if (lru->recency.head->prev != &entry->link) {
+        cm_ilst_uln_n(&lru->recency, &entry->link);
+        cm_ilst_apd(&lru->recency, &entry->link);
+    }
+
+    return;
+}
+
+
+
+//get the index of the entry to evict next, the cache must not be empty
+DBG_STATIC
+int _lru_victim(cm_lru * lru) {
+
+    _lru_entry * entry;
+    int idx;
+
+    if (lru->mode == CM_LRU_LIST) {
+        entry = cm_ilst_entry(lru->recency.head, _lru_entry, link);
+        return (int) (((cm_byte *) entry - lru->entries) / lru->entry_sz);
+    }
+
+    //sweep the hand, giving referenced entries a second chance
+    while (true) {
+
+        idx = lru->hand;
+        entry = LRU_ENTRY(lru, idx);
+        lru->hand = (lru->hand + 1) % lru->cap;
+
+        if (!entry->used) continue;
+        if (!entry->ref) return idx;
+        entry->ref = false;
+    }
+}
+
+
+
+//remove an entry from the cache and return it to the free list
+DBG_STATIC
+void _lru_sub_entry(cm_lru * lru, const int idx) {
+
+    _lru_entry * entry = LRU_ENTRY(lru, idx);
+
+    _lru_unhash(lru, idx);
+    if (lru->mode == CM_LRU_LIST) cm_ilst_uln_n(&lru->recency, &entry->link);
+
+    entry->used = false;
+    entry->chain = lru->free_idx;
+    lru->free_idx = idx;
+    --lru->len;
+
+    return;
+}
+
+
+
+DBG_STATIC
+int _lru_new(cm_lru * lru, const int cap,
+             const size_t key_sz, const size_t data_sz) {
+
+    int buckets = 1;
+
+    if (cap < 1) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    lru->cap = cap;
+    lru->key_sz = key_sz;
+    lru->data_sz = data_sz;
+    lru->entry_sz = ARN_ROUND(sizeof(_lru_entry)
+                              + ARN_ROUND(key_sz) + data_sz);
+
+    //keep at least one bucket per entry
+    while (buckets < cap) buckets *= 2;
+    lru->bucket_mask = buckets - 1;
+
+    lru->entries = aligned_alloc(ARN_ALIGN, lru->entry_sz * cap);
+    if (!lru->entries) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    lru->buckets = malloc(sizeof(int) * buckets);
+    if (!lru->buckets) {
+        free(lru->entries);
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    cm_lru_emp(lru);
+
+    return 0;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_lru_get(cm_lru * lru, const void * key, void * buf) {
+
+    void * data = cm_lru_get_p(lru, key);
+    if (!data) return -1;
+
+    memcpy(buf, data, lru->data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_lru_get_p(cm_lru * lru, const void * key) {
+
+    int prev_idx;
+    _lru_entry * entry;
+
+    int idx = _lru_find(lru, key, &prev_idx);
+    if (idx == -1) {
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    entry = LRU_ENTRY(lru, idx);
+    _lru_touch(lru, entry);
+
+    return LRU_DATA(lru, entry);
+}
+
+
+
+void * cm_lru_put(cm_lru * lru, const void * key, const void * data) {
+
+    int idx, prev_idx, bucket;
+    _lru_entry * entry;
+
+    //if the key is cached, update its data
+    idx = _lru_find(lru, key, &prev_idx);
+    if (idx != -1) {
+
+        entry = LRU_ENTRY(lru, idx);
+        _lru_touch(lru, entry);
+
+    } else {
+
+        //make room by evicting an entry
+        if (lru->free_idx == -1) _lru_sub_entry(lru, _lru_victim(lru));
+
+        idx = lru->free_idx;
+        entry = LRU_ENTRY(lru, idx);
+        lru->free_idx = entry->chain;
+
+        memcpy(entry->mem, key, lru->key_sz);
+        entry->used = true;
+        entry->ref = false;
+
+        //add the entry to the hash index and the recency list
+        bucket = _lru_hash(lru, key) & lru->bucket_mask;
+        entry->chain = lru->buckets[bucket];
+        lru->buckets[bucket] = idx;
+
+        if (lru->mode == CM_LRU_LIST) cm_ilst_apd(&lru->recency, &entry->link);
+        ++lru->len;
+    }
+
+    //copy the data, unless the caller will fill it in place
+    if (data != NULL) memcpy(LRU_DATA(lru, entry), data, lru->data_sz);
+
+    return LRU_DATA(lru, entry);
+}
+
+
+
+int cm_lru_rem(cm_lru * lru, const void * key) {
+
+    int prev_idx;
+
+    int idx = _lru_find(lru, key, &prev_idx);
+    if (idx == -1) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    _lru_sub_entry(lru, idx);
+
+    return 0;
+}
+
+
+
+int cm_lru_evict(cm_lru * lru, void * key_buf, void * data_buf) {
+
+    int idx;
+    _lru_entry * entry;
+
+    if (lru->len == 0) {
+        cm_errno = CM_ERR_USER_EMPTY;
+        return -1;
+    }
+
+    idx = _lru_victim(lru);
+    entry = LRU_ENTRY(lru, idx);
+
+    //hand the evicted entry to the caller, for example to write it back
+    if (key_buf != NULL) memcpy(key_buf, entry->mem, lru->key_sz);
+    if (data_buf != NULL) {
+        memcpy(data_buf, LRU_DATA(lru, entry), lru->data_sz);
+    }
+
+    _lru_sub_entry(lru, idx);
+
+    return 0;
+}
+
+
+
+void cm_lru_emp(cm_lru * lru) {
+
+    _lru_entry * entry;
+
+    lru->len = 0;
+    lru->hand = 0;
+    cm_new_ilst(&lru->recency);
+
+    for (int i = 0; i <= lru->bucket_mask; ++i) lru->buckets[i] = -1;
+
+    //chain every entry into the free list
+    for (int i = 0; i < lru->cap; ++i) {
+        entry = LRU_ENTRY(lru, i);
+        entry->used = false;
+        entry->chain = i + 1 < lru->cap ? i + 1 : -1;
+    }
+    lru->free_idx = 0;
+
+    return;
+}
+
+
+
+int cm_new_lru(cm_lru * lru, const int cap,
+               const size_t key_sz, const size_t data_sz) {
+
+    lru->mode = CM_LRU_LIST;
+
+    return _lru_new(lru, cap, key_sz, data_sz);
+}
+
+
+
+int cm_new_lru_clk(cm_lru * lru, const int cap,
+                   const size_t key_sz, const size_t data_sz) {
+
+    lru->mode = CM_LRU_CLOCK;
+
+    return _lru_new(lru, cap, key_sz, data_sz);
+}
+
+
+
+void cm_del_lru(cm_lru * lru) {
+
+    free(lru->entries);
+    free(lru->buckets);
+
+    return;
+}
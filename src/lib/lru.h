@@ -0,0 +1,71 @@
+#ifndef LRU_H
+#define LRU_H
+
+//standard library
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "arn.h"
+
+
+/*
+ *  Each entry holds its recency link, its place in the hash index, and
+ *  its key followed by its data. Entries are all allocated up front, in
+ *  a single array.
+ */
+
+typedef struct {
+
+    cm_ilst_link link; //recency order, least recently used first
+    int chain;         //next entry in the same bucket or free list, or -1
+    bool used;
+    bool ref;          //used since the clock hand last passed
+
+    cm_byte mem[] __attribute__((aligned(16)));
+
+} _lru_entry;
+
+
+//get an entry by its index
+#define LRU_ENTRY(lru, idx) \
+    ((_lru_entry *) ((lru)->entries + ((size_t) (idx) * (lru)->entry_sz)))
+
+//get the data of an entry, which follows its key
+#define LRU_DATA(lru, entry) \
+    ((void *) ((entry)->mem + ARN_ROUND((lru)->key_sz)))
+
+
+#ifdef DEBUG
+//internal
+size_t _lru_hash(const cm_lru * lru, const void * key);
+int _lru_find(const cm_lru * lru, const void * key, int * prev_idx);
+void _lru_unhash(cm_lru * lru, const int idx);
+void _lru_touch(cm_lru * lru, _lru_entry * entry);
+int _lru_victim(cm_lru * lru);
+void _lru_sub_entry(cm_lru * lru, const int idx);
+int _lru_new(cm_lru * lru, const int cap,
+             const size_t key_sz, const size_t data_sz);
+#endif
+
+
+//external
+int cm_lru_get(cm_lru * lru, const void * key, void * buf);
+void * cm_lru_get_p(cm_lru * lru, const void * key);
+
+void * cm_lru_put(cm_lru * lru, const void * key, const void * data);
+int cm_lru_rem(cm_lru * lru, const void * key);
+int cm_lru_evict(cm_lru * lru, void * key_buf, void * data_buf);
+void cm_lru_emp(cm_lru * lru);
+
+int cm_new_lru(cm_lru * lru, const int cap,
+               const size_t key_sz, const size_t data_sz);
+int cm_new_lru_clk(cm_lru * lru, const int cap,
+                   const size_t key_sz, const size_t data_sz);
+void cm_del_lru(cm_lru * lru);
+
+#endif
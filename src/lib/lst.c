@@ -10,6 +10,7 @@
 #include "cmore.h"
 #include "debug.h"
 #include "lst.h"
+#include "arn.h"
 
 
 
@@ -17,36 +18,75 @@
  *  --- [INTERNAL] ---
  */
 
+DBG_STATIC DBG_INLINE 
+int _lst_normalise_index(const cm_lst * list, int index) {
+
+    //convert negative indeces to their positive equivalent
+    if (index < 0) index += list->len;
+
+    //an index one past the end wraps around to the head
+    if (index >= list->len) index -= list->len;
+
+    return index;
+}
+
+
+
+DBG_STATIC DBG_INLINE 
+void _lst_set_cursor(cm_lst * list, cm_lst_node * node, const int index) {
+
+    list->cursor     = node;
+    list->cursor_idx = index;
+
+    return;
+}
+
+
+
+/*
+ *  The list caches the last node reached by a traversal in its cursor. 
+ *  Traversal starts from the head, the tail, or the cursor, whichever is 
+ *  closest to the requested index. Since every traversal moves the 
+ *  cursor, the getters take a non-const list.
+ */
+
 DBG_STATIC 
-cm_lst_node * _lst_traverse(const cm_lst * list, int index) {
+cm_lst_node * _lst_traverse(cm_lst * list, int index) {
 
     cm_lst_node * node = list->head;
-    bool traverse_forward;
+    int steps;
 
-    //determine if traversing forwards or backwards
-    if (index >= 0) {
-        traverse_forward = true;
-    } else {
-        traverse_forward = false;
+    index = _lst_normalise_index(list, index);
+
+    //walk from the head, going around whichever way is shorter
+    steps = index > list->len / 2 ? index - list->len : index;
+
+    //walk from the cursor instead if it is closer
+    if (list->cursor != NULL && abs(index - list->cursor_idx) < abs(steps)) {
+        node = list->cursor;
+        steps = index - list->cursor_idx;
     }
 
     //traverse, checking for premature NULL pointers
-    while ((node != NULL) && (index != 0)) {
+    while ((node != NULL) && (steps != 0)) {
 
-        if (traverse_forward) {
+        if (steps > 0) {
             node = node->next;
-            index--;
+            steps--;
         } else {
             node = node->prev;
-            index++;
+            steps++;
         }
     }
 
-    if (index) {
+    if (steps || node == NULL) {
         cm_errno = CM_ERR_INTERNAL_INDEX;
         return NULL;
     }
 
+    //cache the node reached
+    _lst_set_cursor(list, node, index);
+
     return node;
 }
 
@@ -55,22 +95,48 @@ cm_lst_node * _lst_traverse(const cm_lst * list, int index) {
 DBG_STATIC 
 cm_lst_node * _lst_new_node(const cm_lst * list, const void * data) {
 
-    //allocate node structure
-    cm_lst_node * new_node = malloc(sizeof(cm_lst_node));
-    if (!new_node) {
-        cm_errno = CM_ERR_MALLOC;
-        return NULL;
-    }
+    cm_lst_node * new_node;
 
-    //allocate data
-    new_node->data = malloc(list->data_sz);
-    if (!new_node->data) {
-        cm_errno = CM_ERR_MALLOC;
-        return NULL;
+    //arena lists take the node and its data from the list's chunks
+    if (list->mode == CM_LST_ARENA) {
+
+        new_node = _arn_alloc(list->arn);
+        if (!new_node) return NULL;
+
+        new_node->data = new_node->inl;
+
+    //inline lists store the data at the end of the node
+    } else if (list->mode == CM_LST_INLINE) {
+
+        //allocate node structure and data together
+        new_node = malloc(sizeof(cm_lst_node) + list->data_sz);
+        if (!new_node) {
+            cm_errno = CM_ERR_MALLOC;
+            return NULL;
+        }
+
+        new_node->data = new_node->inl;
+
+    } else {
+
+        //allocate node structure
+        new_node = malloc(sizeof(cm_lst_node));
+        if (!new_node) {
+            cm_errno = CM_ERR_MALLOC;
+            return NULL;
+        }
+
+        //allocate data
+        new_node->data = malloc(list->data_sz);
+        if (!new_node->data) {
+            free(new_node);
+            cm_errno = CM_ERR_MALLOC;
+            return NULL;
+        }
     }
 
-    //copy data into node
-    memcpy(new_node->data, data, list->data_sz);
+    //copy data into node, unless the caller will fill it in place
+    if (data != NULL) memcpy(new_node->data, data, list->data_sz);
 
     return new_node;
 }
@@ -80,7 +146,8 @@ cm_lst_node * _lst_new_node(const cm_lst * list, const void * data) {
 DBG_STATIC 
 void _lst_del_node(cm_lst_node * node) {
 
-    free(node->data);
+    //inline nodes hold their data in the same allocation
+    if (node->data != node->inl) free(node->data);
     free(node);
 
     return;
@@ -88,6 +155,21 @@ void _lst_del_node(cm_lst_node * node) {
 
 
 
+DBG_STATIC DBG_INLINE 
+void _lst_free_node(const cm_lst * list, cm_lst_node * node) {
+
+    //arena nodes are returned to the arena for reuse
+    if (list->mode == CM_LST_ARENA) {
+        _arn_free(list->arn, node);
+    } else {
+        _lst_del_node(node);
+    }
+
+    return;
+}
+
+
+
 DBG_STATIC 
 void _lst_set_head_node(cm_lst * list, cm_lst_node * node) {
 
@@ -119,6 +201,25 @@ void _lst_add_node(cm_lst * list,
 
 
 
+DBG_STATIC 
+void _lst_apd_node(cm_lst * list, cm_lst_node * node) {
+
+    //add node to end of list
+    if (list->len == 0) {
+        _lst_set_head_node(list, node);
+
+    } else if (list->len == 1) {
+        _lst_add_node(list, node, list->head, list->head, -1);
+    
+    } else {
+        _lst_add_node(list, node, list->head->prev, list->head, -1);
+    }
+
+    return;
+}
+
+
+
 DBG_STATIC 
 void _lst_sub_node(cm_lst * list, cm_lst_node * prev_node, 
                    cm_lst_node * next_node, const int index) {
@@ -148,12 +249,202 @@ void _lst_sub_node(cm_lst * list, cm_lst_node * prev_node,
 
 
 
+/*
+ *  After a node is removed from a known index, keep the cursor on whichever 
+ *  neighbour now sits closest to that index. Must be called after the 
+ *  length of the list is updated.
+ */
+
+DBG_STATIC DBG_INLINE 
+void _lst_sub_cursor(cm_lst * list, cm_lst_node * prev_node, 
+                     cm_lst_node * next_node, const int index) {
+
+    if (list->len == 0) {
+        list->cursor = NULL;
+
+    } else if (index < list->len) {
+        _lst_set_cursor(list, next_node, index);
+
+    } else {
+        _lst_set_cursor(list, prev_node, index - 1);
+    }
+
+    return;
+}
+
+
+
+/*
+ *  After a node is removed by pointer its index is only known if it was 
+ *  the cursor. Otherwise the cursor may have shifted, so it is dropped.
+ */
+
+DBG_STATIC DBG_INLINE 
+void _lst_sub_node_cursor(cm_lst * list, cm_lst_node * node) {
+
+    if (list->cursor == node) {
+        _lst_sub_cursor(list, node->prev, node->next, list->cursor_idx);
+    
+    } else {
+        list->cursor = NULL;
+    }
+
+    return;
+}
+
+
+
+/*
+ *  Finds the index of a node by walking away from it in both directions at 
+ *  once until the head is reached. This takes time proportional to the 
+ *  distance from the node to the nearest end of the list.
+ */
+
+DBG_STATIC 
+int _lst_node_index(const cm_lst * list, const cm_lst_node * node) {
+
+    const cm_lst_node * fwd_node = node, * bwd_node = node;
+    int steps = 0;
+
+    if (node == list->head) return 0;
+    if (node == list->cursor) return list->cursor_idx;
+
+    while ((fwd_node != NULL) && (steps < list->len)) {
+
+        ++steps;
+
+        fwd_node = fwd_node->next;
+        if (fwd_node == list->head) return list->len - steps;
+
+        bwd_node = bwd_node->prev;
+        if (bwd_node == list->head) return steps;
+    }
+
+    cm_errno = CM_ERR_INTERNAL_INDEX;
+    return -1;
+}
+
+
+
+/*
+ *  Links the chain of nodes first..last into a list in front of next_node.
+ *  The chain's outer pointers are ignored. next_node is ignored if the 
+ *  list is empty.
+ */
+
+DBG_STATIC 
+void _lst_add_chain(cm_lst * list, cm_lst_node * first, cm_lst_node * last,
+                    const int len, cm_lst_node * next_node, const int index) {
+
+    cm_lst_node * prev_node;
+
+    if (list->len == 0) {
+
+        first->prev = last;
+        last->next = first;
+        list->head = first;
+    
+    } else {
+
+        prev_node = list->len == 1 ? next_node : next_node->prev;
+
+        prev_node->next = first;
+        first->prev = prev_node;
+
+        next_node->prev = last;
+        last->next = next_node;
+
+        if (index == 0) list->head = first;
+    }
+
+    list->len += len;
+
+    //single node lists do not loop
+    if (list->len == 1) list->head->next = list->head->prev = NULL;
+
+    return;
+}
+
+
+
+/*
+ *  Unlinks the nodes from node to the end of the list. The chain's outer 
+ *  pointers are left dangling. Returns the last node of the chain.
+ */
+
+DBG_STATIC 
+cm_lst_node * _lst_sub_chain(cm_lst * list, 
+                             cm_lst_node * node, const int index) {
+
+    cm_lst_node * last = list->len == 1 ? list->head : list->head->prev;
+    cm_lst_node * tail_node;
+
+    //the whole list is taken
+    if (index == 0) {
+
+        list->head = NULL;
+        list->len = 0;
+        list->cursor = NULL;
+        return last;
+    }
+
+    //close the remaining nodes into a loop
+    tail_node = node->prev;
+    tail_node->next = list->head;
+    list->head->prev = tail_node;
+
+    list->len = index;
+    if (list->len == 1) list->head->next = list->head->prev = NULL;
+
+    if (list->cursor_idx >= index) list->cursor = NULL;
+
+    return last;
+}
+
+
+
+DBG_STATIC DBG_INLINE 
+int _lst_assert_compatible(const cm_lst * list, const cm_lst * other) {
+
+    //nodes of arena lists can not outlive their arena
+    if (list == other || list->data_sz != other->data_sz
+        || list->mode == CM_LST_ARENA || other->mode == CM_LST_ARENA) {
+        cm_errno = CM_ERR_USER_MISMATCH;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+DBG_STATIC 
+int _lst_split(cm_lst * list, 
+               cm_lst_node * node, const int index, cm_lst * dst) {
+
+    int len = list->len - index;
+    cm_lst_node * last;
+
+    last = _lst_sub_chain(list, node, index);
+    _lst_add_chain(dst, node, last, len, dst->head, dst->len);
+
+    return 0;
+}
+
+
+
 DBG_STATIC 
 int _lst_emp(cm_lst * list) {
  
     cm_lst_node * node = list->head, * next_node;
     int index = list->len;
 
+    //arena lists free their chunks instead of each node
+    if (list->mode == CM_LST_ARENA) {
+        _arn_emp(list->arn);
+        index = 0;
+    }
+
     while ((node != NULL) && (index != 0)) {
 
         next_node = node->next;
@@ -169,6 +460,7 @@ int _lst_emp(cm_lst * list) {
 
     list->len = 0;
     list->head = NULL;
+    list->cursor = NULL;
 
     return 0;
 }
@@ -197,7 +489,7 @@ int _lst_assert_index_range(const cm_lst * list,
  *  --- [EXTERNAL] ---
  */
 
-int cm_lst_get(const cm_lst * list, const int index, void * buf) {
+int cm_lst_get(cm_lst * list, const int index, void * buf) {
 
     if (_lst_assert_index_range(list, index, INDEX)) return -1;
 
@@ -212,7 +504,7 @@ int cm_lst_get(const cm_lst * list, const int index, void * buf) {
 
 
 
-void * cm_lst_get_p(const cm_lst * list, const int index) {
+void * cm_lst_get_p(cm_lst * list, const int index) {
 
     if (_lst_assert_index_range(list, index, INDEX)) return NULL;
 
@@ -225,7 +517,7 @@ void * cm_lst_get_p(const cm_lst * list, const int index) {
 
 
 
-cm_lst_node * cm_lst_get_n(const cm_lst * list, const int index) {
+cm_lst_node * cm_lst_get_n(cm_lst * list, const int index) {
 
     if (_lst_assert_index_range(list, index, INDEX)) return NULL;
 
@@ -271,11 +563,15 @@ cm_lst_node * cm_lst_ins(cm_lst * list,
     //create new node
     cm_lst_node * new_node = _lst_new_node(list, data);
     if (!new_node) return NULL;
+
+    //the new node is where the next traversal is most likely to go
+    int new_index = index >= 0 ? index : list->len + 1 + index;
     
     //assign prev_node and next_node depending on case
     if (list->len == 0) {
 
         _lst_set_head_node(list, new_node);
+        _lst_set_cursor(list, new_node, new_index);
         return new_node;
 
     } else {
@@ -293,13 +589,14 @@ cm_lst_node * cm_lst_ins(cm_lst * list,
                 next_node = _lst_traverse(list, index + 1);
             }
             if (!next_node) {
-                _lst_del_node(new_node);
+                _lst_free_node(list, new_node);
                 return NULL;
             }
             prev_node = next_node->prev;
         }
         
         _lst_add_node(list, new_node, prev_node, next_node, index);
+        _lst_set_cursor(list, new_node, new_index);
         return new_node;
     
     } //end else
@@ -315,6 +612,7 @@ cm_lst_node * cm_lst_ins_nb(cm_lst * list,
 
     //create new node
     cm_lst_node * new_node = _lst_new_node(list, data);
+    if (!new_node) return NULL;
 
     //assign prev_node and next_node depending on case
     if (list->len == 1) {
@@ -330,6 +628,13 @@ cm_lst_node * cm_lst_ins_nb(cm_lst * list,
 
     _lst_add_node(list, new_node, prev_node, next_node, index);
 
+    //the new node takes the cursor's index if inserted before it
+    if (list->cursor == node) {
+        list->cursor = new_node;
+    } else {
+        list->cursor = NULL;
+    }
+
     return new_node;
 }
 
@@ -342,6 +647,7 @@ cm_lst_node * cm_lst_ins_na(cm_lst * list,
 
     //create new node
     cm_lst_node * new_node = _lst_new_node(list, data);
+    if (!new_node) return NULL;
 
     //assign prev_node and next_node depending on case
     if (list->len == 1) {
@@ -356,6 +662,13 @@ cm_lst_node * cm_lst_ins_na(cm_lst * list,
 
     _lst_add_node(list, new_node, prev_node, next_node, -1);
 
+    //the new node follows the cursor if inserted after it
+    if (list->cursor == node) {
+        _lst_set_cursor(list, new_node, list->cursor_idx + 1);
+    } else {
+        list->cursor = NULL;
+    }
+
     return new_node;
 }
 
@@ -366,34 +679,40 @@ cm_lst_node * cm_lst_apd(cm_lst * list, const void * data) {
     cm_lst_node * new_node = _lst_new_node(list, data);
     if (!new_node) return NULL;
 
-    //add node to list
-    if (list->len == 0) {
-        _lst_set_head_node(list, new_node);
-
-    } else if (list->len == 1) {
-        _lst_add_node(list, new_node, list->head, list->head, -1);
-    
-    } else {
-        _lst_add_node(list, new_node, list->head->prev, list->head, -1);
-    }
+    _lst_apd_node(list, new_node);
 
     return new_node;
 }
 
 
 
+void * cm_lst_apd_slot(cm_lst * list) {
+
+    //create a node without copying any data into it
+    cm_lst_node * new_node = _lst_new_node(list, NULL);
+    if (!new_node) return NULL;
+
+    _lst_apd_node(list, new_node);
+
+    return new_node->data;
+}
+
+
+
 cm_lst_node * cm_lst_uln(cm_lst * list, const int index) {
 
     if (_lst_assert_index_range(list, index, INDEX)) return NULL;
     
     //get the node
-    cm_lst_node * unlink_node = _lst_traverse(list, index);
+    int norm_index = _lst_normalise_index(list, index);
+    cm_lst_node * unlink_node = _lst_traverse(list, norm_index);
     if (!unlink_node) return NULL;
 
     //unlink it from the list
-    _lst_sub_node(list, unlink_node->prev, unlink_node->next, index);
+    _lst_sub_node(list, unlink_node->prev, unlink_node->next, norm_index);
     
     --list->len;
+    _lst_sub_cursor(list, unlink_node->prev, unlink_node->next, norm_index);
 
     return unlink_node;
 }
@@ -408,6 +727,7 @@ cm_lst_node * cm_lst_uln_n(cm_lst * list, cm_lst_node * node) {
     _lst_sub_node(list, node->prev, node->next, index);
     
     --list->len;
+    _lst_sub_node_cursor(list, node);
 
     return node;
 }
@@ -419,13 +739,16 @@ int cm_lst_rem(cm_lst * list, const int index) {
     if (_lst_assert_index_range(list, index, INDEX)) return -1;
 
     //get the node
-    cm_lst_node * del_node = _lst_traverse(list, index);
+    int norm_index = _lst_normalise_index(list, index);
+    cm_lst_node * del_node = _lst_traverse(list, norm_index);
     if(!del_node) return -1;
 
-    _lst_sub_node(list, del_node->prev, del_node->next, index);
-    _lst_del_node(del_node);
+    _lst_sub_node(list, del_node->prev, del_node->next, norm_index);
     
     --list->len;
+    _lst_sub_cursor(list, del_node->prev, del_node->next, norm_index);
+    
+    _lst_free_node(list, del_node);
 
     return 0;
 }
@@ -437,15 +760,172 @@ int cm_lst_rem_n(cm_lst * list, cm_lst_node * node) {
     int index = list->head == node ? 0 : -1;
 
     _lst_sub_node(list, node->prev, node->next, index);
-    _lst_del_node(node);
 
     --list->len;
+    _lst_sub_node_cursor(list, node);
+    
+    _lst_free_node(list, node);
+
+    return 0;
+}
+
+
+
+int cm_lst_splice(cm_lst * list, const int index, cm_lst * src) {
+
+    int pos, len;
+    cm_lst_node * next_node = NULL, * first, * last;
+
+    if (_lst_assert_index_range(list, index, ADD_INDEX)) return -1;
+    if (_lst_assert_compatible(list, src)) return -1;
+
+    if (src->len == 0) return 0;
+    pos = index >= 0 ? index : list->len + 1 + index;
+
+    //get the node the chain is inserted in front of
+    if (list->len != 0) {
+        next_node = _lst_traverse(list, pos);
+        if (!next_node) return -1;
+    }
+
+    //take every node out of the source list
+    len = src->len;
+    first = src->head;
+    last = _lst_sub_chain(src, first, 0);
+
+    _lst_add_chain(list, first, last, len, next_node, pos);
+    _lst_set_cursor(list, first, pos);
 
     return 0;
 }
 
 
 
+int cm_lst_cat(cm_lst * list, cm_lst * src) {
+
+    return cm_lst_splice(list, list->len, src);
+}
+
+
+
+int cm_lst_split(cm_lst * list, const int index, cm_lst * dst) {
+
+    if (_lst_assert_index_range(list, index, INDEX)) return -1;
+    if (_lst_assert_compatible(list, dst)) return -1;
+
+    //get the first node to move
+    int norm_index = _lst_normalise_index(list, index);
+    cm_lst_node * node = _lst_traverse(list, norm_index);
+    if (!node) return -1;
+
+    return _lst_split(list, node, norm_index, dst);
+}
+
+
+
+int cm_lst_split_n(cm_lst * list, cm_lst_node * node, cm_lst * dst) {
+
+    if (_lst_assert_compatible(list, dst)) return -1;
+
+    //find how many nodes stay behind
+    int index = _lst_node_index(list, node);
+    if (index == -1) return -1;
+
+    return _lst_split(list, node, index, dst);
+}
+
+
+
+/*
+ *  Bottom-up merge sort. Each pass merges neighbouring runs of 'run_len' 
+ *  nodes, doubling 'run_len' until a single run remains. Only the links 
+ *  of the nodes change, and equal elements keep their order.
+ */
+
+void cm_lst_sort(cm_lst * list, 
+                 enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    cm_lst_node * head_node, * tail_node, * left, * right, * node;
+    int run_len = 1, left_len, right_len, merges;
+
+    if (list->len < 2) return;
+
+    //break the loop, the list is NULL terminated while sorting
+    head_node = list->head;
+    head_node->prev->next = NULL;
+
+    do {
+
+        left = head_node;
+        head_node = tail_node = NULL;
+        merges = 0;
+
+        //merge each pair of runs
+        while (left != NULL) {
+
+            ++merges;
+
+            //find the start of the right run
+            right = left;
+            left_len = 0;
+            while (left_len < run_len && right != NULL) {
+                right = right->next;
+                ++left_len;
+            }
+            right_len = run_len;
+
+            //take the lesser node from the front of either run
+            while (left_len > 0 || (right_len > 0 && right != NULL)) {
+
+                if (left_len == 0) {
+                    node = right;
+                    right = right->next;
+                    --right_len;
+
+                } else if (right_len == 0 || right == NULL
+                           || compare(left->data, right->data) != MORE) {
+                    node = left;
+                    left = left->next;
+                    --left_len;
+
+                } else {
+                    node = right;
+                    right = right->next;
+                    --right_len;
+                }
+
+                //append the node to the merged list
+                if (tail_node != NULL) {
+                    tail_node->next = node;
+                } else {
+                    head_node = node;
+                }
+                node->prev = tail_node;
+                tail_node = node;
+
+            } //end while
+
+            left = right;
+
+        } //end while
+
+        tail_node->next = NULL;
+        run_len *= 2;
+
+    } while (merges > 1);
+
+    //close the loop again
+    tail_node->next = head_node;
+    head_node->prev = tail_node;
+
+    list->head = head_node;
+    list->cursor = NULL;
+
+    return;
+}
+
+
+
 int cm_lst_emp(cm_lst * list) {
 
     if (_lst_emp(list)) return -1;
@@ -460,16 +940,52 @@ void cm_new_lst(cm_lst * list, const size_t data_sz) {
     list->len = 0;
     list->data_sz = data_sz;
     list->head = NULL;
+    list->mode = CM_LST_SEPARATE;
+    list->cursor = NULL;
+    list->cursor_idx = 0;
+    list->arn = NULL;
     return;
 }
 
 
 
+void cm_new_lst_inl(cm_lst * list, const size_t data_sz) {
+
+    cm_new_lst(list, data_sz);
+    list->mode = CM_LST_INLINE;
+    return;
+}
+
+
+
+int cm_new_lst_arn(cm_lst * list, const size_t data_sz) {
+
+    cm_new_lst(list, data_sz);
+
+    list->arn = _arn_new(sizeof(cm_lst_node) + data_sz);
+    if (!list->arn) return -1;
+
+    list->mode = CM_LST_ARENA;
+    return 0;
+}
+
+
+
 void cm_del_lst(cm_lst * list) {
 
     int len = list->len;
     cm_lst_node * del_node;
 
+    //arena lists free their chunks instead of each node
+    if (list->mode == CM_LST_ARENA) {
+        _arn_del(list->arn);
+        list->arn = NULL;
+        list->len = 0;
+        list->head = NULL;
+        list->cursor = NULL;
+        return;
+    }
+
     //delete each node in list
     for (int i = 0; i < len; ++i) {
 
@@ -479,6 +995,8 @@ void cm_del_lst(cm_lst * list) {
     
     } //end for
 
+    list->cursor = NULL;
+
     return;
 }
 
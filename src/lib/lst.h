@@ -16,17 +16,33 @@ enum _lst_index_mode {INDEX = 0, ADD_INDEX = 1};
 
 #ifdef DEBUG
 //internal
-cm_lst_node * _lst_traverse(const cm_lst * list, int index);
+int _lst_normalise_index(const cm_lst * list, int index);
+void _lst_set_cursor(cm_lst * list, cm_lst_node * node, const int index);
+cm_lst_node * _lst_traverse(cm_lst * list, int index);
 
 cm_lst_node * _lst_new_node(const cm_lst * list, const void * data);
 void _lst_del_node(cm_lst_node * node);
+void _lst_free_node(const cm_lst * list, cm_lst_node * node);
 
 void _lst_set_head_node(cm_lst * list, cm_lst_node * node);
 void _lst_add_node(cm_lst * list, 
                    cm_lst_node * node, cm_lst_node * prev_node, 
                    cm_lst_node * next_node, const int index);
+void _lst_apd_node(cm_lst * list, cm_lst_node * node);
 void _lst_sub_node(cm_lst * list, cm_lst_node * prev_node, 
                    cm_lst_node * next_node, const int index);
+void _lst_sub_cursor(cm_lst * list, cm_lst_node * prev_node, 
+                     cm_lst_node * next_node, const int index);
+void _lst_sub_node_cursor(cm_lst * list, cm_lst_node * node);
+
+int _lst_node_index(const cm_lst * list, const cm_lst_node * node);
+void _lst_add_chain(cm_lst * list, cm_lst_node * first, cm_lst_node * last,
+                    const int len, cm_lst_node * next_node, const int index);
+cm_lst_node * _lst_sub_chain(cm_lst * list, 
+                             cm_lst_node * node, const int index);
+int _lst_assert_compatible(const cm_lst * list, const cm_lst * other);
+int _lst_split(cm_lst * list, 
+               cm_lst_node * node, const int index, cm_lst * dst);
 
 int _lst_emp(cm_lst * list);
 int _lst_assert_index_range(const cm_lst * list, 
@@ -35,9 +51,9 @@ int _lst_assert_index_range(const cm_lst * list,
 
 
 //external
-int cm_lst_get(const cm_lst * list, const int index, void * buf);
-void * cm_lst_get_p(const cm_lst * list, const int index);
-cm_lst_node * cm_lst_get_n(const cm_lst * list, const int index);
+int cm_lst_get(cm_lst * list, const int index, void * buf);
+void * cm_lst_get_p(cm_lst * list, const int index);
+cm_lst_node * cm_lst_get_n(cm_lst * list, const int index);
 
 cm_lst_node * cm_lst_set(cm_lst * list, 
                          const int index, const void * data);
@@ -52,6 +68,7 @@ cm_lst_node * cm_lst_ins_na(cm_lst * list,
                             cm_lst_node * node, const void * data);
 
 cm_lst_node * cm_lst_apd(cm_lst * list, const void * data);
+void * cm_lst_apd_slot(cm_lst * list);
 
 cm_lst_node * cm_lst_uln(cm_lst * list, const int index);
 cm_lst_node * cm_lst_uln_n(cm_lst * list, cm_lst_node * node);
@@ -59,9 +76,19 @@ cm_lst_node * cm_lst_uln_n(cm_lst * list, cm_lst_node * node);
 int cm_lst_rem(cm_lst * list, const int index);
 int cm_lst_rem_n(cm_lst * list, cm_lst_node * node);
 
+int cm_lst_splice(cm_lst * list, const int index, cm_lst * src);
+int cm_lst_cat(cm_lst * list, cm_lst * src);
+int cm_lst_split(cm_lst * list, const int index, cm_lst * dst);
+int cm_lst_split_n(cm_lst * list, cm_lst_node * node, cm_lst * dst);
+
+void cm_lst_sort(cm_lst * list, 
+                 enum cm_rbt_side (*compare)(const void *, const void *));
+
 int cm_lst_emp(cm_lst * list);
 
 void cm_new_lst(cm_lst * list, const size_t data_sz);
+void cm_new_lst_inl(cm_lst * list, const size_t data_sz);
+int cm_new_lst_arn(cm_lst * list, const size_t data_sz);
 void cm_del_lst(cm_lst * list);
 void cm_del_lst_node(cm_lst_node * node);
 
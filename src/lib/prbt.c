@@ -0,0 +1,549 @@
+//standard library
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "prbt.h"
+#include "arn.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+DBG_STATIC DBG_INLINE
+size_t _prbt_node_sz(const cm_prbt * tree) {
+
+    return sizeof(_prbt_node) + ARN_ROUND(tree->key_sz) + tree->data_sz;
+}
+
+
+
+//a tree of black height h holds at least 2^h - 1 nodes
+DBG_STATIC
+int _prbt_max_height(const cm_prbt * tree) {
+
+    int black_height = 1;
+
+    for (int n = tree->size + 1; n > 1; n >>= 1) ++black_height;
+
+    return 2 * black_height;
+}
+
+
+
+/*
+ *  Reserves every node the next update may copy or create, so that an
+ *  update either fails before it starts or not at all.
+ */
+
+DBG_STATIC
+int _prbt_reserve(cm_prbt * tree) {
+
+    _prbt_node * node;
+    int need = PRBT_RESERVE(_prbt_max_height(tree));
+
+    while (tree->spare_len < need) {
+
+        node = malloc(_prbt_node_sz(tree));
+        if (!node) {
+            cm_errno = CM_ERR_MALLOC;
+            return -1;
+        }
+
+        //spare nodes are chained through their left child
+        node->left = tree->spare;
+        tree->spare = node;
+        ++tree->spare_len;
+    }
+
+    return 0;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+_prbt_node * _prbt_take(cm_prbt * tree) {
+
+    _prbt_node * node = tree->spare;
+
+    tree->spare = node->left;
+    --tree->spare_len;
+
+    return node;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _prbt_ref(_prbt_node * node) {
+
+    if (node != NULL) __atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+
+    return;
+}
+
+
+
+//drop a reference, freeing the node and releasing its children if it was last
+DBG_STATIC
+void _prbt_unref(_prbt_node * node) {
+
+    if (node == NULL) return;
+    if (__atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) != 0) return;
+
+    _prbt_unref(node->left);
+    _prbt_unref(node->right);
+    free(node);
+
+    return;
+}
+
+
+
+/*
+ *  Returns a node that may be changed in place, copying it if any other
+ *  version reaches it. The reference of the caller moves to the copy.
+ */
+
+DBG_STATIC
+_prbt_node * _prbt_own(cm_prbt * tree, _prbt_node * node) {
+
+    _prbt_node * copy;
+
+    if (__atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1) return node;
+
+    copy = _prbt_take(tree);
+    memcpy(copy, node, _prbt_node_sz(tree));
+    copy->refs = 1;
+
+    //the copy points to the same children as the original
+    _prbt_ref(copy->left);
+    _prbt_ref(copy->right);
+    _prbt_unref(node);
+
+    return copy;
+}
+
+
+
+/*
+ *  Rotations and colour flips take a node already owned by the version
+ *  being updated, and own each child they change.
+ */
+
+DBG_STATIC
+_prbt_node * _prbt_rotate_left(cm_prbt * tree, _prbt_node * node) {
+
+    _prbt_node * right = _prbt_own(tree, node->right);
+
+    node->right = right->left;
+    right->left = node;
+    right->colour = node->colour;
+    node->colour = RED;
+
+    return right;
+}
+
+
+
+DBG_STATIC
+_prbt_node * _prbt_rotate_right(cm_prbt * tree, _prbt_node * node) {
+
+    _prbt_node * left = _prbt_own(tree, node->left);
+
+    node->left = left->right;
+    left->right = node;
+    left->colour = node->colour;
+    node->colour = RED;
+
+    return left;
+}
+
+
+
+DBG_STATIC
+void _prbt_flip(cm_prbt * tree, _prbt_node * node) {
+
+    node->colour = !node->colour;
+
+    node->left = _prbt_own(tree, node->left);
+    node->left->colour = !node->left->colour;
+
+    node->right = _prbt_own(tree, node->right);
+    node->right->colour = !node->right->colour;
+
+    return;
+}
+
+
+
+//make the left child or one of its children red before descending left
+DBG_STATIC
+_prbt_node * _prbt_move_red_left(cm_prbt * tree, _prbt_node * node) {
+
+    _prbt_flip(tree, node);
+
+    if (PRBT_IS_RED(node->right->left)) {
+        node->right = _prbt_rotate_right(tree, node->right);
+        node = _prbt_rotate_left(tree, node);
+        _prbt_flip(tree, node);
+    }
+
+    return node;
+}
+
+
+
+//make the right child or one of its children red before descending right
+DBG_STATIC
+_prbt_node * _prbt_move_red_right(cm_prbt * tree, _prbt_node * node) {
+
+    _prbt_flip(tree, node);
+
+    if (PRBT_IS_RED(node->left->left)) {
+        node = _prbt_rotate_right(tree, node);
+        _prbt_flip(tree, node);
+    }
+
+    return node;
+}
+
+
+
+//restore the left-leaning invariants of a node on the way back up
+DBG_STATIC
+_prbt_node * _prbt_balance(cm_prbt * tree, _prbt_node * node) {
+
+    if (PRBT_IS_RED(node->right) && !PRBT_IS_RED(node->left)) {
+        node = _prbt_rotate_left(tree, node);
+    }
+
+    if (PRBT_IS_RED(node->left) && PRBT_IS_RED(node->left->left)) {
+        node = _prbt_rotate_right(tree, node);
+    }
+
+    if (PRBT_IS_RED(node->left) && PRBT_IS_RED(node->right)) {
+        _prbt_flip(tree, node);
+    }
+
+    return node;
+}
+
+
+
+DBG_STATIC
+_prbt_node * _prbt_find(const cm_prbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+    _prbt_node * node = tree->root;
+
+    while (node != NULL) {
+
+        side = tree->compare(key, node->mem);
+        if (side == EQUAL) return node;
+
+        node = side == LESS ? node->left : node->right;
+    }
+
+    return NULL;
+}
+
+
+
+//insert or update a key in a subtree, returning its new root
+DBG_STATIC
+_prbt_node * _prbt_ins(cm_prbt * tree, _prbt_node * node,
+                       const void * key, const void * data) {
+
+    enum cm_rbt_side side;
+
+    if (node == NULL) {
+
+        node = _prbt_take(tree);
+        node->refs = 1;
+        node->colour = RED;
+        node->left = NULL;
+        node->right = NULL;
+
+        memcpy(node->mem, key, tree->key_sz);
+        memcpy(PRBT_DATA(tree, node), data, tree->data_sz);
+        ++tree->size;
+
+        return node;
+    }
+
+    node = _prbt_own(tree, node);
+    side = tree->compare(key, node->mem);
+
+    if (side == LESS) {
+        node->left = _prbt_ins(tree, node->left, key, data);
+    } else if (side == MORE) {
+        node->right = _prbt_ins(tree, node->right, key, data);
+    } else {
+        memcpy(PRBT_DATA(tree, node), data, tree->data_sz);
+    }
+
+    return _prbt_balance(tree, node);
+}
+
+
+
+//remove the least key of a subtree, returning its new root
+DBG_STATIC
+_prbt_node * _prbt_rem_min(cm_prbt * tree, _prbt_node * node) {
+
+    //the left child is only absent at a leaf
+    if (node->left == NULL) {
+        _prbt_unref(node);
+        return NULL;
+    }
+
+    node = _prbt_own(tree, node);
+
+    if (!PRBT_IS_RED(node->left) && !PRBT_IS_RED(node->left->left)) {
+        node = _prbt_move_red_left(tree, node);
+    }
+
+    node->left = _prbt_rem_min(tree, node->left);
+
+    return _prbt_balance(tree, node);
+}
+
+
+
+/*
+ *  Removes a key that is present in a subtree, returning its new root. On
+ *  the way down, the node about to be descended into is always made red
+ *  or given a red child, so the key is finally removed from a leaf.
+ */
+
+DBG_STATIC
+_prbt_node * _prbt_rem(cm_prbt * tree, _prbt_node * node, const void * key) {
+
+    _prbt_node * min_node;
+
+    node = _prbt_own(tree, node);
+
+    if (tree->compare(key, node->mem) == LESS) {
+
+        if (!PRBT_IS_RED(node->left) && !PRBT_IS_RED(node->left->left)) {
+            node = _prbt_move_red_left(tree, node);
+        }
+        node->left = _prbt_rem(tree, node->left, key);
+
+    } else {
+
+        if (PRBT_IS_RED(node->left)) node = _prbt_rotate_right(tree, node);
+
+        if (tree->compare(key, node->mem) == EQUAL && node->right == NULL) {
+            _prbt_unref(node);
+            return NULL;
+        }
+
+        if (!PRBT_IS_RED(node->right) && !PRBT_IS_RED(node->right->left)) {
+            node = _prbt_move_red_right(tree, node);
+        }
+
+        //replace the key with its successor, then remove the successor
+        if (tree->compare(key, node->mem) == EQUAL) {
+
+            min_node = node->right;
+            while (min_node->left != NULL) min_node = min_node->left;
+
+            memcpy(node->mem, min_node->mem,
+                   ARN_ROUND(tree->key_sz) + tree->data_sz);
+            node->right = _prbt_rem_min(tree, node->right);
+
+        } else {
+            node->right = _prbt_rem(tree, node->right, key);
+        }
+    }
+
+    return _prbt_balance(tree, node);
+}
+
+
+
+//push a node and its chain of left children onto the path of an iterator
+DBG_STATIC
+void _prbt_iter_descend(cm_prbt_iter * iter, _prbt_node * node) {
+
+    while (node != NULL) {
+        iter->path[iter->depth++] = node;
+        node = node->left;
+    }
+
+    return;
+}
+
+
+
+DBG_STATIC
+void _prbt_iter_load(const cm_prbt * tree, cm_prbt_iter * iter) {
+
+    _prbt_node * node;
+
+    if (iter->depth == 0) {
+        iter->key = NULL;
+        iter->data = NULL;
+        return;
+    }
+
+    node = iter->path[iter->depth - 1];
+    iter->key = node->mem;
+    iter->data = PRBT_DATA(tree, node);
+
+    return;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_prbt_get(const cm_prbt * tree, const void * key, void * buf) {
+
+    const void * data = cm_prbt_get_p(tree, key);
+    if (!data) return -1;
+
+    memcpy(buf, data, tree->data_sz);
+
+    return 0;
+}
+
+
+
+const void * cm_prbt_get_p(const cm_prbt * tree, const void * key) {
+
+    _prbt_node * node = _prbt_find(tree, key);
+    if (!node) {
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    return PRBT_DATA(tree, node);
+}
+
+
+
+void cm_prbt_first_i(const cm_prbt * tree, cm_prbt_iter * iter) {
+
+    iter->depth = 0;
+    _prbt_iter_descend(iter, tree->root);
+    _prbt_iter_load(tree, iter);
+
+    return;
+}
+
+
+
+void cm_prbt_next_i(const cm_prbt * tree, cm_prbt_iter * iter) {
+
+    _prbt_node * node = iter->path[--iter->depth];
+
+    _prbt_iter_descend(iter, node->right);
+    _prbt_iter_load(tree, iter);
+
+    return;
+}
+
+
+
+int cm_prbt_set(cm_prbt * tree, const void * key, const void * data) {
+
+    if (_prbt_reserve(tree)) return -1;
+
+    tree->root = _prbt_ins(tree, tree->root, key, data);
+    tree->root->colour = BLACK;
+
+    return 0;
+}
+
+
+
+int cm_prbt_rem(cm_prbt * tree, const void * key) {
+
+    if (_prbt_find(tree, key) == NULL) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    if (_prbt_reserve(tree)) return -1;
+
+    //a red root lets the removal start as if descending into a red node
+    tree->root = _prbt_own(tree, tree->root);
+    if (!PRBT_IS_RED(tree->root->left) && !PRBT_IS_RED(tree->root->right)) {
+        tree->root->colour = RED;
+    }
+
+    tree->root = _prbt_rem(tree, tree->root, key);
+    if (tree->root != NULL) tree->root->colour = BLACK;
+    --tree->size;
+
+    return 0;
+}
+
+
+
+/*
+ *  The snapshot shares every node with the tree. Either may be updated or
+ *  deleted afterwards without affecting the other.
+ */
+
+void cm_prbt_snap(const cm_prbt * tree, cm_prbt * snap) {
+
+    *snap = *tree;
+    snap->spare = NULL;
+    snap->spare_len = 0;
+
+    _prbt_ref(snap->root);
+
+    return;
+}
+
+
+
+void cm_new_prbt(cm_prbt * tree, const size_t key_sz, const size_t data_sz,
+                 enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    tree->size      = 0;
+    tree->key_sz    = key_sz;
+    tree->data_sz   = data_sz;
+    tree->root      = NULL;
+    tree->compare   = compare;
+    tree->spare     = NULL;
+    tree->spare_len = 0;
+
+    return;
+}
+
+
+
+//nodes still reached by other versions are kept until those are deleted
+void cm_del_prbt(cm_prbt * tree) {
+
+    _prbt_node * node;
+
+    _prbt_unref(tree->root);
+
+    while (tree->spare != NULL) {
+        node = tree->spare;
+        tree->spare = node->left;
+        free(node);
+    }
+
+    tree->root = NULL;
+    tree->size = 0;
+    tree->spare_len = 0;
+
+    return;
+}
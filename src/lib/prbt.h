@@ -0,0 +1,96 @@
+#ifndef PRBT_H
+#define PRBT_H
+
+//standard library
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "arn.h"
+
+
+/*
+ *  Persistent trees are left-leaning red-black trees. Red nodes are only
+ *  ever left children, so each update has fewer cases to balance.
+ *
+ *  A node is shared between every version that reaches it, and counts the
+ *  versions and nodes that point to it. A node with a single reference is
+ *  only reachable from the version being updated, so it is changed in
+ *  place. Any other node is copied before it is changed, which copies the
+ *  path from the root down to every change.
+ */
+
+struct _cm_prbt_node {
+
+    int refs;
+    enum cm_rbt_colour colour;
+
+    struct _cm_prbt_node * left;
+    struct _cm_prbt_node * right;
+
+    //the key, followed by the data
+    cm_byte mem[] __attribute__((aligned(16)));
+
+};
+typedef struct _cm_prbt_node _prbt_node;
+
+
+//get the data of a node, which follows its key
+#define PRBT_DATA(tree, node) \
+    ((void *) ((node)->mem + ARN_ROUND((tree)->key_sz)))
+
+//nodes an update may copy, at most four for each level of the tree
+#define PRBT_RESERVE(height) (4 * ((height) + 2))
+
+//true if a node exists and is red
+#define PRBT_IS_RED(node) ((node) != NULL && (node)->colour == RED)
+
+
+#ifdef DEBUG
+//internal
+size_t _prbt_node_sz(const cm_prbt * tree);
+int _prbt_max_height(const cm_prbt * tree);
+int _prbt_reserve(cm_prbt * tree);
+_prbt_node * _prbt_take(cm_prbt * tree);
+void _prbt_ref(_prbt_node * node);
+void _prbt_unref(_prbt_node * node);
+_prbt_node * _prbt_own(cm_prbt * tree, _prbt_node * node);
+
+_prbt_node * _prbt_rotate_left(cm_prbt * tree, _prbt_node * node);
+_prbt_node * _prbt_rotate_right(cm_prbt * tree, _prbt_node * node);
+void _prbt_flip(cm_prbt * tree, _prbt_node * node);
+_prbt_node * _prbt_move_red_left(cm_prbt * tree, _prbt_node * node);
+_prbt_node * _prbt_move_red_right(cm_prbt * tree, _prbt_node * node);
+_prbt_node * _prbt_balance(cm_prbt * tree, _prbt_node * node);
+
+_prbt_node * _prbt_find(const cm_prbt * tree, const void * key);
+_prbt_node * _prbt_ins(cm_prbt * tree, _prbt_node * node,
+                       const void * key, const void * data);
+_prbt_node * _prbt_rem_min(cm_prbt * tree, _prbt_node * node);
+_prbt_node * _prbt_rem(cm_prbt * tree, _prbt_node * node, const void * key);
+
+void _prbt_iter_descend(cm_prbt_iter * iter, _prbt_node * node);
+void _prbt_iter_load(const cm_prbt * tree, cm_prbt_iter * iter);
+#endif
+
+
+//external
+int cm_prbt_get(const cm_prbt * tree, const void * key, void * buf);
+const void * cm_prbt_get_p(const cm_prbt * tree, const void * key);
+
+void cm_prbt_first_i(const cm_prbt * tree, cm_prbt_iter * iter);
+void cm_prbt_next_i(const cm_prbt * tree, cm_prbt_iter * iter);
+
+int cm_prbt_set(cm_prbt * tree, const void * key, const void * data);
+int cm_prbt_rem(cm_prbt * tree, const void * key);
+void cm_prbt_snap(const cm_prbt * tree, cm_prbt * snap);
+
+void cm_new_prbt(cm_prbt * tree, const size_t key_sz, const size_t data_sz,
+                 enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_del_prbt(cm_prbt * tree);
+
+#endif
@@ -0,0 +1,263 @@
+//standard library
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "que.h"
+#include "ebr.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+DBG_STATIC
+cm_lst_node * _que_new_node(const size_t data_sz, const void * data) {
+
+    cm_lst_node * new_node;
+
+    //allocate node structure and data together
+    new_node = malloc(sizeof(cm_lst_node) + data_sz);
+    if (!new_node) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    new_node->data = new_node->inl;
+    new_node->next = NULL;
+    new_node->prev = NULL;
+
+    if (data != NULL) memcpy(new_node->data, data, data_sz);
+
+    return new_node;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+/*
+ *  The MPSC queue is an intrusive Vyukov queue. Producers only ever swap
+ *  the tail and link the old tail to their node, so a push is wait-free.
+ *  Only the consumer follows and frees nodes, so nodes need no deferred
+ *  reclamation. A push that has swapped the tail but not linked its node
+ *  yet briefly hides the nodes behind it from the consumer.
+ */
+
+int cm_mpsc_push(cm_mpsc * queue, const void * data) {
+
+    cm_lst_node * new_node, * prev_node;
+
+    new_node = _que_new_node(queue->data_sz, data);
+    if (!new_node) return -1;
+
+    prev_node = __atomic_exchange_n(&queue->tail, new_node, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&prev_node->next, new_node, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+
+
+int cm_mpsc_pop(cm_mpsc * queue, void * buf) {
+
+    cm_lst_node * head_node = queue->head;
+    cm_lst_node * next_node;
+
+    next_node = __atomic_load_n(&head_node->next, __ATOMIC_ACQUIRE);
+    if (next_node == NULL) {
+        cm_errno = CM_ERR_USER_EMPTY;
+        return -1;
+    }
+
+    //the popped node becomes the new dummy node
+    memcpy(buf, next_node->data, queue->data_sz);
+    queue->head = next_node;
+    free(head_node);
+
+    return 0;
+}
+
+
+
+int cm_new_mpsc(cm_mpsc * queue, const size_t data_sz) {
+
+    cm_lst_node * dummy_node = _que_new_node(data_sz, NULL);
+    if (!dummy_node) return -1;
+
+    queue->head = queue->tail = dummy_node;
+    queue->data_sz = data_sz;
+
+    return 0;
+}
+
+
+
+void cm_del_mpsc(cm_mpsc * queue) {
+
+    cm_lst_node * node = queue->head, * next_node;
+
+    while (node != NULL) {
+        next_node = node->next;
+        free(node);
+        node = next_node;
+    }
+
+    return;
+}
+
+
+
+/*
+ *  The MPMC queue is a Michael-Scott queue. A thread that finds the tail
+ *  lagging behind helps swing it forward before retrying. Popped dummy
+ *  nodes are retired to the queue's epoch-based reclamation domain, as
+ *  other threads may still be reading them.
+ */
+
+int cm_mpmc_push(cm_mpmc * queue, const void * data) {
+
+    cm_lst_node * new_node, * tail_node, * next_node;
+    _ebr_slot * slot;
+
+    new_node = _que_new_node(queue->data_sz, data);
+    if (!new_node) return -1;
+
+    slot = _ebr_enter(queue->ebr);
+    if (!slot) {
+        free(new_node);
+        return -1;
+    }
+
+    while (true) {
+
+        tail_node = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        next_node = __atomic_load_n(&tail_node->next, __ATOMIC_ACQUIRE);
+
+        if (tail_node != __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+
+        //help a lagging tail forward
+        if (next_node != NULL) {
+            __atomic_compare_exchange_n(&queue->tail, &tail_node, next_node,
+                                        false, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED);
+            continue;
+        }
+
+        //link the new node after the tail
+        if (__atomic_compare_exchange_n(&tail_node->next, &next_node, new_node,
+                                        false, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED)) break;
+    }
+
+    //swing the tail, unless another thread already has
+    __atomic_compare_exchange_n(&queue->tail, &tail_node, new_node,
+                                false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+
+    _ebr_exit(slot);
+
+    return 0;
+}
+
+
+
+int cm_mpmc_pop(cm_mpmc * queue, void * buf) {
+
+    cm_lst_node * head_node, * tail_node, * next_node;
+    _ebr_slot * slot;
+
+    slot = _ebr_enter(queue->ebr);
+    if (!slot) return -1;
+
+    while (true) {
+
+        head_node = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+        tail_node = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+        next_node = __atomic_load_n(&head_node->next, __ATOMIC_ACQUIRE);
+
+        if (head_node != __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+
+        if (head_node == tail_node) {
+
+            //the queue is empty
+            if (next_node == NULL) {
+                _ebr_exit(slot);
+                cm_errno = CM_ERR_USER_EMPTY;
+                return -1;
+            }
+
+            //help a lagging tail forward
+            __atomic_compare_exchange_n(&queue->tail, &tail_node, next_node,
+                                        false, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED);
+            continue;
+        }
+
+        //the popped node becomes the new dummy node
+        if (__atomic_compare_exchange_n(&queue->head, &head_node, next_node,
+                                        false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_RELAXED)) break;
+    }
+
+    //elements are never written after a push, so reading late is safe
+    memcpy(buf, next_node->data, queue->data_sz);
+    _ebr_retire(queue->ebr, slot, head_node);
+
+    _ebr_exit(slot);
+
+    return 0;
+}
+
+
+
+int cm_new_mpmc(cm_mpmc * queue, const size_t data_sz) {
+
+    cm_lst_node * dummy_node = _que_new_node(data_sz, NULL);
+    if (!dummy_node) return -1;
+
+    //popped nodes are only read through their next pointer and data
+    queue->ebr = _ebr_new(offsetof(cm_lst_node, prev));
+    if (!queue->ebr) {
+        free(dummy_node);
+        return -1;
+    }
+
+    queue->head = queue->tail = dummy_node;
+    queue->data_sz = data_sz;
+
+    return 0;
+}
+
+
+
+/*
+ *  Must only be called once no other thread uses the queue.
+ */
+
+void cm_del_mpmc(cm_mpmc * queue) {
+
+    cm_lst_node * node = queue->head, * next_node;
+
+    while (node != NULL) {
+        next_node = node->next;
+        free(node);
+        node = next_node;
+    }
+
+    _ebr_del(queue->ebr);
+
+    return;
+}
@@ -0,0 +1,31 @@
+#ifndef QUE_H
+#define QUE_H
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+#ifdef DEBUG
+//internal
+cm_lst_node * _que_new_node(const size_t data_sz, const void * data);
+#endif
+
+
+//external
+int cm_mpsc_push(cm_mpsc * queue, const void * data);
+int cm_mpsc_pop(cm_mpsc * queue, void * buf);
+
+int cm_new_mpsc(cm_mpsc * queue, const size_t data_sz);
+void cm_del_mpsc(cm_mpsc * queue);
+
+int cm_mpmc_push(cm_mpmc * queue, const void * data);
+int cm_mpmc_pop(cm_mpmc * queue, void * buf);
+
+int cm_new_mpmc(cm_mpmc * queue, const size_t data_sz);
+void cm_del_mpmc(cm_mpmc * queue);
+
+#endif
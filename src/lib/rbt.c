@@ -1,13 +1,19 @@
 //standard library
 #include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
 //system headers
 #include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
 
 //local headers
 #include "cmore.h"
 #include "rbt.h"
+#include "arn.h"
+#include "ebr.h"
 
 
 
@@ -25,13 +31,13 @@
 
 /*
  *  Returns the node itself in case of a hit. Returns parent in case of a miss.
+ *  The search starts at node, which may be the root of any subtree.
  */
 
 DBG_STATIC 
-cm_rbt_node * _rbt_traverse(const cm_rbt * tree, 
-                            const void * key, enum cm_rbt_side * side) {
+cm_rbt_node * _rbt_descend(const cm_rbt * tree, cm_rbt_node * node,
+                           const void * key, enum cm_rbt_side * side) {
 
-    cm_rbt_node * node = tree->root;
     bool found = false;
     *side = ROOT;
 
@@ -70,44 +76,135 @@ cm_rbt_node * _rbt_traverse(const cm_rbt * tree,
 
 
 
+DBG_STATIC DBG_INLINE
+cm_rbt_node * _rbt_traverse(const cm_rbt * tree, 
+                            const void * key, enum cm_rbt_side * side) {
+
+    return _rbt_descend(tree, tree->root, key, side);
+}
+
+
+
+/*
+ *  Finger search, returning the same as _rbt_traverse() but starting from 
+ *  a node already in the tree. The keys of a subtree are bounded by the 
+ *  ancestors it hangs off, so climbing from the hint only compares the key 
+ *  to ancestors that bound it on the key's side. The climb stops at the 
+ *  first of these that lies beyond the key, and the search descends from 
+ *  the last node passed whose subtree may still hold the key. Only nodes 
+ *  between the hint and the key's position are compared.
+ */
+
+DBG_STATIC
+cm_rbt_node * _rbt_traverse_from(const cm_rbt * tree, cm_rbt_node * hint,
+                                 const void * key, enum cm_rbt_side * side) {
+
+    cm_rbt_node * node, * parent, * start;
+    enum cm_rbt_side dir, bound_side, parent_dir;
+
+    if (hint == NULL) return _rbt_traverse(tree, key, side);
+
+    dir = tree->compare(key, hint->key);
+    if (dir == EQUAL) {
+        *side = EQUAL;
+        return hint;
+    }
+
+    //a node's subtree is bounded by the ancestors it lies on this side of
+    bound_side = dir == MORE ? LESS : MORE;
+    node = start = hint;
+
+    while (cm_rbt_parent_side(node) != ROOT) {
+
+        parent = cm_rbt_parent(node);
+
+        if (cm_rbt_parent_side(node) == bound_side) {
+
+            parent_dir = tree->compare(key, parent->key);
+            if (parent_dir == EQUAL) {
+                *side = EQUAL;
+                return parent;
+            }
+
+            //the key lies within the subtree of start
+            if (parent_dir != dir) break;
+            start = parent;
+        }
+
+        node = parent;
+
+    } //end while
+
+    return _rbt_descend(tree, start, key, side);
+}
+
+
+
 DBG_STATIC 
 cm_rbt_node * _rbt_new_node(const cm_rbt * tree,
                             const void * key, const void * data) {
 
-    //allocate node structure
-    cm_rbt_node * new_node = malloc(sizeof(cm_rbt_node));
-    if (!new_node) {
-        cm_errno = CM_ERR_MALLOC;
-        return NULL;
-    }
+    cm_rbt_node * new_node;
 
-    //allocate key
-    new_node->key = malloc(tree->key_sz);
-    if (!new_node->key) {
-        cm_errno = CM_ERR_MALLOC;
-        return NULL;
-    }
+    //arena trees take the node, key and data from the tree's chunks
+    if (tree->mode == CM_RBT_ARENA) {
 
-    //allocate data
-    new_node->data = malloc(tree->data_sz);
-    if (!new_node->data) {
-        cm_errno = CM_ERR_MALLOC;
-        return NULL;
+        new_node = _arn_alloc(tree->arn);
+        if (!new_node) return NULL;
+
+        new_node->key = new_node->inl;
+        new_node->data = new_node->inl + ARN_ROUND(tree->key_sz);
+
+    //inline trees store the key and data at the end of the node
+    } else if (tree->mode == CM_RBT_INLINE) {
+
+        //allocate node structure, key, data and aggregate together
+        new_node = malloc(sizeof(cm_rbt_node) + tree->aug_off + tree->aug_sz);
+        if (!new_node) {
+            cm_errno = CM_ERR_MALLOC;
+            return NULL;
+        }
+
+        new_node->key = new_node->inl;
+        new_node->data = new_node->inl + ARN_ROUND(tree->key_sz);
+
+    } else {
+
+        //allocate node structure
+        new_node = malloc(sizeof(cm_rbt_node));
+        if (!new_node) {
+            cm_errno = CM_ERR_MALLOC;
+            return NULL;
+        }
+
+        //allocate key
+        new_node->key = malloc(tree->key_sz);
+        if (!new_node->key) {
+            cm_errno = CM_ERR_MALLOC;
+            return NULL;
+        }
+
+        //allocate data
+        new_node->data = malloc(tree->data_sz);
+        if (!new_node->data) {
+            cm_errno = CM_ERR_MALLOC;
+            return NULL;
+        }
     }
 
     //copy the key into the node
     memcpy(new_node->key, key, tree->key_sz);
 
-    //copy the data into the node
-    memcpy(new_node->data, data, tree->data_sz);
+    //copy the data into the node, unless the caller will fill it in place
+    if (data != NULL) memcpy(new_node->data, data, tree->data_sz);
 
-    //null out pointers
-    new_node->parent = NULL;
+    //null out pointers, the side is set once the node is linked
+    new_node->parent_bits = 0;
     new_node->left   = NULL;
     new_node->right  = NULL;
 
     //set colour to red
-    new_node->colour = RED;
+    RBT_SET_COLOUR(new_node, RED);
 
     return new_node;
 }
@@ -117,8 +214,11 @@ cm_rbt_node * _rbt_new_node(const cm_rbt * tree,
 DBG_STATIC 
 void _rbt_del_node(cm_rbt_node * node) {
 
-    free(node->key);
-    free(node->data);
+    //inline nodes hold their key and data in the same allocation
+    if (node->key != node->inl) {
+        free(node->key);
+        free(node->data);
+    }
     free(node);
 
     return;
@@ -126,11 +226,26 @@ void _rbt_del_node(cm_rbt_node * node) {
 
 
 
+DBG_STATIC DBG_INLINE 
+void _rbt_free_node(const cm_rbt * tree, cm_rbt_node * node) {
+
+    //arena nodes are returned to the arena for reuse
+    if (tree->mode == CM_RBT_ARENA) {
+        _arn_free(tree->arn, node);
+    } else {
+        _rbt_del_node(node);
+    }
+
+    return;
+}
+
+
+
 DBG_STATIC DBG_INLINE 
 void _rbt_set_root(cm_rbt * tree, cm_rbt_node * node) {
 
-    node->colour      = BLACK;
-    node->parent_side = ROOT;    
+    RBT_SET_COLOUR(node, BLACK);
+    RBT_SET_SIDE(node, ROOT);    
     tree->root = node;
 
     return;
@@ -138,28 +253,57 @@ void _rbt_set_root(cm_rbt * tree, cm_rbt_node * node) {
 
 
 
+//recompute the subtree aggregate of a node from its children
+DBG_STATIC DBG_INLINE 
+void _rbt_aug_node(const cm_rbt * tree, cm_rbt_node * node) {
+
+    tree->aug(cm_rbt_aug(tree, node), node->key, node->data,
+              node->left == NULL ? NULL : cm_rbt_aug(tree, node->left),
+              node->right == NULL ? NULL : cm_rbt_aug(tree, node->right));
+
+    return;
+}
+
+
+
+//recompute the subtree aggregates from a node up to the root
+DBG_STATIC 
+void _rbt_aug_path(const cm_rbt * tree, cm_rbt_node * node) {
+
+    while (true) {
+
+        _rbt_aug_node(tree, node);
+        if (cm_rbt_parent_side(node) == ROOT) break;
+        node = cm_rbt_parent(node);
+    }
+
+    return;
+}
+
+
+
 DBG_STATIC 
 void _rbt_left_rotate(cm_rbt * tree, cm_rbt_node * node) {
 
     cm_rbt_node * right_child    = node->right;
-    cm_rbt_node * parent         = node->parent;
-    enum cm_rbt_side parent_side = node->parent_side;
+    cm_rbt_node * parent         = cm_rbt_parent(node);
+    enum cm_rbt_side parent_side = cm_rbt_parent_side(node);
 
     //rotate node
     node->right       = node->right->left;
-    node->parent      = right_child;
-    node->parent_side = LESS;
+    RBT_SET_PARENT(node, right_child);
+    RBT_SET_SIDE(node, LESS);
 
     //rotate node's former right child
     right_child->left        = node;
-    right_child->parent      = parent;
-    right_child->parent_side = parent_side;
+    RBT_SET_PARENT(right_child, parent);
+    RBT_SET_SIDE(right_child, parent_side);
 
     //rotate former right child's left child
     if (node->right != NULL) {
-        node->right->parent = node;
-        node->right->parent_side 
-            = node->right->parent_side == MORE ? LESS : MORE;
+        RBT_SET_PARENT(node->right, node);
+        RBT_SET_SIDE(node->right, 
+                     cm_rbt_parent_side(node->right) == MORE ? LESS : MORE);
     }
 
     //update parent
@@ -171,6 +315,12 @@ void _rbt_left_rotate(cm_rbt * tree, cm_rbt_node * node) {
         if (parent_side == MORE) parent->right = right_child;
     }
 
+    //only the two rotated nodes have different subtrees
+    if (tree->aug != NULL) {
+        _rbt_aug_node(tree, node);
+        _rbt_aug_node(tree, right_child);
+    }
+
     return;
 }
 
@@ -180,24 +330,24 @@ DBG_STATIC
 void _rbt_right_rotate(cm_rbt * tree, cm_rbt_node * node) {
 
     cm_rbt_node * left_child     = node->left;
-    cm_rbt_node * parent         = node->parent;
-    enum cm_rbt_side parent_side = node->parent_side;
+    cm_rbt_node * parent         = cm_rbt_parent(node);
+    enum cm_rbt_side parent_side = cm_rbt_parent_side(node);
 
     //rotate node
     node->left        = node->left->right;
-    node->parent      = left_child;
-    node->parent_side = MORE;
+    RBT_SET_PARENT(node, left_child);
+    RBT_SET_SIDE(node, MORE);
 
     //rotate node's former right child
     left_child->right       = node;
-    left_child->parent      = parent;
-    left_child->parent_side = parent_side;
+    RBT_SET_PARENT(left_child, parent);
+    RBT_SET_SIDE(left_child, parent_side);
 
     //rotate former right child's left child
     if (node->left != NULL) {
-        node->left->parent = node;
-        node->left->parent_side 
-            = node->left->parent_side == MORE ? LESS : MORE;
+        RBT_SET_PARENT(node->left, node);
+        RBT_SET_SIDE(node->left, 
+                     cm_rbt_parent_side(node->left) == MORE ? LESS : MORE);
     }
 
     //update parent
@@ -209,6 +359,12 @@ void _rbt_right_rotate(cm_rbt * tree, cm_rbt_node * node) {
         if (parent_side == MORE) parent->right = left_child;
     }
 
+    //only the two rotated nodes have different subtrees
+    if (tree->aug != NULL) {
+        _rbt_aug_node(tree, node);
+        _rbt_aug_node(tree, left_child);
+    }
+
     return;
 }
 
@@ -228,28 +384,30 @@ void _rbt_transplant(cm_rbt * tree,
 
         //set root
         tree->root            = tgt_node;
-        tgt_node->parent      = NULL;
+        RBT_SET_PARENT(tgt_node, NULL);
         _rbt_set_root(tree, tgt_node);
 
         //re-attach right branch
         tgt_node->right         = subj_node->right;
-        tgt_node->right->parent = tgt_node;
+        RBT_SET_PARENT(tgt_node->right, tgt_node);
    
     } else {
 
         //update subject node's parent
-        if (subj_node->parent_side == MORE) subj_node->parent->right = tgt_node;
-        if (subj_node->parent_side == LESS) subj_node->parent->left  = tgt_node;
+        if (cm_rbt_parent_side(subj_node) == MORE) 
+            cm_rbt_parent(subj_node)->right = tgt_node;
+        if (cm_rbt_parent_side(subj_node) == LESS) 
+            cm_rbt_parent(subj_node)->left  = tgt_node;
 
         //if target node is not NULL
         if (tgt_node != NULL) {
 
             //update target node
-            tgt_node->parent      = subj_node->parent;
-            tgt_node->parent_side = subj_node->parent_side;
+            RBT_SET_PARENT(tgt_node, cm_rbt_parent(subj_node));
+            RBT_SET_SIDE(tgt_node, cm_rbt_parent_side(subj_node));
         
             //set target node to the colour of subject node
-            tgt_node->colour = subj_node->colour;
+            RBT_SET_COLOUR(tgt_node, cm_rbt_colour(subj_node));
         }
 
         
@@ -282,7 +440,7 @@ DBG_STATIC DBG_INLINE
 enum cm_rbt_colour _rbt_get_colour(const cm_rbt_node * node) {
 
     if (node == NULL) return BLACK;
-    return node->colour == BLACK ? BLACK : RED;
+    return cm_rbt_colour(node) == BLACK ? BLACK : RED;
 }
 
 
@@ -294,22 +452,22 @@ void _rbt_populate_fix_data(const cm_rbt_node * node,
     memset(f_data, 0, sizeof(*f_data));
     
     //if unable to get parent, then unable to get everything
-    if (node->parent == NULL) return;
+    if (cm_rbt_parent(node) == NULL) return;
     
     //get parent & grandparent
-    f_data->parent = node->parent;
-    f_data->grandparent = f_data->parent->parent;
+    f_data->parent = cm_rbt_parent(node);
+    f_data->grandparent = cm_rbt_parent(f_data->parent);
 
     //get uncle
-    if (f_data->parent->parent_side == LESS)
+    if (cm_rbt_parent_side(f_data->parent) == LESS)
         f_data->uncle = f_data->grandparent->right;
-    if (f_data->parent->parent_side == MORE)
+    if (cm_rbt_parent_side(f_data->parent) == MORE)
         f_data->uncle = f_data->grandparent->left;
 
     //get sibling
-    if (node->parent_side == LESS)
+    if (cm_rbt_parent_side(node) == LESS)
         f_data->sibling = f_data->parent->right;
-    if (node->parent_side == MORE)
+    if (cm_rbt_parent_side(node) == MORE)
         f_data->sibling = f_data->parent->left;
 
     return;
@@ -328,9 +486,10 @@ void _rbt_ins_case_1(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //swap colours per red uncle case
-    f_data->parent->colour = BLACK;
-    f_data->uncle->colour  = BLACK;
-    if (tree->root != f_data->grandparent) f_data->grandparent->colour = RED;
+    RBT_SET_COLOUR(f_data->parent, BLACK);
+    RBT_SET_COLOUR(f_data->uncle, BLACK);
+    if (tree->root != f_data->grandparent) 
+        RBT_SET_COLOUR(f_data->grandparent, RED);
 
     //advance node to grandparent
     *node = f_data->grandparent;
@@ -349,7 +508,7 @@ DBG_STATIC DBG_INLINE
 void _rbt_ins_case_2(cm_rbt * tree, 
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
-    f_data->parent->colour = BLACK;
+    RBT_SET_COLOUR(f_data->parent, BLACK);
 
     return;
 }
@@ -369,7 +528,7 @@ void _rbt_ins_case_3(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
     
     //node is left child
-    if ((*node)->parent_side == LESS) {
+    if (cm_rbt_parent_side(*node) == LESS) {
         _rbt_right_rotate(tree, f_data->parent);
         *node = (*node)->right;
     
@@ -396,7 +555,7 @@ void _rbt_ins_case_4(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //node is left child
-    if ((*node)->parent_side == LESS) {
+    if (cm_rbt_parent_side(*node) == LESS) {
         _rbt_right_rotate(tree, f_data->grandparent);
     
     } else {
@@ -404,8 +563,8 @@ void _rbt_ins_case_4(cm_rbt * tree,
     }
 
     //recolour parent and grandparent
-    f_data->grandparent->colour = RED;
-    f_data->parent->colour      = BLACK;
+    RBT_SET_COLOUR(f_data->grandparent, RED);
+    RBT_SET_COLOUR(f_data->parent, BLACK);
 
     return;
 }
@@ -425,14 +584,14 @@ void _rbt_rem_case_1(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //get side of sibling
-    enum cm_rbt_side sibling_side = f_data->sibling->parent_side;
+    enum cm_rbt_side sibling_side = cm_rbt_parent_side(f_data->sibling);
 
     //recolour sibling and parent
-    f_data->sibling->colour = BLACK;
-    f_data->parent->colour  = RED;
+    RBT_SET_COLOUR(f_data->sibling, BLACK);
+    RBT_SET_COLOUR(f_data->parent, RED);
 
     //rotate parent to make sibling the new grandparent 
-    if (f_data->sibling->parent_side == LESS) {
+    if (cm_rbt_parent_side(f_data->sibling) == LESS) {
         _rbt_right_rotate(tree, f_data->parent);
     
     } else {
@@ -440,7 +599,7 @@ void _rbt_rem_case_1(cm_rbt * tree,
     }
 
     //update fix data
-    f_data->grandparent = f_data->parent->parent;
+    f_data->grandparent = cm_rbt_parent(f_data->parent);
     if (sibling_side == MORE) {
         f_data->sibling = f_data->parent->right;
     } else {
@@ -462,15 +621,15 @@ DBG_STATIC DBG_INLINE
 void _rbt_rem_case_2(cm_rbt * tree, 
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
-    f_data->sibling->colour = RED;
+    RBT_SET_COLOUR(f_data->sibling, RED);
     
-    if (f_data->parent->colour == RED) {
+    if (cm_rbt_colour(f_data->parent) == RED) {
 
         //apply fix
         *node = tree->root;
 
         //update fix data        
-        f_data->parent->colour = BLACK;
+        RBT_SET_COLOUR(f_data->parent, BLACK);
     
     } else {
 
@@ -498,11 +657,11 @@ void _rbt_rem_case_3(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //colour close nephew black, set sibling's colour to RED, rotate 
-    if (f_data->sibling->parent_side == LESS) {    
+    if (cm_rbt_parent_side(f_data->sibling) == LESS) {    
 
         //perform fix
-        f_data->sibling->right->colour = BLACK;
-        f_data->sibling->colour       = RED;
+        RBT_SET_COLOUR(f_data->sibling->right, BLACK);
+        RBT_SET_COLOUR(f_data->sibling, RED);
         _rbt_left_rotate(tree, f_data->sibling);
 
         //update fix data
@@ -511,8 +670,8 @@ void _rbt_rem_case_3(cm_rbt * tree,
     } else {
 
         //perform fix
-        f_data->sibling->left->colour = BLACK; 
-        f_data->sibling->colour       = RED;
+        RBT_SET_COLOUR(f_data->sibling->left, BLACK); 
+        RBT_SET_COLOUR(f_data->sibling, RED);
         _rbt_right_rotate(tree, f_data->sibling);
     
         //update fix data
@@ -537,18 +696,18 @@ void _rbt_rem_case_4(cm_rbt * tree,
                      cm_rbt_node ** node, struct _rbt_fix_data * f_data) {
 
     //recolour nodes
-    f_data->sibling->colour        = f_data->parent->colour;
-    f_data->parent->colour         = BLACK;
+    RBT_SET_COLOUR(f_data->sibling, cm_rbt_colour(f_data->parent));
+    RBT_SET_COLOUR(f_data->parent, BLACK);
 
     //colour far nephew black, rotate
-    if (f_data->sibling->parent_side == LESS) {
+    if (cm_rbt_parent_side(f_data->sibling) == LESS) {
         
-        f_data->sibling->left->colour = BLACK;
+        RBT_SET_COLOUR(f_data->sibling->left, BLACK);
         _rbt_right_rotate(tree, f_data->parent);
     
     } else {
         
-        f_data->sibling->right->colour = BLACK;
+        RBT_SET_COLOUR(f_data->sibling->right, BLACK);
         _rbt_left_rotate(tree, f_data->parent);
     }
 
@@ -568,7 +727,7 @@ int _rbt_determine_ins_case(const cm_rbt_node * node,
 
 
     //if node is root and is red, no fix necessary
-    if (node->parent_side == ROOT) return 0;
+    if (cm_rbt_parent_side(node) == ROOT) return 0;
 
     //determine if parent is black
     parent_black = _rbt_get_colour(f_data->parent) == BLACK ? true : false;
@@ -581,19 +740,21 @@ int _rbt_determine_ins_case(const cm_rbt_node * node,
 
     //if uncle is red, case 1
     if (!uncle_black)
-        if (f_data->uncle->colour == RED) return 1;
+        if (cm_rbt_colour(f_data->uncle) == RED) return 1;
 
     //if parent is root, case 2
-    if (f_data->parent->parent_side == ROOT) return 2;
+    if (cm_rbt_parent_side(f_data->parent) == ROOT) return 2;
 
     //determine 'triangle' or 'line' case
     if (uncle_black) {
 
         //if red nodes form a 'triange', case 3
-        if (node->parent_side != f_data->parent->parent_side) return 3;
+        if (cm_rbt_parent_side(node) 
+            != cm_rbt_parent_side(f_data->parent)) return 3;
 
         //if red nodes form a 'line', case 4
-        if (node->parent_side == f_data->parent->parent_side) return 4;
+        if (cm_rbt_parent_side(node) 
+            == cm_rbt_parent_side(f_data->parent)) return 4;
 
     }
 
@@ -630,9 +791,9 @@ int _rbt_determine_rem_case(const cm_rbt * tree, const cm_rbt_node * node,
     if ((left_colour == BLACK) && (right_colour == BLACK)) return 2;
 
     //case 3 and 4 work with 'close' and 'distant' nephews
-    close_colour = f_data->sibling->parent_side == LESS 
+    close_colour = cm_rbt_parent_side(f_data->sibling) == LESS 
                    ? right_colour : left_colour;
-    distant_colour = f_data->sibling->parent_side == LESS 
+    distant_colour = cm_rbt_parent_side(f_data->sibling) == LESS 
                      ? left_colour : right_colour;
 
     //if sibling's left child is red and right child is black, case 3
@@ -648,6 +809,12 @@ int _rbt_determine_rem_case(const cm_rbt * tree, const cm_rbt_node * node,
 
 
 
+/*
+ *  Returns 1 if the black height of the tree grew, which joins rely on. 
+ *  That happens when a red root is made black, or when case 1 reaches the 
+ *  root, which stays black while both its children are made black.
+ */
+
 DBG_STATIC 
 int _rbt_fix_ins(cm_rbt * tree, cm_rbt_node * node) {
 
@@ -657,6 +824,7 @@ int _rbt_fix_ins(cm_rbt * tree, cm_rbt_node * node) {
      */
 
     int fix_case;
+    bool grew = false;
     struct _rbt_fix_data f_data;
 
     //move up tree and correct violations until fixed or root is reached
@@ -672,12 +840,13 @@ int _rbt_fix_ins(cm_rbt * tree, cm_rbt_node * node) {
         switch (fix_case) {
 
             case 1:
+                grew = f_data.grandparent == tree->root;
                 _rbt_ins_case_1(tree, &node, &f_data);
                 break;
             
             case 2:
                 _rbt_ins_case_2(tree, &node, &f_data);
-                return 0;
+                return 1;
 
             case 3:
                 _rbt_ins_case_3(tree, &node, &f_data);
@@ -691,7 +860,7 @@ int _rbt_fix_ins(cm_rbt * tree, cm_rbt_node * node) {
 
     } //end while
 
-    return 0;
+    return grew ? 1 : 0;
 }
 
 
@@ -745,6 +914,10 @@ cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key,
 
     //create new node
     cm_rbt_node * node = _rbt_new_node(tree, key, data);
+    if (node == NULL) return NULL;
+
+    //concurrent readers must not reach the node before it is filled in
+    if (tree->sync != NULL) __atomic_thread_fence(__ATOMIC_RELEASE);
 
     //if tree is empty, set root
     if (tree->size == 0) {
@@ -752,12 +925,12 @@ cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key,
 
     //else connect node
     } else {
-        node->parent = parent;
+        RBT_SET_PARENT(node, parent);
         if (side == LESS) {
-            node->parent_side = LESS;
+            RBT_SET_SIDE(node, LESS);
             parent->left = node;
         } else {
-            node->parent_side = MORE;
+            RBT_SET_SIDE(node, MORE);
             parent->right = node;
         }
     }
@@ -765,6 +938,9 @@ cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key,
     //increment tree size
     tree->size += 1;
 
+    //the new node is part of every subtree above it
+    if (tree->aug != NULL) _rbt_aug_path(tree, node);
+
     //fix violations
     ret = _rbt_fix_ins(tree, node);
     if (ret == -1) return NULL;
@@ -776,28 +952,22 @@ cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key,
 
 
 DBG_STATIC 
-cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
+cm_rbt_node * _rbt_uln_node(cm_rbt * tree, cm_rbt_node * node) {
 
     int ret;
 
     struct _rbt_fix_data f_data;
-    cm_rbt_node * node, * max_node, * fix_node;
+    cm_rbt_node * max_node, * fix_node, * aug_node;
     
-    enum cm_rbt_side side;
     enum cm_rbt_colour unlink_colour;
     
 
     //do not apply fixes by default
     unlink_colour = RED;
-    
-    //get relevant node
-    node = _rbt_traverse(tree, key, &side);
+    memset(&f_data, 0, sizeof(f_data));
 
-    //if a node doesn't exist for this key, error out
-    if (side != EQUAL || node == NULL) {
-        cm_errno = CM_ERR_USER_KEY;
-        return NULL;
-    }
+    //lowest node whose subtree changes, unless a successor is moved up
+    aug_node = cm_rbt_parent_side(node) == ROOT ? NULL : cm_rbt_parent(node);
 
 
     //both children present
@@ -806,19 +976,21 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         //get maximum node in left subtree
         max_node = _rbt_left_max(node);
         fix_node = max_node->left;
+        aug_node = cm_rbt_parent(max_node) == node 
+                   ? max_node : cm_rbt_parent(max_node);
 
         
-        if (max_node->colour == BLACK && 
+        if (cm_rbt_colour(max_node) == BLACK && 
             _rbt_get_colour(fix_node) == RED) {
 
             //can replace min node with its child and 
             //colour it black, no fix necessary
-            fix_node->colour = BLACK;
+            RBT_SET_COLOUR(fix_node, BLACK);
 
         } else {
 
             //save state prior to removal for use during fixing
-            unlink_colour = max_node->colour;
+            unlink_colour = cm_rbt_colour(max_node);
             if (unlink_colour == BLACK) 
                 _rbt_populate_fix_data(max_node, &f_data);
         }
@@ -828,14 +1000,15 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         
         //re-attach maximum node as root of left subtree
         max_node->left = node->left;
-        if (max_node->left != NULL) max_node->left->parent = max_node;
+        if (max_node->left != NULL) RBT_SET_PARENT(max_node->left, max_node);
 
         //set minimum node as new root of whole tree
         _rbt_transplant(tree, node, max_node);
 
         //re-attach maxumum node as root of right subtree
         max_node->right = node->right;
-        if (max_node->right != NULL) max_node->right->parent = max_node;  
+        if (max_node->right != NULL) 
+            RBT_SET_PARENT(max_node->right, max_node);
 
         //update fix data if transplant caused parent to change
         if (f_data.parent == node) f_data.parent = max_node;
@@ -847,7 +1020,7 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         _rbt_transplant(tree, node, node->left);
         
         //convert node to BLACK, this is guaranteed to maintain balance
-        node->left->colour = BLACK;
+        RBT_SET_COLOUR(node->left, BLACK);
 
     //only a right child
     } else if (node->left == NULL && node->right != NULL) {
@@ -856,7 +1029,7 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         _rbt_transplant(tree, node, node->right);
         
         //convert node to BLACK, this is guaranteed to maintain balance
-        node->right->colour = BLACK;
+        RBT_SET_COLOUR(node->right, BLACK);
     
     //no children present
     } else {
@@ -864,11 +1037,11 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         fix_node = NULL;
 
         //save state prior to removal for use during fixing
-        unlink_colour = node->colour;
+        unlink_colour = cm_rbt_colour(node);
         if (unlink_colour == BLACK) 
             _rbt_populate_fix_data(node, &f_data);
 
-        if (node->parent_side == ROOT) {
+        if (cm_rbt_parent_side(node) == ROOT) {
 
             //set tree root to NULL
             tree->root = NULL;
@@ -876,16 +1049,19 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
         } else {
 
             //remove node from parent
-            if (node->parent_side == LESS) {
-                node->parent->left = NULL;
+            if (cm_rbt_parent_side(node) == LESS) {
+                cm_rbt_parent(node)->left = NULL;
             } else {
-                node->parent->right = NULL;
+                cm_rbt_parent(node)->right = NULL;
             }
         }
     }
 
     tree->size -= 1;
 
+    //the node is no longer part of the subtrees above it
+    if (tree->aug != NULL && aug_node != NULL) _rbt_aug_path(tree, aug_node);
+
     //if a black node was removed, must correct tree
     if (unlink_colour == BLACK) {
         ret = _rbt_fix_rem(tree, fix_node, unlink_colour, &f_data);
@@ -897,164 +1073,1609 @@ cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key) {
 
 
 
+/*
+ *  Builds the subtree of the keys in [lo, hi) from their middle key, and
+ *  links it below parent. Nodes are linked as soon as they are created, so
+ *  a partially built tree can be emptied. Only nodes at red_depth are red,
+ *  which keeps every path to a leaf at the same black height.
+ */
+
 DBG_STATIC 
-void _rbt_emp_recurse(cm_rbt_node * node) {
+int _rbt_build(cm_rbt * tree, const cm_byte * keys, const cm_byte * datas,
+               const int lo, const int hi, const int depth, 
+               const int red_depth, cm_rbt_node * parent, 
+               const enum cm_rbt_side side) {
 
-    if (node == NULL) return;
-    if (node->left != NULL) _rbt_emp_recurse(node->left);
-    if (node->right != NULL) _rbt_emp_recurse(node->right);
-    _rbt_del_node(node);
+    int ret, mid;
+    cm_rbt_node * node;
 
-    return;
+    if (lo >= hi) return 0;
+    mid = lo + ((hi - lo) / 2);
+
+    node = _rbt_new_node(tree, keys + (tree->key_sz * mid), 
+                         datas == NULL ? NULL : datas + (tree->data_sz * mid));
+    if (node == NULL) return -1;
+
+    //connect node
+    if (parent == NULL) {
+        _rbt_set_root(tree, node);
+    } else {
+        RBT_SET_PARENT(node, parent);
+        RBT_SET_SIDE(node, side);
+        if (side == LESS) {
+            parent->left = node;
+        } else {
+            parent->right = node;
+        }
+        RBT_SET_COLOUR(node, depth == red_depth ? RED : BLACK);
+    }
+    tree->size += 1;
+
+    ret = _rbt_build(tree, keys, datas, lo, mid, 
+                     depth + 1, red_depth, node, LESS);
+    if (ret == -1) return -1;
+    ret = _rbt_build(tree, keys, datas, mid + 1, hi, 
+                     depth + 1, red_depth, node, MORE);
+    if (ret == -1) return -1;
+
+    //both subtrees are complete, so the aggregate can be computed
+    if (tree->aug != NULL) _rbt_aug_node(tree, node);
+
+    return 0;
 }
 
 
 
+//returns the number of nodes freed
+DBG_STATIC 
+int _rbt_emp_recurse(const cm_rbt * tree, cm_rbt_node * node) {
+
+    int freed = 1;
+
+    if (node == NULL) return 0;
+    if (node->left != NULL) freed += _rbt_emp_recurse(tree, node->left);
+    if (node->right != NULL) freed += _rbt_emp_recurse(tree, node->right);
+    _rbt_free_node(tree, node);
+
+    return freed;
+}
+
+
 /*
- *  --- [EXTERNAL] ---
+ *  Joins work on detached subtrees, whose roots are black and have no 
+ *  parent. A subtree is passed along with its black height, so heights 
+ *  are only ever counted when a whole tree is first detached.
  */
 
-int cm_rbt_get(const cm_rbt * tree, const void * key, void * buf) {
+DBG_STATIC 
+int _rbt_black_height(const cm_rbt_node * node) {
 
-    enum cm_rbt_side side;
+    int height = 0;
 
-    //get the node
-    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
-    if (side != EQUAL) {
-        
-        cm_errno = CM_ERR_USER_KEY;
-        return -1;
+    //every path has the same black height, so follow the left one
+    while (node != NULL) {
+        if (cm_rbt_colour(node) == BLACK) height += 1;
+        node = node->left;
     }
 
-    memcpy(buf, node->data, tree->data_sz);
-
-    return 0;
+    return height;
 }
 
 
 
-void * cm_rbt_get_p(const cm_rbt * tree, const void * key) {
+/*
+ *  Cuts a child off its parent, and makes it the black root of its own 
+ *  subtree. height is the black height of the parent's children.
+ */
 
-    enum cm_rbt_side side;
+DBG_STATIC DBG_INLINE 
+struct _rbt_sub _rbt_detach(cm_rbt_node * node, const int height) {
 
-    //get the node
-    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
-    if (side != EQUAL) {
-    
-        cm_errno = CM_ERR_USER_KEY;
-        return NULL;
-    }
+    struct _rbt_sub sub = {node, height};
 
-    return node->data;
+    if (node == NULL) return (struct _rbt_sub) {NULL, 0};
+
+    //a red child made black adds a black node to every path through it
+    if (cm_rbt_colour(node) == RED) sub.height += 1;
+
+    node->parent_bits = 0;
+    RBT_SET_SIDE(node, ROOT);
+    RBT_SET_COLOUR(node, BLACK);
+
+    return sub;
 }
 
 
 
-cm_rbt_node * cm_rbt_get_n(const cm_rbt * tree, const void * key) {
+//link a node's children back to it
+DBG_STATIC DBG_INLINE 
+void _rbt_adopt(cm_rbt_node * node) {
 
-    enum cm_rbt_side side;
+    if (node->left != NULL) {
+        RBT_SET_PARENT(node->left, node);
+        RBT_SET_SIDE(node->left, LESS);
+    }
 
-    //get the node
-    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
-    if (side != EQUAL) {
-        
-        cm_errno = CM_ERR_USER_KEY;
-        return NULL;
+    if (node->right != NULL) {
+        RBT_SET_PARENT(node->right, node);
+        RBT_SET_SIDE(node->right, MORE);
     }
 
-    return node;
+    return;
 }
 
 
 
-cm_rbt_node * cm_rbt_set(cm_rbt * tree,
-                         const void * key, const void * data) {
+/*
+ *  Joins two subtrees with a middle node whose key lies between theirs. 
+ *  The shorter subtree is hung from the spine of the taller one, at the 
+ *  first black node of the same height, under the middle node. The middle 
+ *  node is red, so only the red violation above it needs to be fixed, 
+ *  which costs the difference in heights.
+ */
+
+DBG_STATIC 
+struct _rbt_sub _rbt_join3(const cm_rbt * tree, struct _rbt_sub left, 
+                           cm_rbt_node * mid, struct _rbt_sub right) {
 
+    int height, ret;
     enum cm_rbt_side side;
+    cm_rbt tmp;
+    struct _rbt_sub tall, stub;
+    cm_rbt_node * node, * parent = NULL;
 
-    //get relevant node
-    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
 
-    //if a node already exists for this key, update its value
-    if (side == EQUAL) {
-        memcpy(node->data, data, tree->data_sz);
-        return node;
+    //subtrees of the same height become the children of a black root
+    if (left.height == right.height) {
 
-    //else create a new node
-    } else { 
-        return _rbt_add_node(tree, key, data, node, side);
+        mid->left = left.root;
+        mid->right = right.root;
+        _rbt_adopt(mid);
+
+        mid->parent_bits = 0;
+        RBT_SET_SIDE(mid, ROOT);
+        RBT_SET_COLOUR(mid, BLACK);
+        if (tree->aug != NULL) _rbt_aug_node(tree, mid);
+
+        return (struct _rbt_sub) {mid, left.height + 1};
     }
-}
 
+    //descend the right spine of a taller left subtree, or the reverse
+    side = left.height > right.height ? MORE : LESS;
+    tall = side == MORE ? left : right;
+    stub = side == MORE ? right : left;
 
+    node = tall.root;
+    height = tall.height;
+    while (node != NULL 
+           && (cm_rbt_colour(node) == RED || height != stub.height)) {
 
-int cm_rbt_rem(cm_rbt * tree, const void * key) {
+        if (cm_rbt_colour(node) == BLACK) height -= 1;
+        parent = node;
+        node = side == MORE ? node->right : node->left;
+    }
 
-    //get relevant node
-    cm_rbt_node * node = _rbt_uln_node(tree, key);
-    if (node == NULL) return -1;
+    //hang the middle node with the shorter subtree from the spine
+    if (side == MORE) {
+        mid->left = node;
+        mid->right = stub.root;
+        parent->right = mid;
+    } else {
+        mid->left = stub.root;
+        mid->right = node;
+        parent->left = mid;
+    }
+    _rbt_adopt(mid);
 
-    _rbt_del_node(node);
+    mid->parent_bits = 0;
+    RBT_SET_PARENT(mid, parent);
+    RBT_SET_SIDE(mid, side);
+    RBT_SET_COLOUR(mid, RED);
 
-    return 0;
+    //balance the taller subtree as a tree of its own
+    tmp = *tree;
+    tmp.root = tall.root;
+
+    if (tree->aug != NULL) _rbt_aug_path(&tmp, mid);
+    ret = _rbt_fix_ins(&tmp, mid);
+
+    return (struct _rbt_sub) {tmp.root, tall.height + (ret == 1 ? 1 : 0)};
 }
 
 
 
-cm_rbt_node * cm_rbt_uln(cm_rbt * tree, const void * key) {
+//detach the greatest node of a subtree, leaving the rest in rest
+DBG_STATIC 
+cm_rbt_node * _rbt_split_last(const cm_rbt * tree, struct _rbt_sub sub, 
+                              struct _rbt_sub * rest) {
 
-    cm_rbt_node * node;
+    cm_rbt_node * node = sub.root, * last;
+    struct _rbt_sub left, right;
 
-    //get relevant node
-    node = _rbt_uln_node(tree, key);
+    left = _rbt_detach(node->left, sub.height - 1);
+    if (node->right == NULL) {
+        node->left = NULL;
+        *rest = left;
+        return node;
+    }
 
-    //null out pointers
-    node->parent = node->left = node->right = NULL;
+    right = _rbt_detach(node->right, sub.height - 1);
+    last = _rbt_split_last(tree, right, &right);
+    *rest = _rbt_join3(tree, left, node, right);
 
-    return node;
+    return last;
 }
 
 
 
-void cm_rbt_emp(cm_rbt * tree) {
+//joins two subtrees where every key of left is less than every key of right
+DBG_STATIC 
+struct _rbt_sub _rbt_join2(const cm_rbt * tree, 
+                           struct _rbt_sub left, struct _rbt_sub right) {
 
-    _rbt_emp_recurse(tree->root);
-    tree->root = NULL;
-    tree->size = 0;
+    cm_rbt_node * mid;
 
-    return;
+    if (left.root == NULL) return right;
+    if (right.root == NULL) return left;
+
+    mid = _rbt_split_last(tree, left, &left);
+
+    return _rbt_join3(tree, left, mid, right);
 }
 
 
 
-void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz, 
-                enum cm_rbt_side (*compare) (const void *, const void *)) {
+/*
+ *  Splits a subtree into the keys less than key and the keys greater than 
+ *  key. Returns the detached node holding key, or NULL if key is absent. 
+ *  Each level joins the half it cuts off with the part split below it.
+ */
 
-    tree->size      = 0;
-    tree->key_sz  = key_sz;
-    tree->data_sz = data_sz;
-    tree->root      = NULL;
-    tree->compare   = compare;
+DBG_STATIC 
+cm_rbt_node * _rbt_split(const cm_rbt * tree, struct _rbt_sub sub, 
+                         const void * key, struct _rbt_sub * left, 
+                         struct _rbt_sub * right) {
 
-    return;
+    enum cm_rbt_side side;
+    cm_rbt_node * node = sub.root, * found;
+    struct _rbt_sub node_left, node_right;
+
+    if (node == NULL) {
+        *left = *right = (struct _rbt_sub) {NULL, 0};
+        return NULL;
+    }
+
+    node_left = _rbt_detach(node->left, sub.height - 1);
+    node_right = _rbt_detach(node->right, sub.height - 1);
+    node->left = node->right = NULL;
+
+    side = tree->compare(key, node->key);
+
+    switch (side) {
+
+        case LESS:
+            found = _rbt_split(tree, node_left, key, left, &node_left);
+            *right = _rbt_join3(tree, node_left, node, node_right);
+            return found;
+
+        case MORE:
+            found = _rbt_split(tree, node_right, key, &node_right, right);
+            *left = _rbt_join3(tree, node_left, node, node_right);
+            return found;
+
+        default:
+            *left = node_left;
+            *right = node_right;
+            return node;
+
+    } //end switch
 }
 
 
 
-void cm_del_rbt(cm_rbt * tree) {
+//splits a subtree into the keys less than key, and the rest
+DBG_STATIC 
+void _rbt_split_from(const cm_rbt * tree, struct _rbt_sub sub, 
+                     const void * key, struct _rbt_sub * left, 
+                     struct _rbt_sub * right) {
 
-    _rbt_emp_recurse(tree->root);
-    tree->root = NULL;
-    tree->size = 0;
+    cm_rbt_node * found;
+
+    //a node holding the key itself becomes the least node on the right
+    found = _rbt_split(tree, sub, key, left, right);
+    if (found != NULL) {
+        *right = _rbt_join3(tree, (struct _rbt_sub) {NULL, 0}, 
+                            found, *right);
+    }
 
     return;
 }
 
 
 
-void cm_del_rbt_node(cm_rbt_node * node) {
+/*
+ *  Set operations split one subtree by the root key of the other, recurse 
+ *  on the two halves and join the results. Keys present in both subtrees 
+ *  keep the node of the first. freed counts the nodes that were freed.
+ */
 
-    _rbt_del_node(node);
+DBG_STATIC 
+struct _rbt_sub _rbt_union(const cm_rbt * tree, struct _rbt_sub sub, 
+                           struct _rbt_sub other, int * freed) {
 
-    return;
+    cm_rbt_node * node = sub.root, * found;
+    struct _rbt_sub left, right, other_left, other_right;
+
+    if (sub.root == NULL) return other;
+    if (other.root == NULL) return sub;
+
+    left = _rbt_detach(node->left, sub.height - 1);
+    right = _rbt_detach(node->right, sub.height - 1);
+
+    found = _rbt_split(tree, other, node->key, &other_left, &other_right);
+    if (found != NULL) {
+        _rbt_free_node(tree, found);
+        *freed += 1;
+    }
+
+    left = _rbt_union(tree, left, other_left, freed);
+    right = _rbt_union(tree, right, other_right, freed);
+
+    return _rbt_join3(tree, left, node, right);
+}
+
+
+
+DBG_STATIC 
+struct _rbt_sub _rbt_intersect(const cm_rbt * tree, struct _rbt_sub sub, 
+                               struct _rbt_sub other, int * freed) {
+
+    cm_rbt_node * node = sub.root, * found;
+    struct _rbt_sub left, right, other_left, other_right;
+
+    if (sub.root == NULL || other.root == NULL) {
+        *freed += _rbt_emp_recurse(tree, sub.root);
+        *freed += _rbt_emp_recurse(tree, other.root);
+        return (struct _rbt_sub) {NULL, 0};
+    }
+
+    left = _rbt_detach(node->left, sub.height - 1);
+    right = _rbt_detach(node->right, sub.height - 1);
+
+    found = _rbt_split(tree, other, node->key, &other_left, &other_right);
+
+    left = _rbt_intersect(tree, left, other_left, freed);
+    right = _rbt_intersect(tree, right, other_right, freed);
+
+    //keep the node only if the key is in both subtrees
+    if (found != NULL) {
+        _rbt_free_node(tree, found);
+        *freed += 1;
+        return _rbt_join3(tree, left, node, right);
+    }
+
+    _rbt_free_node(tree, node);
+    *freed += 1;
+
+    return _rbt_join2(tree, left, right);
+}
+
+
+
+DBG_STATIC 
+struct _rbt_sub _rbt_diff(const cm_rbt * tree, struct _rbt_sub sub, 
+                          struct _rbt_sub other, int * freed) {
+
+    cm_rbt_node * node = other.root, * found;
+    struct _rbt_sub left, right, other_left, other_right;
+
+    if (sub.root == NULL || other.root == NULL) {
+        *freed += _rbt_emp_recurse(tree, other.root);
+        return sub;
+    }
+
+    other_left = _rbt_detach(node->left, other.height - 1);
+    other_right = _rbt_detach(node->right, other.height - 1);
+
+    //drop the key of the other subtree's root from both
+    found = _rbt_split(tree, sub, node->key, &left, &right);
+    if (found != NULL) {
+        _rbt_free_node(tree, found);
+        *freed += 1;
+    }
+    _rbt_free_node(tree, node);
+    *freed += 1;
+
+    left = _rbt_diff(tree, left, other_left, freed);
+    right = _rbt_diff(tree, right, other_right, freed);
+
+    return _rbt_join2(tree, left, right);
+}
+
+
+
+//order intervals by start, then by end
+DBG_STATIC 
+enum cm_rbt_side _rbt_itv_compare(const void * k_1, const void * k_2) {
+
+    const cm_rbt_itv * itv_1 = k_1, * itv_2 = k_2;
+
+    if (itv_1->start != itv_2->start) {
+        return itv_1->start > itv_2->start ? MORE : LESS;
+    }
+
+    return CM_RBT_CMP_NUM(&itv_1->end, &itv_2->end);
+}
+
+
+
+//keep the greatest end in each subtree
+DBG_STATIC 
+void _rbt_itv_aug(void * aug, const void * key, const void * data,
+                  const void * left_aug, const void * right_aug) {
+
+    uintptr_t max_end = ((const cm_rbt_itv *) key)->end;
+
+    (void) data;
+
+    if (left_aug != NULL && *(const uintptr_t *) left_aug > max_end) {
+        max_end = *(const uintptr_t *) left_aug;
+    }
+    if (right_aug != NULL && *(const uintptr_t *) right_aug > max_end) {
+        max_end = *(const uintptr_t *) right_aug;
+    }
+
+    *(uintptr_t *) aug = max_end;
+
+    return;
+}
+
+
+
+//keep the number of nodes in each subtree
+DBG_STATIC 
+void _rbt_ost_aug(void * aug, const void * key, const void * data,
+                  const void * left_aug, const void * right_aug) {
+
+    int size = 1;
+
+    (void) key;
+    (void) data;
+
+    if (left_aug != NULL) size += *(const int *) left_aug;
+    if (right_aug != NULL) size += *(const int *) right_aug;
+
+    *(int *) aug = size;
+
+    return;
+}
+
+
+
+/*
+ *  Returns the first node in key order of the subtree at node that overlaps 
+ *  the query, or NULL. Subtrees that end before the query starts are 
+ *  skipped. Once a node starts at or after the end of the query, so does 
+ *  every node after it.
+ */
+
+DBG_STATIC 
+cm_rbt_node * _rbt_itv_first_in(const cm_rbt * tree, cm_rbt_node * node,
+                                const cm_rbt_itv * query) {
+
+    const cm_rbt_itv * itv;
+
+    while (node != NULL && RBT_MAX_END(tree, node) > query->start) {
+
+        //an overlap in the left subtree comes first
+        if (node->left != NULL 
+            && RBT_MAX_END(tree, node->left) > query->start) {
+            node = node->left;
+            continue;
+        }
+
+        itv = node->key;
+        if (itv->start >= query->end) return NULL;
+        if (itv->end > query->start) return node;
+
+        //the overlap must be in the right subtree
+        node = node->right;
+    }
+
+    return NULL;
+}
+
+
+//trees must share their layout and order to exchange nodes
+DBG_STATIC 
+int _rbt_assert_compatible(const cm_rbt * tree, const cm_rbt * other) {
+
+    //nodes of arena trees can not outlive their arena, and concurrent 
+    //readers can not follow nodes that move between trees
+    if (tree == other || tree->key_sz != other->key_sz 
+        || tree->data_sz != other->data_sz || tree->compare != other->compare
+        || tree->mode != other->mode || tree->aug != other->aug 
+        || tree->aug_sz != other->aug_sz
+        || tree->mode == CM_RBT_ARENA 
+        || tree->sync != NULL || other->sync != NULL) {
+        cm_errno = CM_ERR_USER_MISMATCH;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+/*
+ *  Counts the right tree of a split of size nodes. Both trees are stepped 
+ *  through in order at once, and the walk stops when the smaller one runs 
+ *  out, so only as many nodes as the smaller tree holds are visited.
+ */
+
+DBG_STATIC 
+int _rbt_count_split(const cm_rbt * tree, const cm_rbt_node * left, 
+                     const cm_rbt_node * right, const int size) {
+
+    int count = 0;
+
+    if (right == NULL) return 0;
+    if (left == NULL) return size;
+    if (tree->aug == _rbt_ost_aug) return RBT_SUB_SIZE(tree, right);
+
+    //start from the first node of each tree
+    while (left->left != NULL) left = left->left;
+    while (right->left != NULL) right = right->left;
+
+    while (true) {
+
+        ++count;
+        left = cm_rbt_next_n(left);
+        right = cm_rbt_next_n(right);
+
+        if (left == NULL) return size - count;
+        if (right == NULL) return count;
+    }
+}
+
+
+
+//take every node out of a tree as a detached subtree
+DBG_STATIC DBG_INLINE 
+struct _rbt_sub _rbt_take(cm_rbt * tree) {
+
+    struct _rbt_sub sub = {tree->root, _rbt_black_height(tree->root)};
+
+    tree->root = NULL;
+    tree->size = 0;
+
+    return sub;
+}
+
+
+//apply a set operation to two trees, leaving the result in the first
+DBG_STATIC 
+int _rbt_combine(cm_rbt * tree, cm_rbt * other, 
+                 struct _rbt_sub (*op)(const cm_rbt * tree, 
+                                       struct _rbt_sub sub, 
+                                       struct _rbt_sub other, int * freed)) {
+
+    int size, freed = 0;
+    struct _rbt_sub sub, other_sub;
+
+    if (_rbt_assert_compatible(tree, other)) return -1;
+
+    size = tree->size + other->size;
+    sub = _rbt_take(tree);
+    other_sub = _rbt_take(other);
+
+    sub = op(tree, sub, other_sub, &freed);
+    tree->root = sub.root;
+    tree->size = size - freed;
+
+    return 0;
+}
+
+
+
+//serialise a writer and make readers retry until it is done
+DBG_STATIC
+void _rbt_write_lock(struct _cm_rbt_sync * sync) {
+
+    pthread_mutex_lock(&sync->lock);
+
+    //the odd sequence must be visible before any change to the tree
+    __atomic_store_n(&sync->seq, sync->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+DBG_STATIC
+void _rbt_write_unlock(struct _cm_rbt_sync * sync) {
+
+    __atomic_store_n(&sync->seq, sync->seq + 1, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&sync->lock);
+
+    return;
+}
+
+
+
+//wait out a writer and return the sequence a read starts at
+DBG_STATIC DBG_INLINE
+unsigned long _rbt_read_begin(const struct _cm_rbt_sync * sync) {
+
+    unsigned long seq;
+
+    while ((seq = __atomic_load_n(&sync->seq, __ATOMIC_ACQUIRE)) & 1) {
+        sched_yield();
+    }
+
+    return seq;
+}
+
+
+
+//true if no writer ran since the read began
+DBG_STATIC DBG_INLINE
+bool _rbt_read_valid(const struct _cm_rbt_sync * sync, 
+                     const unsigned long seq) {
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return __atomic_load_n(&sync->seq, __ATOMIC_RELAXED) == seq;
+}
+
+
+
+/*
+ *  Looks a key up while a writer may be changing the tree, copying its data 
+ *  to buf if found. The result is only meaningful if the read is still 
+ *  valid afterwards. A rotation seen halfway can lead a reader in circles, 
+ *  so the depth of the search is bounded.
+ */
+
+DBG_STATIC
+bool _rbt_sync_find(const cm_rbt * tree, const void * key, void * buf) {
+
+    enum cm_rbt_side side;
+    cm_rbt_node * node = __atomic_load_n(&tree->root, __ATOMIC_ACQUIRE);
+
+    for (int depth = 0; node != NULL && depth < RBT_SYNC_MAX_DEPTH; ++depth) {
+
+        side = tree->compare(key, node->key);
+        if (side == EQUAL) {
+            memcpy(buf, node->data, tree->data_sz);
+            return true;
+        }
+
+        node = side == LESS ? __atomic_load_n(&node->left, __ATOMIC_ACQUIRE)
+                            : __atomic_load_n(&node->right, __ATOMIC_ACQUIRE);
+    }
+
+    return false;
+}
+
+
+
+//concurrent trees may only be modified through the _sync functions
+DBG_STATIC DBG_INLINE 
+int _rbt_assert_unsync(const cm_rbt * tree) {
+
+    if (tree->sync != NULL) {
+        cm_errno = CM_ERR_USER_MISMATCH;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+//cm_rbt_set() without the concurrent tree check, for cm_rbt_set_sync()
+DBG_STATIC 
+cm_rbt_node * _rbt_set(cm_rbt * tree, const void * key, const void * data) {
+
+    enum cm_rbt_side side;
+
+    //get relevant node
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+
+    //if a node already exists for this key, update its value
+    if (side == EQUAL) {
+        memcpy(node->data, data, tree->data_sz);
+        if (tree->aug != NULL) _rbt_aug_path(tree, node);
+        return node;
+
+    //else create a new node
+    } else { 
+        return _rbt_add_node(tree, key, data, node, side);
+    }
+}
+
+
+
+//cm_rbt_uln() without the concurrent tree check, for cm_rbt_rem_sync()
+DBG_STATIC 
+cm_rbt_node * _rbt_uln(cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+
+    //get relevant node
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+    if (side != EQUAL) {
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    node = _rbt_uln_node(tree, node);
+    if (node == NULL) return NULL;
+
+    //null out pointers
+    RBT_SET_PARENT(node, NULL);
+    node->left = node->right = NULL;
+
+    return node;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_rbt_get(const cm_rbt * tree, const void * key, void * buf) {
+
+    enum cm_rbt_side side;
+
+    //get the node
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+    if (side != EQUAL) {
+        
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    memcpy(buf, node->data, tree->data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_rbt_get_p(const cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+
+    //get the node
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+    if (side != EQUAL) {
+    
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    return node->data;
+}
+
+
+
+cm_rbt_node * cm_rbt_get_n(const cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+
+    //get the node
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+    if (side != EQUAL) {
+        
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    return node;
+}
+
+
+
+cm_rbt_node * cm_rbt_get_hint(const cm_rbt * tree, 
+                              cm_rbt_node * hint, const void * key) {
+
+    enum cm_rbt_side side;
+
+    //get the node, searching outwards from the hint
+    cm_rbt_node * node = _rbt_traverse_from(tree, hint, key, &side);
+    if (side != EQUAL) {
+        
+        cm_errno = CM_ERR_USER_KEY;
+        return NULL;
+    }
+
+    return node;
+}
+
+
+
+cm_rbt_node * cm_rbt_first_n(const cm_rbt * tree) {
+
+    cm_rbt_node * node = tree->root;
+    if (node == NULL) return NULL;
+
+    while (node->left != NULL) node = node->left;
+
+    return node;
+}
+
+
+
+cm_rbt_node * cm_rbt_last_n(const cm_rbt * tree) {
+
+    cm_rbt_node * node = tree->root;
+    if (node == NULL) return NULL;
+
+    while (node->right != NULL) node = node->right;
+
+    return node;
+}
+
+
+
+cm_rbt_node * cm_rbt_next_n(const cm_rbt_node * node) {
+
+    //successor is the minimum of the right subtree
+    if (node->right != NULL) {
+        node = node->right;
+        while (node->left != NULL) node = node->left;
+        return (cm_rbt_node *) node;
+    }
+
+    //otherwise it is the first ancestor reached from its left subtree
+    while (cm_rbt_parent_side(node) == MORE) node = cm_rbt_parent(node);
+
+    return cm_rbt_parent_side(node) == ROOT ? NULL : cm_rbt_parent(node);
+}
+
+
+
+cm_rbt_node * cm_rbt_prev_n(const cm_rbt_node * node) {
+
+    //predecessor is the maximum of the left subtree
+    if (node->left != NULL) {
+        node = node->left;
+        while (node->right != NULL) node = node->right;
+        return (cm_rbt_node *) node;
+    }
+
+    //otherwise it is the first ancestor reached from its right subtree
+    while (cm_rbt_parent_side(node) == LESS) node = cm_rbt_parent(node);
+
+    return cm_rbt_parent_side(node) == ROOT ? NULL : cm_rbt_parent(node);
+}
+
+
+
+/*
+ *  On a miss, _rbt_traverse() stops at the node the key would be attached 
+ *  to. That node is the key's neighbour on the side it was attached, so 
+ *  its other neighbour is one step away.
+ */
+
+cm_rbt_node * cm_rbt_floor(const cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+
+    if (node != NULL && side == LESS) node = cm_rbt_prev_n(node);
+    if (node == NULL) cm_errno = CM_ERR_USER_KEY;
+
+    return node;
+}
+
+
+
+cm_rbt_node * cm_rbt_ceil(const cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+
+    if (node != NULL && side == MORE) node = cm_rbt_next_n(node);
+    if (node == NULL) cm_errno = CM_ERR_USER_KEY;
+
+    return node;
+}
+
+
+
+cm_rbt_node * cm_rbt_next(const cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+
+    if (node != NULL && side != LESS) node = cm_rbt_next_n(node);
+    if (node == NULL) cm_errno = CM_ERR_USER_KEY;
+
+    return node;
+}
+
+
+
+cm_rbt_node * cm_rbt_prev(const cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+
+    if (node != NULL && side != MORE) node = cm_rbt_prev_n(node);
+    if (node == NULL) cm_errno = CM_ERR_USER_KEY;
+
+    return node;
+}
+
+
+
+/*
+ *  Returns the number of keys less than key, which need not be present.
+ */
+
+int cm_rbt_rank(const cm_rbt * tree, const void * key) {
+
+    int rank = 0;
+    enum cm_rbt_side side;
+    cm_rbt_node * node = tree->root;
+
+    if (tree->aug != _rbt_ost_aug) {
+        cm_errno = CM_ERR_USER_MISMATCH;
+        return -1;
+    }
+
+    //count every node left of the path to the key
+    while (node != NULL) {
+
+        side = tree->compare(key, node->key);
+        if (side == LESS) {
+            node = node->left;
+            continue;
+        }
+
+        if (node->left != NULL) rank += RBT_SUB_SIZE(tree, node->left);
+        if (side == EQUAL) break;
+
+        rank += 1;
+        node = node->right;
+    }
+
+    return rank;
+}
+
+
+
+cm_rbt_node * cm_rbt_select(const cm_rbt * tree, int index) {
+
+    int left_size;
+    cm_rbt_node * node = tree->root;
+
+    if (tree->aug != _rbt_ost_aug) {
+        cm_errno = CM_ERR_USER_MISMATCH;
+        return NULL;
+    }
+
+    //negative indeces count from the greatest key
+    if (index < 0) index += tree->size;
+    if (index < 0 || index >= tree->size) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return NULL;
+    }
+
+    //descend towards the node with index smaller nodes
+    while (true) {
+
+        left_size = node->left == NULL ? 0 : RBT_SUB_SIZE(tree, node->left);
+
+        if (index == left_size) return node;
+
+        if (index < left_size) {
+            node = node->left;
+        } else {
+            index -= left_size + 1;
+            node = node->right;
+        }
+    }
+}
+
+
+
+cm_rbt_node * cm_rbt_itv_first(const cm_rbt * tree, 
+                               const cm_rbt_itv * query) {
+
+    return _rbt_itv_first_in(tree, tree->root, query);
+}
+
+
+
+cm_rbt_node * cm_rbt_itv_next(const cm_rbt * tree, const cm_rbt_node * node,
+                              const cm_rbt_itv * query) {
+
+    cm_rbt_node * next_node;
+    const cm_rbt_itv * itv;
+
+    //overlaps in the right subtree come first
+    next_node = _rbt_itv_first_in(tree, node->right, query);
+    if (next_node != NULL) return next_node;
+
+    //otherwise climb to each later ancestor in turn
+    while (true) {
+
+        while (cm_rbt_parent_side(node) == MORE) node = cm_rbt_parent(node);
+        if (cm_rbt_parent_side(node) == ROOT) return NULL;
+        node = cm_rbt_parent(node);
+
+        itv = node->key;
+        if (itv->start >= query->end) return NULL;
+        if (itv->end > query->start) return (cm_rbt_node *) node;
+
+        next_node = _rbt_itv_first_in(tree, node->right, query);
+        if (next_node != NULL) return next_node;
+    }
+}
+
+
+
+cm_rbt_node * cm_rbt_set(cm_rbt * tree,
+                         const void * key, const void * data) {
+
+    if (_rbt_assert_unsync(tree)) return NULL;
+
+    return _rbt_set(tree, key, data);
+}
+
+
+
+cm_rbt_node * cm_rbt_set_hint(cm_rbt * tree, cm_rbt_node * hint,
+                              const void * key, const void * data) {
+
+    enum cm_rbt_side side;
+
+    if (_rbt_assert_unsync(tree)) return NULL;
+
+    //get relevant node, searching outwards from the hint
+    cm_rbt_node * node = _rbt_traverse_from(tree, hint, key, &side);
+
+    //if a node already exists for this key, update its value
+    if (side == EQUAL) {
+        memcpy(node->data, data, tree->data_sz);
+        if (tree->aug != NULL) _rbt_aug_path(tree, node);
+        return node;
+
+    //else create a new node
+    } else { 
+        return _rbt_add_node(tree, key, data, node, side);
+    }
+}
+
+
+
+void * cm_rbt_set_slot(cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+
+    if (_rbt_assert_unsync(tree)) return NULL;
+
+    //get relevant node
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+
+    //if a node already exists for this key, hand out its data
+    if (side == EQUAL) return node->data;
+
+    //else create a new node without copying any data into it
+    node = _rbt_add_node(tree, key, NULL, node, side);
+    if (node == NULL) return NULL;
+
+    return node->data;
+}
+
+
+
+cm_rbt_node * cm_rbt_ins_at(cm_rbt * tree, cm_rbt_node * parent, 
+                            const enum cm_rbt_side side, 
+                            const void * key, const void * data) {
+
+    if (_rbt_assert_unsync(tree)) return NULL;
+
+    //the key must not already be present
+    if (side == EQUAL) {
+        cm_errno = CM_ERR_USER_DUPLICATE;
+        return NULL;
+    }
+
+    return _rbt_add_node(tree, key, data, parent, side);
+}
+
+
+
+int cm_rbt_rem(cm_rbt * tree, const void * key) {
+
+    enum cm_rbt_side side;
+
+    if (_rbt_assert_unsync(tree)) return -1;
+
+    //get relevant node
+    cm_rbt_node * node = _rbt_traverse(tree, key, &side);
+    if (side != EQUAL) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    return cm_rbt_rem_n(tree, node);
+}
+
+
+
+int cm_rbt_rem_n(cm_rbt * tree, cm_rbt_node * node) {
+
+    if (_rbt_assert_unsync(tree)) return -1;
+
+    node = _rbt_uln_node(tree, node);
+    if (node == NULL) return -1;
+
+    _rbt_free_node(tree, node);
+
+    return 0;
+}
+
+
+
+/*
+ *  Removes every key in [lo, hi) and returns how many were removed. The 
+ *  range is split out of the tree, freed, and the rest joined back, so 
+ *  removing k keys costs O(log n + k) rather than k removals.
+ */
+
+int cm_rbt_rem_range(cm_rbt * tree, const void * lo, const void * hi) {
+
+    int size, freed;
+    struct _rbt_sub sub, left, range, right;
+
+    if (_rbt_assert_unsync(tree)) return -1;
+
+    if (tree->size == 0 || tree->compare(hi, lo) != MORE) return 0;
+
+    size = tree->size;
+    sub = _rbt_take(tree);
+
+    _rbt_split_from(tree, sub, lo, &left, &range);
+    _rbt_split_from(tree, range, hi, &range, &right);
+    freed = _rbt_emp_recurse(tree, range.root);
+
+    sub = _rbt_join2(tree, left, right);
+    tree->root = sub.root;
+    tree->size = size - freed;
+
+    return freed;
+}
+
+
+
+cm_rbt_node * cm_rbt_uln(cm_rbt * tree, const void * key) {
+
+    if (_rbt_assert_unsync(tree)) return NULL;
+
+    return _rbt_uln(tree, key);
+}
+
+
+
+void cm_rbt_upd_n(cm_rbt * tree, cm_rbt_node * node) {
+
+    if (tree->aug != NULL) _rbt_aug_path(tree, node);
+
+    return;
+}
+
+
+
+cm_rbt_node * cm_rbt_uln_n(cm_rbt * tree, cm_rbt_node * node) {
+
+    if (_rbt_assert_unsync(tree)) return NULL;
+
+    node = _rbt_uln_node(tree, node);
+    if (node == NULL) return NULL;
+
+    //null out pointers
+    RBT_SET_PARENT(node, NULL);
+    node->left = node->right = NULL;
+
+    return node;
+}
+
+
+
+/*
+ *  Replaces the contents of a tree with n keys in strictly increasing
+ *  order, in linear time. Splitting the keys at their middle yields a tree
+ *  in which every level but the deepest is full, so colouring only the
+ *  deepest level red satisfies every red-black property without rotations.
+ */
+
+int cm_rbt_from_sorted(cm_rbt * tree, const void * keys, 
+                       const void * datas, const int n) {
+
+    int ret, red_depth = 0;
+    const cm_byte * key_bytes = keys;
+
+    if (_rbt_assert_unsync(tree)) return -1;
+
+    //check the order first, so a rejected input leaves nothing allocated
+    for (int i = 1; i < n; ++i) {
+        if (tree->compare(key_bytes + (tree->key_sz * i), 
+                          key_bytes + (tree->key_sz * (i - 1))) != MORE) {
+            cm_errno = CM_ERR_USER_ORDER;
+            return -1;
+        }
+    }
+
+    cm_rbt_emp(tree);
+    if (n <= 0) return 0;
+
+    //arena trees take every node from a single chunk
+    if (tree->mode == CM_RBT_ARENA) {
+        ret = _arn_reserve(tree->arn, n);
+        if (ret == -1) return -1;
+    }
+
+    //the deepest level of the tree, a lone root stays black
+    while ((2 << red_depth) <= n) ++red_depth;
+    if (red_depth == 0) red_depth = -1;
+
+    ret = _rbt_build(tree, key_bytes, datas, 0, n, 0, red_depth, NULL, ROOT);
+    if (ret == -1) {
+        cm_rbt_emp(tree);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/*
+ *  Moves every key greater than or equal to key into right, after freeing 
+ *  the contents of right. Nodes are moved rather than copied, and both 
+ *  trees are rebalanced in O(log n). Counting the nodes moved takes time 
+ *  proportional to the size of the smaller tree, unless the trees are 
+ *  order statistic trees.
+ */
+
+int cm_rbt_split(cm_rbt * tree, const void * key, cm_rbt * right) {
+
+    int size;
+    struct _rbt_sub sub, left_sub, right_sub;
+
+    if (_rbt_assert_compatible(tree, right)) return -1;
+
+    cm_rbt_emp(right);
+    size = tree->size;
+    sub = _rbt_take(tree);
+
+    _rbt_split_from(tree, sub, key, &left_sub, &right_sub);
+
+    right->root = right_sub.root;
+    right->size = _rbt_count_split(tree, left_sub.root, right_sub.root, size);
+    tree->root = left_sub.root;
+    tree->size = size - right->size;
+
+    return 0;
+}
+
+
+
+/*
+ *  Moves every node of other, whose keys must all be greater than the keys 
+ *  of tree, to the end of tree in O(log n).
+ */
+
+int cm_rbt_join(cm_rbt * tree, cm_rbt * other) {
+
+    int size;
+    struct _rbt_sub sub, other_sub;
+
+    if (_rbt_assert_compatible(tree, other)) return -1;
+
+    if (tree->size != 0 && other->size != 0
+        && tree->compare(cm_rbt_first_n(other)->key, 
+                         cm_rbt_last_n(tree)->key) != MORE) {
+        cm_errno = CM_ERR_USER_ORDER;
+        return -1;
+    }
+
+    size = tree->size + other->size;
+    sub = _rbt_take(tree);
+    other_sub = _rbt_take(other);
+
+    sub = _rbt_join2(tree, sub, other_sub);
+    tree->root = sub.root;
+    tree->size = size;
+
+    return 0;
+}
+
+
+
+/*
+ *  Set operations leave their result in tree and empty other. Nodes of the 
+ *  result are moved rather than copied, and a key present in both trees 
+ *  keeps the data of tree. For trees of m and n keys where m <= n, each 
+ *  takes O(m log(n/m + 1)) time.
+ */
+
+int cm_rbt_union(cm_rbt * tree, cm_rbt * other) {
+
+    return _rbt_combine(tree, other, _rbt_union);
+}
+
+
+
+int cm_rbt_intersect(cm_rbt * tree, cm_rbt * other) {
+
+    return _rbt_combine(tree, other, _rbt_intersect);
+}
+
+
+
+int cm_rbt_diff(cm_rbt * tree, cm_rbt * other) {
+
+    return _rbt_combine(tree, other, _rbt_diff);
+}
+
+
+
+void cm_rbt_emp(cm_rbt * tree) {
+
+    if (_rbt_assert_unsync(tree)) return;
+
+    //arena trees free their chunks instead of each node
+    if (tree->mode == CM_RBT_ARENA) {
+        _arn_emp(tree->arn);
+    } else {
+        _rbt_emp_recurse(tree, tree->root);
+    }
+    tree->root = NULL;
+    tree->size = 0;
+
+    return;
+}
+
+
+
+int cm_rbt_get_sync(const cm_rbt * tree, const void * key, void * buf) {
+
+    bool found;
+    unsigned long seq;
+    _ebr_slot * slot;
+
+    //retired nodes are not freed while this thread may still read them
+    slot = _ebr_enter(tree->sync->ebr);
+    if (!slot) return -1;
+
+    //retry until no writer changed the tree during the lookup
+    do {
+        seq = _rbt_read_begin(tree->sync);
+        found = _rbt_sync_find(tree, key, buf);
+    } while (!_rbt_read_valid(tree->sync, seq));
+
+    _ebr_exit(slot);
+
+    if (!found) {
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+int cm_rbt_set_sync(cm_rbt * tree, const void * key, const void * data) {
+
+    cm_rbt_node * node;
+
+    _rbt_write_lock(tree->sync);
+    node = _rbt_set(tree, key, data);
+    _rbt_write_unlock(tree->sync);
+
+    return node == NULL ? -1 : 0;
+}
+
+
+
+int cm_rbt_rem_sync(cm_rbt * tree, const void * key) {
+
+    cm_rbt_node * node;
+    _ebr_slot * slot;
+
+    slot = _ebr_enter(tree->sync->ebr);
+    if (!slot) return -1;
+
+    _rbt_write_lock(tree->sync);
+    node = _rbt_uln(tree, key);
+    _rbt_write_unlock(tree->sync);
+
+    if (node == NULL) {
+        _ebr_exit(slot);
+        return -1;
+    }
+
+    //other threads may still be reading the node
+    _ebr_retire(tree->sync->ebr, slot, node);
+    _ebr_exit(slot);
+
+    return 0;
+}
+
+
+
+void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz, 
+                enum cm_rbt_side (*compare) (const void *, const void *)) {
+
+    tree->size      = 0;
+    tree->key_sz  = key_sz;
+    tree->data_sz = data_sz;
+    tree->root      = NULL;
+    tree->compare   = compare;
+    tree->mode      = CM_RBT_SEPARATE;
+    tree->arn       = NULL;
+    tree->aug_sz    = 0;
+    tree->aug_off   = ARN_ROUND(key_sz) + data_sz;
+    tree->aug       = NULL;
+    tree->sync      = NULL;
+
+    return;
+}
+
+
+
+void cm_new_rbt_inl(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare) (const void *, const void *)) {
+
+    cm_new_rbt(tree, key_sz, data_sz, compare);
+    tree->mode = CM_RBT_INLINE;
+
+    return;
+}
+
+
+
+void cm_new_rbt_aug(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare) (const void *, const void *),
+                    const size_t aug_sz,
+                    void (*aug)(void * aug, const void * key, 
+                                const void * data, const void * left_aug, 
+                                const void * right_aug)) {
+
+    cm_new_rbt_inl(tree, key_sz, data_sz, compare);
+
+    //the aggregate follows the data of each node
+    tree->aug_sz  = aug_sz;
+    tree->aug_off = ARN_ROUND(ARN_ROUND(key_sz) + data_sz);
+    tree->aug     = aug;
+
+    return;
+}
+
+
+
+void cm_new_rbt_ost(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare) (const void *, const void *)) {
+
+    cm_new_rbt_aug(tree, key_sz, data_sz, compare, sizeof(int), _rbt_ost_aug);
+
+    return;
+}
+
+
+
+void cm_new_rbt_itv(cm_rbt * tree, const size_t data_sz) {
+
+    cm_new_rbt_aug(tree, sizeof(cm_rbt_itv), data_sz, _rbt_itv_compare, 
+                   sizeof(uintptr_t), _rbt_itv_aug);
+
+    return;
+}
+
+
+
+int cm_new_rbt_arn(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                   enum cm_rbt_side (*compare) (const void *, const void *)) {
+
+    cm_new_rbt(tree, key_sz, data_sz, compare);
+
+    //each object holds a node followed by its key and data
+    tree->arn = _arn_new(sizeof(cm_rbt_node) + ARN_ROUND(key_sz) + data_sz);
+    if (!tree->arn) return -1;
+
+    tree->mode = CM_RBT_ARENA;
+
+    return 0;
+}
+
+
+
+/*
+ *  Nodes are allocated inline, so that the node, key and data of a retired 
+ *  node are freed together. The parent bits of a node are only read by 
+ *  writers, so they chain the node once retired.
+ */
+
+int cm_new_rbt_sync(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare) (const void *, const void *)) {
+
+    struct _cm_rbt_sync * sync;
+
+    cm_new_rbt_inl(tree, key_sz, data_sz, compare);
+
+    sync = aligned_alloc(EBR_CACHE_LINE, sizeof(struct _cm_rbt_sync));
+    if (!sync) {
+        cm_errno = CM_ERR_MALLOC;
+        return -1;
+    }
+
+    sync->ebr = _ebr_new(offsetof(cm_rbt_node, parent_bits));
+    if (!sync->ebr) {
+        free(sync);
+        return -1;
+    }
+
+    sync->seq = 0;
+    pthread_mutex_init(&sync->lock, NULL);
+    tree->sync = sync;
+
+    return 0;
+}
+
+
+
+void cm_del_rbt(cm_rbt * tree) {
+
+    //arena trees free their chunks instead of each node
+    if (tree->mode == CM_RBT_ARENA) {
+        _arn_del(tree->arn);
+        tree->arn = NULL;
+    } else {
+        _rbt_emp_recurse(tree, tree->root);
+    }
+    tree->root = NULL;
+    tree->size = 0;
+
+    //concurrent trees also free the nodes retired by removals
+    if (tree->sync != NULL) {
+        _ebr_del(tree->sync->ebr);
+        pthread_mutex_destroy(&tree->sync->lock);
+        free(tree->sync);
+        tree->sync = NULL;
+    }
+
+    return;
+}
+
+
+
+void cm_del_rbt_node(cm_rbt_node * node) {
+
+    _rbt_del_node(node);
+
+    return;
+}
+
+
+
+enum cm_rbt_side cm_rbt_cmp_int(const void * k_1, const void * k_2) {
+
+    return CM_RBT_CMP_NUM((const int *) k_1, (const int *) k_2);
+}
+
+
+
+enum cm_rbt_side cm_rbt_cmp_uptr(const void * k_1, const void * k_2) {
+
+    return CM_RBT_CMP_NUM((const uintptr_t *) k_1, (const uintptr_t *) k_2);
 }
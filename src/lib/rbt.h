@@ -1,12 +1,17 @@
 #ifndef RBT_H
 #define RBT_H
 
+//standard library
+#include <stdint.h>
+
 //system headers
 #include <unistd.h>
+#include <pthread.h>
 
 //local headers
 #include "cmore.h"
 #include "debug.h"
+#include "ebr.h"
 
 
 //stores pointers to nodes relevant for correction operations
@@ -19,20 +24,75 @@ struct _rbt_fix_data {
 };
 
 
+//a detached subtree with a black root, and its black height
+struct _rbt_sub {
+
+    cm_rbt_node * root;
+    int height;
+};
+
+
+//deepest path a concurrent lookup follows before it must have seen a write
+#define RBT_SYNC_MAX_DEPTH 128
+
+
+/*
+ *  Concurrent trees are guarded by a sequence lock. Writers hold the 
+ *  mutex and keep the sequence odd while they modify the tree. Readers 
+ *  take no locks, and retry a lookup if the sequence changed while they 
+ *  ran. Unlinked nodes are retired rather than freed, so readers never 
+ *  follow a pointer into freed memory.
+ */
+
+struct _cm_rbt_sync {
+
+    unsigned long seq;
+    struct _cm_ebr * ebr;
+
+    //written only by writers, so kept off the line readers poll
+    pthread_mutex_t lock __attribute__((aligned(EBR_CACHE_LINE)));
+};
+
+
+//set the parent, parent side & colour of a node, leaving the other two
+#define RBT_SET_PARENT(node, parent) \
+    ((node)->parent_bits = ((node)->parent_bits & 7) | (uintptr_t) (parent))
+#define RBT_SET_SIDE(node, side) \
+    ((node)->parent_bits = ((node)->parent_bits & ~(uintptr_t) 3) \
+                           | (uintptr_t) (side))
+#define RBT_SET_COLOUR(node, colour) \
+    ((node)->parent_bits = ((node)->parent_bits & ~(uintptr_t) 4) \
+                           | ((uintptr_t) (colour) << 2))
+
+//get the greatest end in the subtree of an interval tree node
+#define RBT_MAX_END(tree, node) (*(uintptr_t *) cm_rbt_aug(tree, node))
+
+//get the number of nodes in the subtree of an order statistic tree node
+#define RBT_SUB_SIZE(tree, node) (*(int *) cm_rbt_aug(tree, node))
+
+
 #ifdef DEBUG
 //internal
+cm_rbt_node * _rbt_descend(const cm_rbt * tree, cm_rbt_node * node,
+                           const void * key, enum cm_rbt_side * side);
 cm_rbt_node * _rbt_traverse(const cm_rbt * tree, 
                             const void * key, enum cm_rbt_side * side);
+cm_rbt_node * _rbt_traverse_from(const cm_rbt * tree, cm_rbt_node * hint,
+                                 const void * key, enum cm_rbt_side * side);
 
 cm_rbt_node * _rbt_new_node(const cm_rbt * tree, 
                             const void * key, const void * data);
 void _rbt_del_node(cm_rbt_node * node);
+void _rbt_free_node(const cm_rbt * tree, cm_rbt_node * node);
 
 void _rbt_left_rotate(cm_rbt * tree, cm_rbt_node * node);
 void _rbt_right_rotate(cm_rbt * tree, cm_rbt_node * node);
 void _rbt_transplant(cm_rbt * tree, 
                      cm_rbt_node * subj_node, cm_rbt_node * tgt_node);
 
+void _rbt_aug_node(const cm_rbt * tree, cm_rbt_node * node);
+void _rbt_aug_path(const cm_rbt * tree, cm_rbt_node * node);
+
 cm_rbt_node * _rbt_left_max(cm_rbt_node * node);
 enum cm_rbt_colour _rbt_get_colour(const cm_rbt_node * node);
 
@@ -69,9 +129,62 @@ int _rbt_fix_rem(cm_rbt * tree, cm_rbt_node * node,
 cm_rbt_node * _rbt_add_node(cm_rbt * tree, const void * key, 
                             const void * data, cm_rbt_node * parent, 
                             const enum cm_rbt_side side);
-cm_rbt_node * _rbt_uln_node(cm_rbt * tree, const void * key);
+cm_rbt_node * _rbt_uln_node(cm_rbt * tree, cm_rbt_node * node);
+
+int _rbt_build(cm_rbt * tree, const cm_byte * keys, const cm_byte * datas,
+               const int lo, const int hi, const int depth, 
+               const int red_depth, cm_rbt_node * parent, 
+               const enum cm_rbt_side side);
+int _rbt_emp_recurse(const cm_rbt * tree, cm_rbt_node * node);
+
+int _rbt_black_height(const cm_rbt_node * node);
+struct _rbt_sub _rbt_detach(cm_rbt_node * node, const int height);
+void _rbt_adopt(cm_rbt_node * node);
+struct _rbt_sub _rbt_join3(const cm_rbt * tree, struct _rbt_sub left, 
+                           cm_rbt_node * mid, struct _rbt_sub right);
+cm_rbt_node * _rbt_split_last(const cm_rbt * tree, struct _rbt_sub sub, 
+                              struct _rbt_sub * rest);
+struct _rbt_sub _rbt_join2(const cm_rbt * tree, 
+                           struct _rbt_sub left, struct _rbt_sub right);
+cm_rbt_node * _rbt_split(const cm_rbt * tree, struct _rbt_sub sub, 
+                         const void * key, struct _rbt_sub * left, 
+                         struct _rbt_sub * right);
+void _rbt_split_from(const cm_rbt * tree, struct _rbt_sub sub, 
+                     const void * key, struct _rbt_sub * left, 
+                     struct _rbt_sub * right);
+struct _rbt_sub _rbt_union(const cm_rbt * tree, struct _rbt_sub sub, 
+                           struct _rbt_sub other, int * freed);
+struct _rbt_sub _rbt_intersect(const cm_rbt * tree, struct _rbt_sub sub, 
+                               struct _rbt_sub other, int * freed);
+struct _rbt_sub _rbt_diff(const cm_rbt * tree, struct _rbt_sub sub, 
+                          struct _rbt_sub other, int * freed);
+
+void _rbt_write_lock(struct _cm_rbt_sync * sync);
+void _rbt_write_unlock(struct _cm_rbt_sync * sync);
+unsigned long _rbt_read_begin(const struct _cm_rbt_sync * sync);
+bool _rbt_read_valid(const struct _cm_rbt_sync * sync, 
+                     const unsigned long seq);
+bool _rbt_sync_find(const cm_rbt * tree, const void * key, void * buf);
+int _rbt_assert_unsync(const cm_rbt * tree);
+cm_rbt_node * _rbt_set(cm_rbt * tree, const void * key, const void * data);
+cm_rbt_node * _rbt_uln(cm_rbt * tree, const void * key);
+
+enum cm_rbt_side _rbt_itv_compare(const void * k_1, const void * k_2);
+void _rbt_itv_aug(void * aug, const void * key, const void * data,
+                  const void * left_aug, const void * right_aug);
+void _rbt_ost_aug(void * aug, const void * key, const void * data,
+                  const void * left_aug, const void * right_aug);
+cm_rbt_node * _rbt_itv_first_in(const cm_rbt * tree, cm_rbt_node * node,
+                                const cm_rbt_itv * query);
 
-void _rbt_emp_recurse(cm_rbt_node * node);
+int _rbt_assert_compatible(const cm_rbt * tree, const cm_rbt * other);
+int _rbt_count_split(const cm_rbt * tree, const cm_rbt_node * left, 
+                     const cm_rbt_node * right, const int size);
+struct _rbt_sub _rbt_take(cm_rbt * tree);
+int _rbt_combine(cm_rbt * tree, cm_rbt * other, 
+                 struct _rbt_sub (*op)(const cm_rbt * tree, 
+                                       struct _rbt_sub sub, 
+                                       struct _rbt_sub other, int * freed));
 #endif
 
 
@@ -79,16 +192,74 @@ void _rbt_emp_recurse(cm_rbt_node * node);
 int cm_rbt_get(const cm_rbt * tree, const void * key, void * buf);
 void * cm_rbt_get_p(const cm_rbt * tree, const void * key);
 cm_rbt_node * cm_rbt_get_n(const cm_rbt * tree, const void * key);
+cm_rbt_node * cm_rbt_get_hint(const cm_rbt * tree, 
+                              cm_rbt_node * hint, const void * key);
+
+cm_rbt_node * cm_rbt_first_n(const cm_rbt * tree);
+cm_rbt_node * cm_rbt_last_n(const cm_rbt * tree);
+cm_rbt_node * cm_rbt_next_n(const cm_rbt_node * node);
+cm_rbt_node * cm_rbt_prev_n(const cm_rbt_node * node);
+
+cm_rbt_node * cm_rbt_floor(const cm_rbt * tree, const void * key);
+cm_rbt_node * cm_rbt_ceil(const cm_rbt * tree, const void * key);
+cm_rbt_node * cm_rbt_next(const cm_rbt * tree, const void * key);
+cm_rbt_node * cm_rbt_prev(const cm_rbt * tree, const void * key);
+
+int cm_rbt_rank(const cm_rbt * tree, const void * key);
+cm_rbt_node * cm_rbt_select(const cm_rbt * tree, int index);
+
+cm_rbt_node * cm_rbt_itv_first(const cm_rbt * tree, const cm_rbt_itv * query);
+cm_rbt_node * cm_rbt_itv_next(const cm_rbt * tree, const cm_rbt_node * node,
+                              const cm_rbt_itv * query);
 
 cm_rbt_node * cm_rbt_set(cm_rbt * tree, 
                          const void * key, const void * data);
+cm_rbt_node * cm_rbt_set_hint(cm_rbt * tree, cm_rbt_node * hint,
+                              const void * key, const void * data);
+void * cm_rbt_set_slot(cm_rbt * tree, const void * key);
+cm_rbt_node * cm_rbt_ins_at(cm_rbt * tree, cm_rbt_node * parent, 
+                            const enum cm_rbt_side side, 
+                            const void * key, const void * data);
 int cm_rbt_rem(cm_rbt * tree, const void * key);
+int cm_rbt_rem_n(cm_rbt * tree, cm_rbt_node * node);
+int cm_rbt_rem_range(cm_rbt * tree, const void * lo, const void * hi);
 cm_rbt_node * cm_rbt_uln(cm_rbt * tree, const void * key);
+cm_rbt_node * cm_rbt_uln_n(cm_rbt * tree, cm_rbt_node * node);
+void cm_rbt_upd_n(cm_rbt * tree, cm_rbt_node * node);
+int cm_rbt_from_sorted(cm_rbt * tree, const void * keys, 
+                       const void * datas, const int n);
+int cm_rbt_split(cm_rbt * tree, const void * key, cm_rbt * right);
+int cm_rbt_join(cm_rbt * tree, cm_rbt * other);
+int cm_rbt_union(cm_rbt * tree, cm_rbt * other);
+int cm_rbt_intersect(cm_rbt * tree, cm_rbt * other);
+int cm_rbt_diff(cm_rbt * tree, cm_rbt * other);
 void cm_rbt_emp(cm_rbt * tree);
 
+int cm_rbt_get_sync(const cm_rbt * tree, const void * key, void * buf);
+int cm_rbt_set_sync(cm_rbt * tree, const void * key, const void * data);
+int cm_rbt_rem_sync(cm_rbt * tree, const void * key);
+
 void cm_new_rbt(cm_rbt * tree, const size_t key_sz, const size_t data_sz, 
                 enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_new_rbt_inl(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_new_rbt_itv(cm_rbt * tree, const size_t data_sz);
+void cm_new_rbt_aug(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare)(const void *, const void *),
+                    const size_t aug_sz,
+                    void (*aug)(void * aug, const void * key, 
+                                const void * data, const void * left_aug, 
+                                const void * right_aug));
+void cm_new_rbt_ost(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare)(const void *, const void *));
+int cm_new_rbt_arn(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                   enum cm_rbt_side (*compare)(const void *, const void *));
+int cm_new_rbt_sync(cm_rbt * tree, const size_t key_sz, const size_t data_sz,
+                    enum cm_rbt_side (*compare)(const void *, const void *));
 void cm_del_rbt(cm_rbt * tree);
 void cm_del_rbt_node(cm_rbt_node * node);
 
+enum cm_rbt_side cm_rbt_cmp_int(const void * k_1, const void * k_2);
+enum cm_rbt_side cm_rbt_cmp_uptr(const void * k_1, const void * k_2);
+
 #endif
@@ -0,0 +1,468 @@
+//standard library
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+#include <sched.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "skl.h"
+#include "ebr.h"
+#include "arn.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+/*
+ *  The skip list is a lazy skip list. A removed node is first marked, and
+ *  only then unlinked from each level. Insertions and removals lock the
+ *  predecessors of the affected key, and validate that they were not
+ *  changed by another thread before linking or unlinking. Lookups take no
+ *  locks, and only report nodes that are linked and not marked.
+ *
+ *  Locks are always taken from the bottom level up, so from the highest
+ *  key down. Threads can therefore not deadlock.
+ */
+
+static __thread unsigned int _skl_seed;
+
+
+
+DBG_STATIC
+int _skl_random_height() {
+
+    int height = 1;
+    unsigned int x = _skl_seed;
+
+    //seed each thread differently
+    if (x == 0) x = (unsigned int) (uintptr_t) &_skl_seed | 1;
+
+    //xorshift
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _skl_seed = x;
+
+    //each additional level is used half as often as the one below it
+    while ((x & 1) && height < SKL_MAX_LEVEL) {
+        ++height;
+        x >>= 1;
+    }
+
+    return height;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _skl_lock(_skl_node * node) {
+
+    //locks are only held briefly, so spin
+    while (__atomic_test_and_set(&node->lock, __ATOMIC_ACQUIRE)) sched_yield();
+
+    return;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+void _skl_unlock(_skl_node * node) {
+
+    __atomic_clear(&node->lock, __ATOMIC_RELEASE);
+
+    return;
+}
+
+
+
+//unlock the predecessors locked up to a level, each exactly once
+DBG_STATIC
+void _skl_unlock_preds(_skl_node ** preds, const int highest) {
+
+    _skl_node * prev_pred = NULL;
+
+    for (int level = 0; level <= highest; ++level) {
+
+        if (preds[level] != prev_pred) _skl_unlock(preds[level]);
+        prev_pred = preds[level];
+    }
+
+    return;
+}
+
+
+
+DBG_STATIC
+_skl_node * _skl_new_node(const cm_skl * skl, const int height,
+                          const void * key, const void * data) {
+
+    _skl_node * new_node;
+    size_t key_off;
+
+    //the key and data follow the next pointers
+    key_off = ARN_ROUND(sizeof(_skl_node) + (sizeof(_skl_node *) * height));
+
+    new_node = malloc(key_off + ARN_ROUND(skl->key_sz) + skl->data_sz);
+    if (!new_node) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    new_node->retired = NULL;
+    new_node->height = height;
+    new_node->lock = false;
+    new_node->marked = false;
+    new_node->linked = false;
+
+    new_node->key = (cm_byte *) new_node + key_off;
+    new_node->data = (cm_byte *) new_node->key + ARN_ROUND(skl->key_sz);
+
+    for (int level = 0; level < height; ++level) new_node->next[level] = NULL;
+
+    if (key != NULL) memcpy(new_node->key, key, skl->key_sz);
+    if (data != NULL) memcpy(new_node->data, data, skl->data_sz);
+
+    return new_node;
+}
+
+
+
+/*
+ *  Only a node found at its top level, once fully linked, is removed. On
+ *  success the node is marked and left locked.
+ */
+
+DBG_STATIC
+bool _skl_try_mark(_skl_node * node, const int found) {
+
+    if (node == NULL
+        || node->height - 1 != found
+        || !__atomic_load_n(&node->linked, __ATOMIC_ACQUIRE)
+        || __atomic_load_n(&node->marked, __ATOMIC_ACQUIRE)) return false;
+
+    _skl_lock(node);
+
+    //another thread may have marked the node in the meantime
+    if (__atomic_load_n(&node->marked, __ATOMIC_ACQUIRE)) {
+        _skl_unlock(node);
+        return false;
+    }
+
+    __atomic_store_n(&node->marked, true, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+
+
+/*
+ *  Fills the predecessor and successor of a key at every level. Returns
+ *  the highest level at which a node with the key was found, or -1.
+ */
+
+DBG_STATIC
+int _skl_find(const cm_skl * skl, const void * key,
+              _skl_node ** preds, _skl_node ** succs) {
+
+    int found = -1;
+    enum cm_rbt_side side = LESS;
+    _skl_node * pred = skl->head, * curr;
+
+    for (int level = SKL_MAX_LEVEL - 1; level >= 0; --level) {
+
+        curr = __atomic_load_n(&pred->next[level], __ATOMIC_ACQUIRE);
+
+        //advance while the key is past the current node
+        while (curr != NULL) {
+
+            side = skl->compare(key, curr->key);
+            if (side != MORE) break;
+
+            pred = curr;
+            curr = __atomic_load_n(&pred->next[level], __ATOMIC_ACQUIRE);
+        }
+
+        if (found == -1 && curr != NULL && side == EQUAL) found = level;
+
+        preds[level] = pred;
+        succs[level] = curr;
+
+    } //end for
+
+    return found;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_skl_get(const cm_skl * skl, const void * key, void * buf) {
+
+    enum cm_rbt_side side = LESS;
+    _skl_node * pred = skl->head, * curr = NULL, * node = NULL;
+    _ebr_slot * slot;
+
+    slot = _ebr_enter(skl->ebr);
+    if (!slot) return -1;
+
+    //stop at the first level that holds the key
+    for (int level = SKL_MAX_LEVEL - 1; level >= 0 && node == NULL; --level) {
+
+        curr = __atomic_load_n(&pred->next[level], __ATOMIC_ACQUIRE);
+
+        while (curr != NULL) {
+
+            side = skl->compare(key, curr->key);
+            if (side != MORE) break;
+
+            pred = curr;
+            curr = __atomic_load_n(&pred->next[level], __ATOMIC_ACQUIRE);
+        }
+
+        if (curr != NULL && side == EQUAL) node = curr;
+
+    } //end for
+
+    if (node == NULL
+        || !__atomic_load_n(&node->linked, __ATOMIC_ACQUIRE)
+        || __atomic_load_n(&node->marked, __ATOMIC_ACQUIRE)) {
+
+        _ebr_exit(slot);
+        cm_errno = CM_ERR_USER_KEY;
+        return -1;
+    }
+
+    memcpy(buf, node->data, skl->data_sz);
+    _ebr_exit(slot);
+
+    return 0;
+}
+
+
+
+int cm_skl_ins(cm_skl * skl, const void * key, const void * data) {
+
+    _skl_node * preds[SKL_MAX_LEVEL], * succs[SKL_MAX_LEVEL];
+    _skl_node * pred, * succ, * prev_pred, * new_node, * found_node;
+    int height, found, highest;
+    bool valid;
+    _ebr_slot * slot;
+
+    height = _skl_random_height();
+    new_node = _skl_new_node(skl, height, key, data);
+    if (!new_node) return -1;
+
+    slot = _ebr_enter(skl->ebr);
+    if (!slot) {
+        free(new_node);
+        return -1;
+    }
+
+    while (true) {
+
+        found = _skl_find(skl, key, preds, succs);
+
+        //the key is present, unless its node is being removed
+        if (found != -1) {
+
+            found_node = succs[found];
+            if (__atomic_load_n(&found_node->marked, __ATOMIC_ACQUIRE)) {
+                continue;
+            }
+
+            //wait for a concurrent insertion of the key to complete
+            while (!__atomic_load_n(&found_node->linked, __ATOMIC_ACQUIRE)) {
+                sched_yield();
+            }
+
+            _ebr_exit(slot);
+            free(new_node);
+            cm_errno = CM_ERR_USER_DUPLICATE;
+            return -1;
+        }
+
+        //lock the predecessors and check they still precede the successors
+        highest = -1;
+        valid = true;
+        prev_pred = NULL;
+
+        for (int level = 0; valid && level < height; ++level) {
+
+            pred = preds[level];
+            succ = succs[level];
+
+            if (pred != prev_pred) {
+                _skl_lock(pred);
+                highest = level;
+                prev_pred = pred;
+            }
+
+            valid = !__atomic_load_n(&pred->marked, __ATOMIC_ACQUIRE)
+                    && (succ == NULL
+                        || !__atomic_load_n(&succ->marked, __ATOMIC_ACQUIRE))
+                    && __atomic_load_n(&pred->next[level],
+                                       __ATOMIC_ACQUIRE) == succ;
+        } //end for
+
+        if (!valid) {
+            _skl_unlock_preds(preds, highest);
+            continue;
+        }
+
+        //link the new node from the bottom up
+        for (int level = 0; level < height; ++level) {
+            new_node->next[level] = succs[level];
+        }
+
+        for (int level = 0; level < height; ++level) {
+            __atomic_store_n(&preds[level]->next[level],
+                             new_node, __ATOMIC_RELEASE);
+        }
+
+        __atomic_store_n(&new_node->linked, true, __ATOMIC_RELEASE);
+
+        _skl_unlock_preds(preds, highest);
+        break;
+
+    } //end while
+
+    __atomic_add_fetch(&skl->size, 1, __ATOMIC_RELAXED);
+    _ebr_exit(slot);
+
+    return 0;
+}
+
+
+
+int cm_skl_rem(cm_skl * skl, const void * key) {
+
+    _skl_node * preds[SKL_MAX_LEVEL], * succs[SKL_MAX_LEVEL];
+    _skl_node * pred, * prev_pred, * victim = NULL;
+    int height = 0, found, highest;
+    bool marked = false, valid;
+    _ebr_slot * slot;
+
+    slot = _ebr_enter(skl->ebr);
+    if (!slot) return -1;
+
+    while (true) {
+
+        found = _skl_find(skl, key, preds, succs);
+
+        //mark the node, unless another thread is already removing it
+        if (!marked) {
+
+            victim = found == -1 ? NULL : succs[found];
+            if (!_skl_try_mark(victim, found)) {
+                _ebr_exit(slot);
+                cm_errno = CM_ERR_USER_KEY;
+                return -1;
+            }
+
+            height = victim->height;
+            marked = true;
+        }
+
+        //lock the predecessors and check they still precede the victim
+        highest = -1;
+        valid = true;
+        prev_pred = NULL;
+
+        for (int level = 0; valid && level < height; ++level) {
+
+            pred = preds[level];
+
+            if (pred != prev_pred) {
+                _skl_lock(pred);
+                highest = level;
+                prev_pred = pred;
+            }
+
+            valid = !__atomic_load_n(&pred->marked, __ATOMIC_ACQUIRE)
+                    && __atomic_load_n(&pred->next[level],
+                                       __ATOMIC_ACQUIRE) == victim;
+        } //end for
+
+        if (!valid) {
+            _skl_unlock_preds(preds, highest);
+            continue;
+        }
+
+        //unlink the victim from the top down
+        for (int level = height - 1; level >= 0; --level) {
+            __atomic_store_n(&preds[level]->next[level],
+                             victim->next[level], __ATOMIC_RELEASE);
+        }
+
+        _skl_unlock(victim);
+        _skl_unlock_preds(preds, highest);
+        break;
+
+    } //end while
+
+    __atomic_sub_fetch(&skl->size, 1, __ATOMIC_RELAXED);
+
+    //other threads may still be reading the victim
+    _ebr_retire(skl->ebr, slot, victim);
+    _ebr_exit(slot);
+
+    return 0;
+}
+
+
+
+int cm_new_skl(cm_skl * skl, const size_t key_sz, const size_t data_sz,
+               enum cm_rbt_side (*compare)(const void *, const void *)) {
+
+    skl->size = 0;
+    skl->key_sz = key_sz;
+    skl->data_sz = data_sz;
+    skl->compare = compare;
+
+    //the head node has every level and no key
+    skl->head = _skl_new_node(skl, SKL_MAX_LEVEL, NULL, NULL);
+    if (!skl->head) return -1;
+
+    skl->ebr = _ebr_new(offsetof(_skl_node, retired));
+    if (!skl->ebr) {
+        free(skl->head);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+/*
+ *  Must only be called once no other thread uses the skip list.
+ */
+
+void cm_del_skl(cm_skl * skl) {
+
+    _skl_node * node = skl->head, * next_node;
+
+    while (node != NULL) {
+        next_node = node->next[0];
+        free(node);
+        node = next_node;
+    }
+
+    _ebr_del(skl->ebr);
+
+    skl->size = 0;
+    skl->head = NULL;
+
+    return;
+}
@@ -0,0 +1,67 @@
+#ifndef SKL_H
+#define SKL_H
+
+//standard library
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+//maximum number of levels of a skip list
+#define SKL_MAX_LEVEL 24
+
+
+/*
+ *  Each node is a single allocation holding its next pointers, followed
+ *  by its key and data. The key and data of a node never change once it
+ *  is linked, so lookups copy them without taking the node's lock.
+ */
+
+struct _cm_skl_node {
+
+    struct _cm_skl_node * retired; //chains the node once it is retired
+
+    int height;  //number of levels the node is linked into
+    bool lock;
+    bool marked; //set once the node is logically removed
+    bool linked; //set once the node is linked into every level
+
+    void * key;
+    void * data;
+
+    struct _cm_skl_node * next[];
+
+};
+typedef struct _cm_skl_node _skl_node;
+
+
+#ifdef DEBUG
+//internal
+int _skl_random_height();
+void _skl_lock(_skl_node * node);
+void _skl_unlock(_skl_node * node);
+void _skl_unlock_preds(_skl_node ** preds, const int highest);
+
+_skl_node * _skl_new_node(const cm_skl * skl, const int height,
+                          const void * key, const void * data);
+bool _skl_try_mark(_skl_node * node, const int found);
+int _skl_find(const cm_skl * skl, const void * key,
+              _skl_node ** preds, _skl_node ** succs);
+#endif
+
+
+//external
+int cm_skl_get(const cm_skl * skl, const void * key, void * buf);
+int cm_skl_ins(cm_skl * skl, const void * key, const void * data);
+int cm_skl_rem(cm_skl * skl, const void * key);
+
+int cm_new_skl(cm_skl * skl, const size_t key_sz, const size_t data_sz,
+               enum cm_rbt_side (*compare)(const void *, const void *));
+void cm_del_skl(cm_skl * skl);
+
+#endif
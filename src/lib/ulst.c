@@ -0,0 +1,495 @@
+//standard library
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+#include "ulst.h"
+
+
+
+/*
+ *  --- [INTERNAL] ---
+ */
+
+DBG_STATIC DBG_INLINE
+void _ulst_set_cursor(cm_ulst * list, cm_ulst_node * node, const int base) {
+
+    //a negative base means the index of the node is not known
+    if (base < 0) {
+        list->cursor = NULL;
+    } else {
+        list->cursor     = node;
+        list->cursor_idx = base;
+    }
+
+    return;
+}
+
+
+
+/*
+ *  Finds the node holding an element and the element's position in that
+ *  node. The walk starts from the head, the tail, or the cursor, whichever
+ *  is closest, and the node reached is cached in the cursor. Since every
+ *  traversal moves the cursor, the getters take a non-const list.
+ */
+
+DBG_STATIC
+cm_ulst_node * _ulst_traverse(cm_ulst * list,
+                              const int index, int * pos) {
+
+    cm_ulst_node * node;
+    int base;
+
+    //start from whichever end is closer
+    if (index < list->len / 2) {
+        node = list->head;
+        base = 0;
+    } else {
+        node = list->head->prev;
+        base = list->len - node->len;
+    }
+
+    //start from the cursor instead if it is closer
+    if (list->cursor != NULL
+        && abs(index - list->cursor_idx) < abs(index - base)) {
+        node = list->cursor;
+        base = list->cursor_idx;
+    }
+
+    //walk backwards
+    while (index < base) {
+        node = node->prev;
+        base -= node->len;
+    }
+
+    //walk forwards
+    while (index >= base + node->len) {
+        base += node->len;
+        node = node->next;
+    }
+
+    //cache the node reached
+    _ulst_set_cursor(list, node, base);
+
+    *pos = index - base;
+    return node;
+}
+
+
+
+DBG_STATIC
+cm_ulst_node * _ulst_new_node(const cm_ulst * list) {
+
+    cm_ulst_node * new_node;
+
+    //allocate node structure and its elements together
+    new_node = malloc(sizeof(cm_ulst_node)
+                      + ((size_t) list->node_cap * list->data_sz));
+    if (!new_node) {
+        cm_errno = CM_ERR_MALLOC;
+        return NULL;
+    }
+
+    new_node->len = 0;
+
+    return new_node;
+}
+
+
+
+/*
+ *  Links a node after prev_node, or makes it the head if prev_node is NULL.
+ */
+
+DBG_STATIC
+void _ulst_add_node(cm_ulst * list,
+                    cm_ulst_node * node, cm_ulst_node * prev_node) {
+
+    if (prev_node == NULL) {
+
+        node->next = node->prev = node;
+        list->head = node;
+
+    } else {
+
+        node->prev = prev_node;
+        node->next = prev_node->next;
+
+        prev_node->next->prev = node;
+        prev_node->next = node;
+    }
+
+    return;
+}
+
+
+
+DBG_STATIC
+void _ulst_sub_node(cm_ulst * list, cm_ulst_node * node) {
+
+    //if this is the last node
+    if (node->next == node) {
+        list->head = NULL;
+
+    } else {
+
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+
+        if (list->head == node) list->head = node->next;
+    }
+
+    if (list->cursor == node) list->cursor = NULL;
+    free(node);
+
+    return;
+}
+
+
+
+/*
+ *  Inserts an element at a position inside a node. A full node is first
+ *  split in two, with the upper half of its elements moved to a new node.
+ */
+
+DBG_STATIC
+void * _ulst_ins_elem(cm_ulst * list, cm_ulst_node * node,
+                      int pos, const void * data) {
+
+    cm_ulst_node * new_node;
+    int keep;
+
+    //split full nodes
+    if (node->len == list->node_cap) {
+
+        new_node = _ulst_new_node(list);
+        if (!new_node) return NULL;
+
+        keep = node->len / 2;
+        new_node->len = node->len - keep;
+        memcpy(new_node->data, cm_ulst_elem(list, node, keep),
+               (size_t) new_node->len * list->data_sz);
+        node->len = keep;
+
+        _ulst_add_node(list, new_node, node);
+
+        //the element may now belong in the new node
+        if (pos > keep) {
+            node = new_node;
+            pos -= keep;
+        }
+    }
+
+    //make space for the element
+    memmove(cm_ulst_elem(list, node, pos + 1),
+            cm_ulst_elem(list, node, pos),
+            (size_t) (node->len - pos) * list->data_sz);
+    memcpy(cm_ulst_elem(list, node, pos), data, list->data_sz);
+
+    ++node->len;
+    ++list->len;
+
+    return cm_ulst_elem(list, node, pos);
+}
+
+
+
+/*
+ *  Appending never splits; a new node is started once the tail is full.
+ *  This leaves lists built by appending with full nodes.
+ */
+
+DBG_STATIC
+void * _ulst_apd_elem(cm_ulst * list, const void * data) {
+
+    cm_ulst_node * tail_node = list->head ? list->head->prev : NULL;
+    cm_ulst_node * new_node;
+
+    if (tail_node == NULL || tail_node->len == list->node_cap) {
+
+        new_node = _ulst_new_node(list);
+        if (!new_node) return NULL;
+
+        _ulst_add_node(list, new_node, tail_node);
+        tail_node = new_node;
+    }
+
+    return _ulst_ins_elem(list, tail_node, tail_node->len, data);
+}
+
+
+
+/*
+ *  Keeps a node at least half full by merging it with, or borrowing
+ *  elements from, the node that follows it. The tail node is left alone.
+ */
+
+DBG_STATIC
+void _ulst_balance(cm_ulst * list, cm_ulst_node * node) {
+
+    cm_ulst_node * next_node = node->next;
+    int move;
+
+    if (node->len >= list->node_cap / 2 || next_node == list->head) return;
+
+    //take every element of the next node if they fit, else half the difference
+    if (node->len + next_node->len <= list->node_cap) {
+        move = next_node->len;
+    } else {
+        move = (next_node->len - node->len) / 2;
+    }
+
+    memcpy(cm_ulst_elem(list, node, node->len), next_node->data,
+           (size_t) move * list->data_sz);
+    node->len += move;
+    next_node->len -= move;
+
+    if (next_node->len == 0) {
+        _ulst_sub_node(list, next_node);
+    } else {
+        memmove(next_node->data, cm_ulst_elem(list, next_node, move),
+                (size_t) next_node->len * list->data_sz);
+    }
+
+    return;
+}
+
+
+
+/*
+ *  Removes an element from a node. Returns true if the node was emptied
+ *  and freed.
+ */
+
+DBG_STATIC
+bool _ulst_rem_elem(cm_ulst * list, cm_ulst_node * node, const int pos) {
+
+    //close the gap left by the element
+    memmove(cm_ulst_elem(list, node, pos),
+            cm_ulst_elem(list, node, pos + 1),
+            (size_t) (node->len - pos - 1) * list->data_sz);
+
+    --node->len;
+    --list->len;
+
+    if (node->len == 0) {
+        _ulst_sub_node(list, node);
+        return true;
+    }
+
+    _ulst_balance(list, node);
+
+    return false;
+}
+
+
+
+DBG_STATIC DBG_INLINE
+int _ulst_assert_index_range(const cm_ulst * list,
+                             const int index, enum _ulst_index_mode mode) {
+
+    /*
+     *  If inserting, maximum index needs to be +1 higher than other operations.
+     */
+
+    if (abs(index) >= (list->len + (int) mode)) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+/*
+ *  --- [EXTERNAL] ---
+ */
+
+int cm_ulst_get(cm_ulst * list, const int index, void * buf) {
+
+    void * elem = cm_ulst_get_p(list, index);
+    if (!elem) return -1;
+
+    memcpy(buf, elem, list->data_sz);
+
+    return 0;
+}
+
+
+
+void * cm_ulst_get_p(cm_ulst * list, const int index) {
+
+    int pos;
+
+    cm_ulst_node * node = cm_ulst_get_n(list, index, &pos);
+    if (!node) return NULL;
+
+    return cm_ulst_elem(list, node, pos);
+}
+
+
+
+cm_ulst_node * cm_ulst_get_n(cm_ulst * list,
+                             const int index, int * pos) {
+
+    if (_ulst_assert_index_range(list, index, INDEX)) return NULL;
+
+    int norm_index = index >= 0 ? index : list->len + index;
+
+    return _ulst_traverse(list, norm_index, pos);
+}
+
+
+
+void * cm_ulst_set(cm_ulst * list, const int index, const void * data) {
+
+    void * elem = cm_ulst_get_p(list, index);
+    if (!elem) return NULL;
+
+    memcpy(elem, data, list->data_sz);
+
+    return elem;
+}
+
+
+
+void * cm_ulst_ins(cm_ulst * list, const int index, const void * data) {
+
+    int pos, norm_index;
+    cm_ulst_node * node;
+    void * elem;
+
+    if (_ulst_assert_index_range(list, index, ADD_INDEX)) return NULL;
+
+    norm_index = index >= 0 ? index : list->len + 1 + index;
+
+    //inserting at the end
+    if (norm_index == list->len) return _ulst_apd_elem(list, data);
+
+    node = _ulst_traverse(list, norm_index, &pos);
+    elem = _ulst_ins_elem(list, node, pos, data);
+
+    //a split leaves the node's first index unchanged
+    _ulst_set_cursor(list, node, norm_index - pos);
+
+    return elem;
+}
+
+
+
+void * cm_ulst_ins_n(cm_ulst * list, cm_ulst_node * node,
+                     const int pos, const void * data) {
+
+    int base = list->cursor == node ? list->cursor_idx : -1;
+    void * elem;
+
+    if (pos < 0 || pos > node->len) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return NULL;
+    }
+
+    elem = _ulst_ins_elem(list, node, pos, data);
+    _ulst_set_cursor(list, node, base);
+
+    return elem;
+}
+
+
+
+void * cm_ulst_apd(cm_ulst * list, const void * data) {
+
+    return _ulst_apd_elem(list, data);
+}
+
+
+
+int cm_ulst_rem(cm_ulst * list, const int index) {
+
+    int pos, norm_index;
+    cm_ulst_node * node;
+
+    if (_ulst_assert_index_range(list, index, INDEX)) return -1;
+
+    norm_index = index >= 0 ? index : list->len + index;
+    node = _ulst_traverse(list, norm_index, &pos);
+
+    if (!_ulst_rem_elem(list, node, pos)) {
+        _ulst_set_cursor(list, node, norm_index - pos);
+    }
+
+    return 0;
+}
+
+
+
+int cm_ulst_rem_n(cm_ulst * list, cm_ulst_node * node, const int pos) {
+
+    int base = list->cursor == node ? list->cursor_idx : -1;
+
+    if (pos < 0 || pos >= node->len) {
+        cm_errno = CM_ERR_USER_INDEX;
+        return -1;
+    }
+
+    if (_ulst_rem_elem(list, node, pos)) base = -1;
+    _ulst_set_cursor(list, node, base);
+
+    return 0;
+}
+
+
+
+void cm_ulst_emp(cm_ulst * list) {
+
+    cm_ulst_node * node = list->head, * next_node;
+    int len = list->len;
+
+    //free every node
+    while (len > 0) {
+
+        next_node = node->next;
+        len -= node->len;
+        free(node);
+        node = next_node;
+    }
+
+    list->len = 0;
+    list->head = NULL;
+    list->cursor = NULL;
+
+    return;
+}
+
+
+
+void cm_new_ulst(cm_ulst * list, const size_t data_sz) {
+
+    list->len = 0;
+    list->data_sz = data_sz;
+    list->head = NULL;
+    list->cursor = NULL;
+    list->cursor_idx = 0;
+
+    //fit as many elements into a node as the target size allows
+    list->node_cap = (int) (ULST_NODE_DATA_SZ / data_sz);
+    if (list->node_cap < ULST_MIN_NODE_CAP) list->node_cap = ULST_MIN_NODE_CAP;
+
+    return;
+}
+
+
+
+void cm_del_ulst(cm_ulst * list) {
+
+    cm_ulst_emp(list);
+
+    return;
+}
@@ -0,0 +1,69 @@
+#ifndef ULST_H
+#define ULST_H
+
+//standard library
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//local headers
+#include "cmore.h"
+#include "debug.h"
+
+
+//bytes of element data each node aims to hold (two cache lines)
+#define ULST_NODE_DATA_SZ 128
+//lower bound on elements per node for large elements
+#define ULST_MIN_NODE_CAP 4
+
+
+//controls if user provided index should be verified for accessing elements
+//or for adding new elements
+enum _ulst_index_mode {INDEX = 0, ADD_INDEX = 1};
+
+
+#ifdef DEBUG
+//internal
+void _ulst_set_cursor(cm_ulst * list, cm_ulst_node * node, const int base);
+cm_ulst_node * _ulst_traverse(cm_ulst * list,
+                              const int index, int * pos);
+
+cm_ulst_node * _ulst_new_node(const cm_ulst * list);
+void _ulst_add_node(cm_ulst * list,
+                    cm_ulst_node * node, cm_ulst_node * prev_node);
+void _ulst_sub_node(cm_ulst * list, cm_ulst_node * node);
+
+void * _ulst_ins_elem(cm_ulst * list, cm_ulst_node * node,
+                      int pos, const void * data);
+void * _ulst_apd_elem(cm_ulst * list, const void * data);
+void _ulst_balance(cm_ulst * list, cm_ulst_node * node);
+bool _ulst_rem_elem(cm_ulst * list, cm_ulst_node * node, const int pos);
+
+int _ulst_assert_index_range(const cm_ulst * list,
+                             const int index, enum _ulst_index_mode mode);
+#endif
+
+
+//external
+int cm_ulst_get(cm_ulst * list, const int index, void * buf);
+void * cm_ulst_get_p(cm_ulst * list, const int index);
+cm_ulst_node * cm_ulst_get_n(cm_ulst * list,
+                             const int index, int * pos);
+
+void * cm_ulst_set(cm_ulst * list, const int index, const void * data);
+
+void * cm_ulst_ins(cm_ulst * list, const int index, const void * data);
+void * cm_ulst_ins_n(cm_ulst * list, cm_ulst_node * node,
+                     const int pos, const void * data);
+void * cm_ulst_apd(cm_ulst * list, const void * data);
+
+int cm_ulst_rem(cm_ulst * list, const int index);
+int cm_ulst_rem_n(cm_ulst * list, cm_ulst_node * node, const int pos);
+
+void cm_ulst_emp(cm_ulst * list);
+
+void cm_new_ulst(cm_ulst * list, const size_t data_sz);
+void cm_del_ulst(cm_ulst * list);
+
+#endif
@@ -195,6 +195,24 @@ int cm_vct_apd(cm_vct * vector, const void * data) {
 
 
 
+void * cm_vct_apd_slot(cm_vct * vector) {
+
+    void * slot;
+
+    //grow the vector if there is no space left to insert new elements
+    if ((size_t) vector->len == vector->sz) {
+        if(_vct_grow(vector)) return NULL;
+    }
+
+    //claim the next element, leaving it for the caller to fill
+    slot = _vct_traverse(vector, vector->len);
+    ++vector->len;
+
+    return slot;
+}
+
+
+
 int cm_vct_rem(cm_vct * vector, const int index) {
 
     int norm_index = _vct_normalise_index(vector, index, INDEX);
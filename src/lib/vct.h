@@ -45,6 +45,7 @@ void  * cm_vct_get_p(const cm_vct * vector, const int index);
 int cm_vct_set(cm_vct * vector, const int index, const void  * data);
 int cm_vct_ins(cm_vct * vector, const int index, const void  * data);
 int cm_vct_apd(cm_vct * vector, const void  * data);
+void * cm_vct_apd_slot(cm_vct * vector);
 int cm_vct_rem(cm_vct * vector, const int index);
 int cm_vct_fit(cm_vct * vector);
 void cm_vct_emp(cm_vct * vector);
@@ -0,0 +1,427 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "test_data.h"
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/btr.h"
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *      B+ trees are tested through exported functions. After every change
+ *      the whole tree is walked to check its structure.
+ */
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//globals
+#define TEST_LEN 5000
+
+static cm_btr b;
+static data d;
+
+//keys large enough that nodes hold only a few of them
+typedef struct {
+    int x;
+    cm_byte pad[124];
+} big_key;
+
+
+
+static enum cm_rbt_side _compare(const void * b_1, const void * b_2) {
+
+    const data * d_1 = b_1, * d_2 = b_2;
+
+    if (d_1->x > d_2->x) return MORE;
+    if (d_1->x < d_2->x) return LESS;
+
+    return EQUAL;
+}
+
+
+
+//empty b+ tree setup
+static void _setup_emp() {
+
+    cm_new_btr(&b, sizeof(d), sizeof(d), _compare);
+    d.x = 0;
+
+    return;
+}
+
+
+
+//empty b+ tree with large keys setup
+static void _setup_emp_big() {
+
+    cm_new_btr(&b, sizeof(big_key), sizeof(d), _compare);
+    d.x = 0;
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_btr(&b);
+    d.x = -1;
+
+    return;
+}
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+//get the key at an index of a node
+static int _key(const _btr_node * node, const int idx) {
+
+    return ((data *) BTR_KEY(&b, node, idx))->x;
+}
+
+
+
+/*
+ *  Check a subtree holds keys in [lo, hi), with every leaf at the same 
+ *  depth and every node but the root at least half full. Returns the 
+ *  number of keys in the subtree.
+ */
+
+static int _assert_node(const _btr_node * node, const int depth,
+                        const long lo, const long hi) {
+
+    int count = 0;
+    long child_lo, child_hi;
+
+    ck_assert_int_eq(node->leaf, depth == b.height);
+
+    if (node != b.root) {
+        ck_assert_int_ge(node->len, node->leaf ? (b.leaf_cap + 1) / 2 
+                                               : b.inner_cap / 2);
+    }
+    ck_assert_int_le(node->len, node->leaf ? b.leaf_cap : b.inner_cap);
+
+    for (int i = 0; i < node->len; ++i) {
+        ck_assert_int_ge(_key(node, i), lo);
+        ck_assert_int_lt(_key(node, i), hi);
+        if (i > 0) ck_assert_int_gt(_key(node, i), _key(node, i - 1));
+    }
+
+    if (node->leaf) return node->len;
+
+    //the keys of an inner node separate its children
+    for (int i = 0; i <= node->len; ++i) {
+        child_lo = i == 0 ? lo : _key(node, i - 1);
+        child_hi = i == node->len ? hi : _key(node, i);
+        count += _assert_node(BTR_CHILDREN(&b, node)[i], 
+                              depth + 1, child_lo, child_hi);
+    }
+
+    return count;
+}
+
+
+
+//check the structure of the tree, and that its leaves hold len keys
+static void _assert_tree(const int len) {
+
+    int count = 0, last = -1;
+    cm_btr_iter iter;
+
+    ck_assert_int_eq(b.size, len);
+
+    if (len == 0) {
+        ck_assert_ptr_null(b.root);
+        ck_assert_int_eq(b.height, 0);
+        return;
+    }
+
+    ck_assert_int_eq(_assert_node(b.root, 0, -1, (long) TEST_LEN * 4), len);
+
+    //the linked leaves hold every key in order
+    cm_btr_foreach(&b, iter) {
+        ck_assert_int_gt(((data *) iter.key)->x, last);
+        last = ((data *) iter.key)->x;
+        ++count;
+    }
+    ck_assert_int_eq(count, len);
+
+    return;
+}
+
+
+
+//set a key whose data is ten times the key
+static void _set(int key) {
+
+    big_key k = {.x = key};
+    data e = {.x = key * 10};
+
+    ck_assert_ptr_nonnull(cm_btr_set(&b, &k, &e));
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_btr() [no fixture]
+START_TEST(test_new_btr) {
+
+    //run test
+    cm_new_btr(&b, sizeof(d), sizeof(d), _compare);
+
+    //assert result
+    ck_assert_int_eq(b.size, 0);
+    ck_assert_ptr_null(b.root);
+    ck_assert_int_eq(b.height, 0);
+
+    //small keys fill a node of a few cache lines
+    ck_assert_int_gt(b.leaf_cap, BTR_MIN_CAP);
+    ck_assert_int_gt(b.inner_cap, BTR_MIN_CAP);
+    ck_assert_int_le(b.leaf_sz, BTR_NODE_SZ);
+    ck_assert_int_le(b.inner_sz, BTR_NODE_SZ);
+    ck_assert_int_eq(b.leaf_sz % BTR_LINE, 0);
+    ck_assert_int_eq(b.inner_sz % BTR_LINE, 0);
+    cm_del_btr(&b);
+
+    //large keys still leave room for a few keys
+    cm_new_btr(&b, sizeof(big_key), sizeof(d), _compare);
+    ck_assert_int_eq(b.leaf_cap, BTR_MIN_CAP);
+    ck_assert_int_eq(b.inner_cap, BTR_MIN_CAP);
+    cm_del_btr(&b);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_btr_set(), cm_btr_get() & cm_btr_get_p() [empty fixture]
+START_TEST(test_btr_set_get) {
+
+    int ret;
+    data buf;
+    data * slot;
+    big_key k;
+
+    //look up a key in an empty tree
+    cm_errno = 0;
+    ret = cm_btr_get(&b, &d, &buf);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //insert the even keys out of order
+    for (int i = 0; i < TEST_LEN; ++i) {
+        _set(((i * 37) % TEST_LEN) * 2);
+        if (i % 500 == 0) _assert_tree(i + 1);
+    }
+
+    _assert_tree(TEST_LEN);
+    ck_assert_int_gt(b.height, 0);
+
+    for (int i = 0; i < TEST_LEN * 2; ++i) {
+        d.x = i;
+        ret = cm_btr_get(&b, &d, &buf);
+        ck_assert_int_eq(ret, i % 2 ? -1 : 0);
+        if (!ret) ck_assert_int_eq(buf.x, i * 10);
+    }
+
+    //setting a present key replaces its data
+    k.x = 100;
+    cm_btr_set(&b, &k, &(data) {1});
+    ck_assert_int_eq(((data *) cm_btr_get_p(&b, &k))->x, 1);
+    _assert_tree(TEST_LEN);
+
+    //fill a slot in place
+    k.x = 101;
+    slot = cm_btr_set(&b, &k, NULL);
+    slot->x = 1010;
+    ck_assert_int_eq(((data *) cm_btr_get_p(&b, &k))->x, 1010);
+    _assert_tree(TEST_LEN + 1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_btr_rem() & cm_btr_emp() [empty fixture]
+START_TEST(test_btr_rem) {
+
+    int ret;
+    data buf;
+
+    for (int i = 0; i < TEST_LEN; ++i) _set(i);
+
+    //remove a key that is not present
+    d.x = TEST_LEN;
+    cm_errno = 0;
+    ret = cm_btr_rem(&b, &d);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //remove every third key out of order
+    for (int i = 0; i < TEST_LEN; ++i) {
+        d.x = (i * 37) % TEST_LEN;
+        if (d.x % 3 != 0) continue;
+        ret = cm_btr_rem(&b, &d);
+        ck_assert_int_eq(ret, 0);
+        if (i % 250 == 0) _assert_tree(b.size);
+    }
+
+    _assert_tree(TEST_LEN - ((TEST_LEN + 2) / 3));
+
+    for (d.x = 0; d.x < TEST_LEN; ++d.x) {
+        ret = cm_btr_get(&b, &d, &buf);
+        ck_assert_int_eq(ret, d.x % 3 ? 0 : -1);
+        if (!ret) ck_assert_int_eq(buf.x, d.x * 10);
+    }
+
+    //remove the rest from both ends
+    for (int i = 0; i < TEST_LEN / 2; ++i) {
+        d.x = i;
+        cm_btr_rem(&b, &d);
+        d.x = TEST_LEN - 1 - i;
+        cm_btr_rem(&b, &d);
+        if (i % 250 == 0) _assert_tree(b.size);
+    }
+
+    _assert_tree(0);
+
+    //the tree can be refilled and emptied
+    for (int i = 0; i < TEST_LEN; ++i) _set(i);
+    _assert_tree(TEST_LEN);
+
+    cm_btr_emp(&b);
+    _assert_tree(0);
+
+    _set(1);
+    _assert_tree(1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_btr_foreach() & cm_btr_foreach_range() [empty fixture]
+START_TEST(test_btr_range) {
+
+    int count, expected;
+    cm_btr_iter iter;
+    data lo, hi;
+
+    //nothing to iterate
+    count = 0;
+    cm_btr_foreach(&b, iter) ++count;
+    ck_assert_int_eq(count, 0);
+
+    for (int i = 0; i < TEST_LEN; ++i) _set(i * 2);
+
+    //ranges starting between keys, on keys, and past the end
+    for (lo.x = -1; lo.x < TEST_LEN * 2 + 2; lo.x += 7) {
+
+        hi.x = lo.x + 100;
+        count = 0;
+
+        cm_btr_foreach_range(&b, &lo, &hi, iter) {
+            ck_assert_int_ge(((data *) iter.key)->x, lo.x);
+            ck_assert_int_lt(((data *) iter.key)->x, hi.x);
+            ck_assert_int_eq(((data *) iter.data)->x, 
+                             ((data *) iter.key)->x * 10);
+            ++count;
+        }
+
+        expected = 0;
+        for (int i = 0; i < TEST_LEN; ++i) {
+            if (i * 2 >= lo.x && i * 2 < hi.x) ++expected;
+        }
+        ck_assert_int_eq(count, expected);
+    }
+
+    //past the greatest key
+    d.x = TEST_LEN * 2;
+    cm_btr_ceil_i(&b, &d, &iter);
+    ck_assert_ptr_null(iter.leaf);
+    ck_assert_ptr_null(iter.key);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * btr_suite() {
+
+    //test cases
+    TCase * tc_new_btr;
+    TCase * tc_btr_set_get;
+    TCase * tc_btr_rem;
+    TCase * tc_btr_range;
+    TCase * tc_btr_big;
+
+    Suite * s = suite_create("b+ tree");
+
+
+    //cm_new_btr()
+    tc_new_btr = tcase_create("new_btr");
+    tcase_add_test(tc_new_btr, test_new_btr);
+
+    //cm_btr_set(), cm_btr_get() & cm_btr_get_p()
+    tc_btr_set_get = tcase_create("btr_set_get");
+    tcase_add_checked_fixture(tc_btr_set_get, _setup_emp, _teardown);
+    tcase_add_test(tc_btr_set_get, test_btr_set_get);
+
+    //cm_btr_rem() & cm_btr_emp()
+    tc_btr_rem = tcase_create("btr_rem");
+    tcase_add_checked_fixture(tc_btr_rem, _setup_emp, _teardown);
+    tcase_add_test(tc_btr_rem, test_btr_rem);
+
+    //cm_btr_foreach() & cm_btr_foreach_range()
+    tc_btr_range = tcase_create("btr_range");
+    tcase_add_checked_fixture(tc_btr_range, _setup_emp, _teardown);
+    tcase_add_test(tc_btr_range, test_btr_range);
+
+    //large keys, so nodes hold few keys and the tree is tall
+    tc_btr_big = tcase_create("btr_big");
+    tcase_add_checked_fixture(tc_btr_big, _setup_emp_big, _teardown);
+    tcase_add_test(tc_btr_big, test_btr_set_get);
+    tcase_add_test(tc_btr_big, test_btr_rem);
+    tcase_add_test(tc_btr_big, test_btr_range);
+
+
+    //add test cases to b+ tree suite
+    suite_add_tcase(s, tc_new_btr);
+    suite_add_tcase(s, tc_btr_set_get);
+    suite_add_tcase(s, tc_btr_rem);
+    suite_add_tcase(s, tc_btr_range);
+    suite_add_tcase(s, tc_btr_big);
+
+    return s;
+}
@@ -0,0 +1,477 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "test_data.h"
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/ilst.h"
+
+
+#define GET_LINK_DATA(l) (cm_ilst_entry(l, ilst_data, link))
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *      Intrusive lists are simple; internal functions 
+ *      are tested through exported functions.
+ */
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//structure with an embedded link
+typedef struct {
+
+    int x;
+    cm_ilst_link link;
+
+} ilst_data;
+
+
+//globals
+#define TEST_LEN_FULL 10
+static cm_ilst l;
+static ilst_data e[TEST_LEN_FULL + 4];
+
+
+
+//empty list setup
+static void _setup_emp() {
+
+    cm_new_ilst(&l);
+
+    for (int i = 0; i < TEST_LEN_FULL + 4; ++i) {
+        e[i].x = i;
+    }
+
+    return;
+}
+
+
+
+//populated list setup
+static void _setup_full() {
+
+    _setup_emp();
+
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        cm_ilst_apd(&l, &e[i].link);
+    }
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_ilst(&l);
+
+    return;
+}
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static void _print_ilst() {
+
+    cm_ilst_link * link = l.head;
+
+    //for each entry
+    for (int i = 0; i < l.len; ++i) {
+
+        printf("%d ", GET_LINK_DATA(link)->x);
+        link = link->next;
+        
+    } //end for
+
+    putchar('\n');
+
+    return;
+}
+
+
+
+//assert the list holds exactly the expected values, in both directions
+static void _assert_state(const int len, const int * values) {
+
+    cm_ilst_link * link = l.head;
+
+    ck_assert_int_eq(l.len, len);
+    if (len == 0) {
+        ck_assert_ptr_null(l.head);
+        return;
+    }
+
+    //traverse forwards
+    for (int i = 0; i < len; ++i) {
+        ck_assert_int_eq(GET_LINK_DATA(link)->x, values[i]);
+        link = link->next;
+    }
+    ck_assert_ptr_eq(link, l.head);
+
+    //traverse backwards
+    for (int i = len - 1; i >= 0; --i) {
+        link = link->prev;
+        ck_assert_int_eq(GET_LINK_DATA(link)->x, values[i]);
+    }
+    ck_assert_ptr_eq(link, l.head);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_ilst() [no fixture]
+START_TEST(test_new_ilst) {
+
+    //run test
+    cm_new_ilst(&l);
+    
+    //assert result
+    ck_assert_int_eq(l.len, 0);
+    ck_assert_ptr_null(l.head);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ilst_apd() [empty fixture]
+START_TEST(test_ilst_apd) {
+
+    cm_ilst_link * n;
+    int values[] = {0, 1};
+
+    //append to empty list
+    n = cm_ilst_apd(&l, &e[0].link);
+    ck_assert_ptr_eq(n, &e[0].link);
+    _assert_state(1, values);
+
+    //append to non-empty list
+    n = cm_ilst_apd(&l, &e[1].link);
+    ck_assert_ptr_eq(n, &e[1].link);
+    _assert_state(2, values);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ilst_get_n() [full fixture]
+START_TEST(test_ilst_get_n) {
+
+    cm_ilst_link * n;
+
+    //get every link (positive index)
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+
+        n = cm_ilst_get_n(&l, i);
+        ck_assert_ptr_eq(n, &e[i].link);
+
+    } //end for
+
+    //get every link (negative index)
+    for (int i = -1; i > TEST_LEN_FULL * -1; --i) {
+
+        n = cm_ilst_get_n(&l, i);
+        ck_assert_ptr_eq(n, &e[TEST_LEN_FULL + i].link);
+
+    } //end for
+
+    //get invalid index (+ve index)
+    cm_errno = 0;
+    n = cm_ilst_get_n(&l, TEST_LEN_FULL);
+    ck_assert_ptr_null(n);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    //get invalid index (-ve index)
+    cm_errno = 0;
+    n = cm_ilst_get_n(&l, -TEST_LEN_FULL);
+    ck_assert_ptr_null(n);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ilst_ins() [full fixture]
+START_TEST(test_ilst_ins) {
+
+    cm_ilst_link * n;
+    int values[] = {13, 0, 1, 2, 10, 3, 4, 5, 6, 7, 11, 8, 9, 12};
+
+    //insert in the third index (positive index)
+    n = cm_ilst_ins(&l, 3, &e[10].link);
+    ck_assert_ptr_eq(n, &e[10].link);
+
+    //insert in the third from last index (negative index)
+    n = cm_ilst_ins(&l, -3, &e[11].link);
+    ck_assert_ptr_eq(n, &e[11].link);
+
+    //insert at the end (negative index)
+    n = cm_ilst_ins(&l, -1, &e[12].link);
+    ck_assert_ptr_eq(n, &e[12].link);
+
+    //insert at the beginning (zero index)
+    n = cm_ilst_ins(&l, 0, &e[13].link);
+    ck_assert_ptr_eq(n, &e[13].link);
+
+    printf("[test_ilst_ins] final values:    ");
+    _print_ilst();
+    _assert_state(TEST_LEN_FULL + 4, values);
+
+    //insert invalid index (+ve index)
+    cm_errno = 0;
+    n = cm_ilst_ins(&l, l.len + 1, &e[0].link);
+    ck_assert_ptr_null(n);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    //insert invalid index (-ve index)
+    cm_errno = 0;
+    n = cm_ilst_ins(&l, (l.len + 1) * -1, &e[0].link);
+    ck_assert_ptr_null(n);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ilst_ins_nb() & cm_ilst_ins_na() [full fixture]
+START_TEST(test_ilst_ins_n) {
+
+    int values[] = {12, 0, 1, 2, 10, 3, 4, 5, 6, 7, 8, 9, 11, 13};
+
+    //insert before the third index
+    cm_ilst_ins_nb(&l, &e[3].link, &e[10].link);
+
+    //insert after the end
+    cm_ilst_ins_na(&l, l.head->prev, &e[11].link);
+
+    //insert before the head
+    cm_ilst_ins_nb(&l, l.head, &e[12].link);
+
+    //insert after the new end
+    cm_ilst_ins_na(&l, &e[11].link, &e[13].link);
+
+    _assert_state(TEST_LEN_FULL + 4, values);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ilst_uln() [full fixture]
+START_TEST(test_ilst_uln) {
+
+    cm_ilst_link * n;
+    int values[] = {1, 2, 4, 5, 6, 8};
+
+    //unlink the third index (positive index)
+    n = cm_ilst_uln(&l, 3);
+    ck_assert_ptr_eq(n, &e[3].link);
+    ck_assert_ptr_null(n->next);
+    ck_assert_ptr_null(n->prev);
+
+    //unlink the third from last index (negative index)
+    n = cm_ilst_uln(&l, -3);
+    ck_assert_ptr_eq(n, &e[7].link);
+
+    //unlink at end
+    n = cm_ilst_uln(&l, -1);
+    ck_assert_ptr_eq(n, &e[9].link);
+
+    //unlink at start
+    n = cm_ilst_uln(&l, 0);
+    ck_assert_ptr_eq(n, &e[0].link);
+
+    _assert_state(TEST_LEN_FULL - 4, values);
+
+    //unlink invalid index
+    cm_errno = 0;
+    n = cm_ilst_uln(&l, 99);
+    ck_assert_ptr_null(n);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ilst_uln_n() [full fixture]
+START_TEST(test_ilst_uln_n) {
+
+    int values[] = {5};
+
+    //unlink every link but one
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        if (i == 5) continue;
+        cm_ilst_uln_n(&l, &e[i].link);
+    }
+
+    _assert_state(1, values);
+    ck_assert_ptr_eq(l.head->next, l.head);
+    ck_assert_ptr_eq(l.head->prev, l.head);
+
+    //unlink the last link
+    cm_ilst_uln_n(&l, &e[5].link);
+    _assert_state(0, values);
+
+    return;
+
+} END_TEST
+
+
+
+//moving links between lists [full fixture]
+START_TEST(test_ilst_move) {
+
+    cm_ilst m;
+    cm_ilst_link * n;
+    int values[] = {1, 3, 5, 7, 9};
+
+    cm_new_ilst(&m);
+
+    //move every even element to another list
+    for (int i = 0; i < TEST_LEN_FULL; i += 2) {
+        
+        n = cm_ilst_uln_n(&l, &e[i].link);
+        cm_ilst_apd(&m, n);
+    }
+
+    _assert_state(TEST_LEN_FULL / 2, values);
+    ck_assert_int_eq(m.len, TEST_LEN_FULL / 2);
+
+    n = m.head;
+    for (int i = 0; i < m.len; ++i) {
+        ck_assert_int_eq(GET_LINK_DATA(n)->x, i * 2);
+        n = n->next;
+    }
+
+    cm_del_ilst(&m);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ilst_emp() [full fixture]
+START_TEST(test_ilst_emp) {
+
+    cm_ilst_emp(&l);
+    ck_assert_int_eq(l.len, 0);
+    ck_assert_ptr_null(l.head);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * ilst_suite() {
+
+    //test cases
+    TCase * tc_new_ilst;
+    TCase * tc_ilst_apd;
+    TCase * tc_ilst_get_n;
+    TCase * tc_ilst_ins;
+    TCase * tc_ilst_ins_n;
+    TCase * tc_ilst_uln;
+    TCase * tc_ilst_uln_n;
+    TCase * tc_ilst_move;
+    TCase * tc_ilst_emp;
+
+    Suite * s = suite_create("intrusive list");
+
+
+    //cm_new_ilst()
+    tc_new_ilst = tcase_create("new_ilst");
+    tcase_add_test(tc_new_ilst, test_new_ilst);
+
+    //cm_ilst_apd()
+    tc_ilst_apd = tcase_create("ilist_apd");
+    tcase_add_checked_fixture(tc_ilst_apd, _setup_emp, _teardown);
+    tcase_add_test(tc_ilst_apd, test_ilst_apd);
+
+    //cm_ilst_get_n()
+    tc_ilst_get_n = tcase_create("ilist_get_n");
+    tcase_add_checked_fixture(tc_ilst_get_n, _setup_full, _teardown);
+    tcase_add_test(tc_ilst_get_n, test_ilst_get_n);
+
+    //cm_ilst_ins()
+    tc_ilst_ins = tcase_create("ilist_ins");
+    tcase_add_checked_fixture(tc_ilst_ins, _setup_full, _teardown);
+    tcase_add_test(tc_ilst_ins, test_ilst_ins);
+
+    //cm_ilst_ins_nb() & cm_ilst_ins_na()
+    tc_ilst_ins_n = tcase_create("ilist_ins_n");
+    tcase_add_checked_fixture(tc_ilst_ins_n, _setup_full, _teardown);
+    tcase_add_test(tc_ilst_ins_n, test_ilst_ins_n);
+
+    //cm_ilst_uln()
+    tc_ilst_uln = tcase_create("ilist_uln");
+    tcase_add_checked_fixture(tc_ilst_uln, _setup_full, _teardown);
+    tcase_add_test(tc_ilst_uln, test_ilst_uln);
+
+    //cm_ilst_uln_n()
+    tc_ilst_uln_n = tcase_create("ilist_uln_n");
+    tcase_add_checked_fixture(tc_ilst_uln_n, _setup_full, _teardown);
+    tcase_add_test(tc_ilst_uln_n, test_ilst_uln_n);
+
+    //moving links between lists
+    tc_ilst_move = tcase_create("ilist_move");
+    tcase_add_checked_fixture(tc_ilst_move, _setup_full, _teardown);
+    tcase_add_test(tc_ilst_move, test_ilst_move);
+
+    //cm_ilst_emp()
+    tc_ilst_emp = tcase_create("ilist_emp");
+    tcase_add_checked_fixture(tc_ilst_emp, _setup_full, _teardown);
+    tcase_add_test(tc_ilst_emp, test_ilst_emp);
+
+
+    //add test cases to intrusive list suite
+    suite_add_tcase(s, tc_new_ilst);
+    suite_add_tcase(s, tc_ilst_apd);
+    suite_add_tcase(s, tc_ilst_get_n);
+    suite_add_tcase(s, tc_ilst_ins);
+    suite_add_tcase(s, tc_ilst_ins_n);
+    suite_add_tcase(s, tc_ilst_uln);
+    suite_add_tcase(s, tc_ilst_uln_n);
+    suite_add_tcase(s, tc_ilst_move);
+    suite_add_tcase(s, tc_ilst_emp);
+
+    return s;
+}
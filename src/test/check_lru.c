@@ -0,0 +1,350 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "test_data.h"
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/lru.h"
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *      LRU caches are tested through exported functions, in both modes.
+ */
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//globals
+#define TEST_CAP 4
+#define TEST_CAP_LARGE 64
+
+static cm_lru c;
+static data d;
+
+
+
+//empty cache setup
+static void _setup_emp() {
+
+    int ret = cm_new_lru(&c, TEST_CAP, sizeof(int), sizeof(d));
+    ck_assert_int_eq(ret, 0);
+    d.x = 0;
+
+    return;
+}
+
+
+
+//empty CLOCK cache setup
+static void _setup_emp_clk() {
+
+    int ret = cm_new_lru_clk(&c, TEST_CAP, sizeof(int), sizeof(d));
+    ck_assert_int_eq(ret, 0);
+    d.x = 0;
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_lru(&c);
+    d.x = -1;
+
+    return;
+}
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+//cache a key whose data is ten times the key
+static void _put(int key) {
+
+    data e = {.x = key * 10};
+    void * ret = cm_lru_put(&c, &key, &e);
+    ck_assert_ptr_nonnull(ret);
+
+    return;
+}
+
+
+
+//assert whether a key is cached, without counting it as a use
+static void _assert_cached(int key, bool cached) {
+
+    _lru_entry * entry;
+    bool found = false;
+
+    for (int i = 0; i < c.cap; ++i) {
+        entry = LRU_ENTRY(&c, i);
+        if (entry->used && *(int *) entry->mem == key) found = true;
+    }
+
+    ck_assert_int_eq(found, cached);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_lru() [no fixture]
+START_TEST(test_new_lru) {
+
+    int ret;
+
+    //run test
+    ret = cm_new_lru(&c, TEST_CAP, sizeof(int), sizeof(d));
+    ck_assert_int_eq(ret, 0);
+
+    //assert result
+    ck_assert_int_eq(c.len, 0);
+    ck_assert_int_eq(c.cap, TEST_CAP);
+    ck_assert(c.mode == CM_LRU_LIST);
+    cm_del_lru(&c);
+
+    //a cache must hold at least one entry
+    cm_errno = 0;
+    ret = cm_new_lru_clk(&c, 0, sizeof(int), sizeof(d));
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_lru_put(), cm_lru_get() & cm_lru_get_p() [empty fixture]
+START_TEST(test_lru_get_put) {
+
+    int ret, key;
+    data buf;
+    void * slot;
+
+    //miss
+    key = 1;
+    cm_errno = 0;
+    ck_assert_ptr_null(cm_lru_get_p(&c, &key));
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //fill the cache
+    for (int i = 1; i <= TEST_CAP; ++i) _put(i);
+    ck_assert_int_eq(c.len, TEST_CAP);
+
+    //a hit makes 1 the most recently used
+    ret = cm_lru_get(&c, &key, &buf);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(buf.x, 10);
+
+    //caching another key evicts the least recently used, 2
+    _put(5);
+    ck_assert_int_eq(c.len, TEST_CAP);
+    _assert_cached(1, true);
+    _assert_cached(2, false);
+    _assert_cached(5, true);
+
+    //putting a cached key updates its data and counts as a use
+    key = 3;
+    d.x = 333;
+    cm_lru_put(&c, &key, &d);
+    ck_assert_int_eq(((data *) cm_lru_get_p(&c, &key))->x, 333);
+
+    _put(6);
+    _assert_cached(3, true);
+    _assert_cached(4, false);
+
+    //fill a slot in place
+    key = 7;
+    slot = cm_lru_put(&c, &key, NULL);
+    ((data *) slot)->x = 70;
+    ck_assert_int_eq(((data *) cm_lru_get_p(&c, &key))->x, 70);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_lru_rem(), cm_lru_evict() & cm_lru_emp() [empty fixture]
+START_TEST(test_lru_rem_evict) {
+
+    int ret, key;
+    data buf;
+
+    //evict from an empty cache
+    cm_errno = 0;
+    ret = cm_lru_evict(&c, &key, &buf);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_EMPTY);
+
+    for (int i = 1; i <= TEST_CAP; ++i) _put(i);
+
+    //remove a key, freeing its entry
+    key = 2;
+    ret = cm_lru_rem(&c, &key);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(c.len, TEST_CAP - 1);
+
+    cm_errno = 0;
+    ret = cm_lru_rem(&c, &key);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //the freed entry is used before anything is evicted
+    _put(5);
+    _assert_cached(1, true);
+
+    //evict the least recently used entry, handing it back
+    ret = cm_lru_evict(&c, &key, &buf);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(key, 1);
+    ck_assert_int_eq(buf.x, 10);
+    ck_assert_int_eq(c.len, TEST_CAP - 1);
+
+    //empty the cache, after which it is reusable
+    cm_lru_emp(&c);
+    ck_assert_int_eq(c.len, 0);
+    _assert_cached(3, false);
+
+    for (int i = 1; i <= TEST_CAP; ++i) _put(i);
+    ck_assert_int_eq(c.len, TEST_CAP);
+
+    return;
+
+} END_TEST
+
+
+
+//CLOCK eviction [CLOCK fixture]
+START_TEST(test_lru_clk) {
+
+    int key, ret;
+    data buf;
+
+    for (int i = 1; i <= TEST_CAP; ++i) _put(i);
+
+    //hits only set a flag
+    for (key = 1; key <= 2; ++key) {
+        ret = cm_lru_get(&c, &key, &buf);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //the hand passes over 1 and 2, clearing their flags, and evicts 3
+    _put(5);
+    _assert_cached(1, true);
+    _assert_cached(2, true);
+    _assert_cached(3, false);
+
+    //the hand continues from where it stopped
+    _put(6);
+    _assert_cached(4, false);
+
+    //1 and 2 were not used since the hand passed
+    _put(7);
+    _assert_cached(1, false);
+    _assert_cached(2, true);
+
+    return;
+
+} END_TEST
+
+
+
+//many more keys than entries [no fixture]
+START_TEST(test_lru_large) {
+
+    int ret;
+    data buf;
+
+    ret = cm_new_lru(&c, TEST_CAP_LARGE, sizeof(int), sizeof(d));
+    ck_assert_int_eq(ret, 0);
+
+    for (int i = 0; i < TEST_CAP_LARGE * 16; ++i) _put(i);
+    ck_assert_int_eq(c.len, TEST_CAP_LARGE);
+
+    //only the most recently used keys remain
+    for (int i = 0; i < TEST_CAP_LARGE * 16; ++i) {
+        ret = cm_lru_get(&c, &i, &buf);
+        ck_assert_int_eq(ret, i < TEST_CAP_LARGE * 15 ? -1 : 0);
+        if (!ret) ck_assert_int_eq(buf.x, i * 10);
+    }
+
+    cm_del_lru(&c);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * lru_suite() {
+
+    //test cases
+    TCase * tc_new_lru;
+    TCase * tc_lru_get_put;
+    TCase * tc_lru_rem_evict;
+    TCase * tc_lru_clk;
+    TCase * tc_lru_large;
+
+    Suite * s = suite_create("lru cache");
+
+
+    //cm_new_lru()
+    tc_new_lru = tcase_create("new_lru");
+    tcase_add_test(tc_new_lru, test_new_lru);
+
+    //cm_lru_put(), cm_lru_get() & cm_lru_get_p()
+    tc_lru_get_put = tcase_create("lru_get_put");
+    tcase_add_checked_fixture(tc_lru_get_put, _setup_emp, _teardown);
+    tcase_add_test(tc_lru_get_put, test_lru_get_put);
+
+    //cm_lru_rem(), cm_lru_evict() & cm_lru_emp()
+    tc_lru_rem_evict = tcase_create("lru_rem_evict");
+    tcase_add_checked_fixture(tc_lru_rem_evict, _setup_emp, _teardown);
+    tcase_add_test(tc_lru_rem_evict, test_lru_rem_evict);
+
+    //CLOCK eviction
+    tc_lru_clk = tcase_create("lru_clk");
+    tcase_add_checked_fixture(tc_lru_clk, _setup_emp_clk, _teardown);
+    tcase_add_test(tc_lru_clk, test_lru_clk);
+
+    //many more keys than entries
+    tc_lru_large = tcase_create("lru_large");
+    tcase_add_test(tc_lru_large, test_lru_large);
+
+
+    //add test cases to lru cache suite
+    suite_add_tcase(s, tc_new_lru);
+    suite_add_tcase(s, tc_lru_get_put);
+    suite_add_tcase(s, tc_lru_rem_evict);
+    suite_add_tcase(s, tc_lru_clk);
+    suite_add_tcase(s, tc_lru_large);
+
+    return s;
+}
@@ -54,6 +54,7 @@ static void _setup_stub() {
 
     l.len = 3;
     l.data_sz = sizeof(d);
+    l.cursor = NULL;
     
     cm_lst_node * n[3];
     
@@ -97,6 +98,39 @@ static void _setup_full() {
 
 
 
+//populated inline list setup
+static void _setup_full_inl() {
+
+    cm_new_lst_inl(&l, sizeof(d));
+    d.x = 0;
+
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        cm_lst_apd(&l, &d);
+        d.x++;
+    }
+
+    return;
+}
+
+
+
+//populated arena list setup
+static void _setup_full_arn() {
+
+    int ret = cm_new_lst_arn(&l, sizeof(d));
+    ck_assert_int_eq(ret, 0);
+    d.x = 0;
+
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        cm_lst_apd(&l, &d);
+        d.x++;
+    }
+
+    return;
+}
+
+
+
 static void teardown() {
 
     cm_del_lst(&l);
@@ -147,6 +181,56 @@ static void _assert_state(const int len, const int index, const int value) {
 
 
 
+//check the values of a list in both directions
+static void _assert_values(const cm_lst * list, 
+                           const int * values, const int len) {
+
+    cm_lst_node * iter = list->head;
+
+    ck_assert_int_eq(list->len, len);
+    if (len == 0) {
+        ck_assert_ptr_null(list->head);
+        return;
+    }
+
+    //single node lists do not loop
+    if (len == 1) {
+        ck_assert_ptr_null(iter->next);
+        ck_assert_ptr_null(iter->prev);
+        ck_assert_int_eq(GET_NODE_DATA(iter)->x, values[0]);
+        return;
+    }
+
+    //forwards
+    for (int i = 0; i < len; ++i) {
+        ck_assert_int_eq(GET_NODE_DATA(iter)->x, values[i]);
+        iter = iter->next;
+    }
+    ck_assert_ptr_eq(iter, list->head);
+
+    //backwards
+    for (int i = len - 1; i >= 0; --i) {
+        iter = iter->prev;
+        ck_assert_int_eq(GET_NODE_DATA(iter)->x, values[i]);
+    }
+
+    return;
+}
+
+
+
+//compare the data of two nodes, ignoring the thousands
+static enum cm_rbt_side _compare_data(const void * a, const void * b) {
+
+    int x = ((data *) a)->x % 1000, y = ((data *) b)->x % 1000;
+
+    if (x < y) return LESS;
+    if (x > y) return MORE;
+    return EQUAL;
+}
+
+
+
 /*
  *  --- [UNIT TESTS] ---
  */
@@ -170,6 +254,99 @@ START_TEST(test_new_lst) {
 
 
 
+//cm_new_lst_inl() [no fixture]
+START_TEST(test_new_lst_inl) {
+
+    cm_lst_node * n;
+
+    //run test
+    cm_new_lst_inl(&l, sizeof(data));
+    
+    //assert result
+    ck_assert_int_eq(l.len, 0);
+    ck_assert_int_eq(l.data_sz, sizeof(data));
+    ck_assert(l.mode == CM_LST_INLINE);
+
+    //data of new nodes is stored at the end of the node
+    n = cm_lst_apd(&l, &d);
+    ck_assert_ptr_nonnull(n);
+    ck_assert_ptr_eq(n->data, n->inl);
+    ck_assert_int_eq((uintptr_t) n->data % 16, 0);
+
+    //cleanup
+    cm_del_lst(&l);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_new_lst_arn() [no fixture]
+START_TEST(test_new_lst_arn) {
+
+    int ret;
+    cm_lst_node * n, * uln_node;
+    cm_lst other;
+
+    //run test
+    ret = cm_new_lst_arn(&l, sizeof(data));
+    ck_assert_int_eq(ret, 0);
+
+    //assert result
+    ck_assert_int_eq(l.len, 0);
+    ck_assert_int_eq(l.data_sz, sizeof(data));
+    ck_assert(l.mode == CM_LST_ARENA);
+    ck_assert_ptr_nonnull(l.arn);
+
+    //data of new nodes is stored at the end of the node
+    for (d.x = 0; d.x < 100; ++d.x) {
+        n = cm_lst_apd(&l, &d);
+        ck_assert_ptr_nonnull(n);
+        ck_assert_ptr_eq(n->data, n->inl);
+        ck_assert_int_eq((uintptr_t) n->data % 16, 0);
+    }
+
+    //removed nodes are reused by later insertions
+    n = cm_lst_get_n(&l, 50);
+    ret = cm_lst_rem(&l, 50);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_ptr_eq(cm_lst_apd(&l, &d), n);
+
+    //unlinked nodes stay valid until the list is emptied
+    uln_node = cm_lst_uln(&l, 0);
+    ck_assert_int_eq(((data *) uln_node->data)->x, 0);
+
+    //nodes can not move to or from an arena list
+    cm_new_lst(&other, sizeof(data));
+    cm_lst_apd(&other, &d);
+
+    cm_errno = 0;
+    ck_assert_int_eq(cm_lst_cat(&l, &other), -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+    ck_assert_int_eq(cm_lst_split(&l, 10, &other), -1);
+    ck_assert_int_eq(other.len, 1);
+
+    cm_del_lst(&other);
+
+    //emptying frees the chunks, after which the list is reusable
+    ret = cm_lst_emp(&l);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(l.len, 0);
+    ck_assert_ptr_null(l.head);
+
+    for (d.x = 0; d.x < 10; ++d.x) cm_lst_apd(&l, &d);
+    ck_assert_int_eq(((data *) cm_lst_get_p(&l, 9))->x, 9);
+
+    //cleanup
+    cm_del_lst(&l);
+
+    return;
+
+} END_TEST
+
+
+
 //cm_del_lst() [stub fixture]
 START_TEST(test_del_lst) {
 
@@ -207,6 +384,30 @@ START_TEST(test_lst_apd) {
 
 
 
+//cm_lst_apd_slot() [empty fixture]
+START_TEST(test_lst_apd_slot) {
+
+    data * slot;
+
+    //append to empty list
+    slot = cm_lst_apd_slot(&l);
+    ck_assert_ptr_nonnull(slot);
+    slot->x = 0;
+    _assert_state(1, 0, 0);
+
+    //append to non-empty list
+    slot = cm_lst_apd_slot(&l);
+    ck_assert_ptr_nonnull(slot);
+    slot->x = 1;
+    _assert_state(2, 1, 1);
+    ck_assert_ptr_eq(l.head->prev->data, slot);
+
+    return;
+
+} END_TEST
+
+
+
 //cm_lst_get() [full fixture]
 START_TEST(test_lst_get) {
 
@@ -1030,6 +1231,324 @@ START_TEST(test_lst_emp) {
 
 
 
+//traversal cursor [full fixture]
+START_TEST(test_lst_cursor) {
+
+    data * e;
+    cm_lst_node * n;
+
+    //sequential access leaves the cursor on the last node reached
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+
+        e = cm_lst_get_p(&l, i);
+        ck_assert_int_eq(e->x, i);
+        ck_assert_ptr_eq(l.cursor->data, e);
+        ck_assert_int_eq(l.cursor_idx, i);
+
+    } //end for
+
+    //insertion moves the cursor to the new node
+    d.x = 100;
+    n = cm_lst_ins(&l, 4, &d);
+    ck_assert_ptr_eq(l.cursor, n);
+    ck_assert_int_eq(l.cursor_idx, 4);
+    ck_assert_int_eq(((data *) cm_lst_get_p(&l, 5))->x, 4);
+
+    //removal moves the cursor to the node that took the removed index
+    cm_lst_rem(&l, 4);
+    ck_assert_int_eq(l.cursor_idx, 4);
+    ck_assert_int_eq(GET_NODE_DATA(l.cursor)->x, 4);
+
+    //removing the last node moves the cursor back by one
+    cm_lst_rem(&l, -1);
+    ck_assert_int_eq(l.cursor_idx, l.len - 1);
+    ck_assert_int_eq(GET_NODE_DATA(l.cursor)->x, 8);
+
+    //inserting before the cursor node keeps its index valid
+    n = cm_lst_get_n(&l, 2);
+    d.x = 200;
+    n = cm_lst_ins_nb(&l, n, &d);
+    ck_assert_ptr_eq(l.cursor, n);
+    ck_assert_int_eq(l.cursor_idx, 2);
+
+    //inserting after the cursor node moves it forward
+    d.x = 300;
+    n = cm_lst_ins_na(&l, n, &d);
+    ck_assert_ptr_eq(l.cursor, n);
+    ck_assert_int_eq(l.cursor_idx, 3);
+
+    //removing a node other than the cursor invalidates it
+    cm_lst_rem_n(&l, l.head);
+    ck_assert_ptr_null(l.cursor);
+
+    //every index is still reached correctly
+    int expected[] = {1, 200, 300, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 0; i < l.len; ++i) {
+        ck_assert_int_eq(((data *) cm_lst_get_p(&l, i))->x, expected[i]);
+    }
+
+    for (int i = l.len - 1; i >= 0; --i) {
+        ck_assert_int_eq(((data *) cm_lst_get_p(&l, i))->x, expected[i]);
+    }
+
+    //emptying the list clears the cursor
+    cm_lst_emp(&l);
+    ck_assert_ptr_null(l.cursor);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_lst_splice() & cm_lst_cat() [full fixture]
+START_TEST(test_lst_splice) {
+
+    int ret;
+    cm_lst src, other;
+
+    cm_new_lst(&src, sizeof(d));
+    cm_new_lst_inl(&other, sizeof(d) * 2);
+
+    //splice an empty list
+    ret = cm_lst_splice(&l, 3, &src);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(l.len, TEST_LEN_FULL);
+
+    //splice into the middle (positive index)
+    d.x = 100;
+    cm_lst_apd(&src, &d);
+    d.x = 101;
+    cm_lst_apd(&src, &d);
+
+    ret = cm_lst_splice(&l, 2, &src);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&src, NULL, 0);
+    _assert_values(&l, (int []) {0, 1, 100, 101, 2, 3, 4, 5, 6, 7, 8, 9}, 12);
+    ck_assert_int_eq(((data *) cm_lst_get_p(&l, 4))->x, 2);
+
+    //splice a single node at the start
+    d.x = 200;
+    cm_lst_apd(&src, &d);
+
+    ret = cm_lst_splice(&l, 0, &src);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(GET_NODE_DATA(l.head)->x, 200);
+    ck_assert_int_eq(l.len, 13);
+
+    //splice at the end (negative index)
+    d.x = 300;
+    cm_lst_apd(&src, &d);
+
+    ret = cm_lst_splice(&l, -1, &src);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(GET_NODE_DATA(l.head->prev)->x, 300);
+    ck_assert_int_eq(l.len, 14);
+
+    //concatenate onto an empty list
+    ret = cm_lst_cat(&src, &l);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&l, NULL, 0);
+    _assert_values(&src, (int []) {200, 0, 1, 100, 101, 2, 3, 
+                                   4, 5, 6, 7, 8, 9, 300}, 14);
+
+    //concatenate a single node list onto a single node list
+    cm_lst_emp(&src);
+    d.x = 1;
+    cm_lst_apd(&l, &d);
+    d.x = 2;
+    cm_lst_apd(&src, &d);
+
+    ret = cm_lst_cat(&l, &src);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&l, (int []) {1, 2}, 2);
+
+    //splice at an invalid index
+    cm_errno = 0;
+    ret = cm_lst_splice(&l, 99, &src);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    //splice lists of different data sizes
+    cm_errno = 0;
+    ret = cm_lst_cat(&l, &other);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+
+    //splice a list into itself
+    cm_errno = 0;
+    ret = cm_lst_cat(&l, &l);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+
+    cm_del_lst(&src);
+    cm_del_lst(&other);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_lst_split() & cm_lst_split_n() [full fixture]
+START_TEST(test_lst_split) {
+
+    int ret;
+    cm_lst dst;
+    cm_lst_node * n;
+
+    cm_new_lst(&dst, sizeof(d));
+
+    //split in the middle (negative index)
+    ret = cm_lst_split(&l, -3, &dst);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&l, (int []) {0, 1, 2, 3, 4, 5, 6}, 7);
+    _assert_values(&dst, (int []) {7, 8, 9}, 3);
+
+    //split by node, appending to a non-empty list
+    n = l.head->next->next->next->next;
+    ret = cm_lst_split_n(&l, n, &dst);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&l, (int []) {0, 1, 2, 3}, 4);
+    _assert_values(&dst, (int []) {7, 8, 9, 4, 5, 6}, 6);
+
+    //split by node, near the head
+    ret = cm_lst_split_n(&l, l.head->next, &dst);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&l, (int []) {0}, 1);
+    _assert_values(&dst, (int []) {7, 8, 9, 4, 5, 6, 1, 2, 3}, 9);
+
+    //split off the head of a single node list
+    ret = cm_lst_split_n(&l, l.head, &dst);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&l, NULL, 0);
+    ck_assert_int_eq(dst.len, 10);
+
+    //split off the last node
+    ret = cm_lst_split(&dst, dst.len - 1, &l);
+    ck_assert_int_eq(ret, 0);
+    _assert_values(&l, (int []) {0}, 1);
+    ck_assert_int_eq(((data *) cm_lst_get_p(&dst, -1))->x, 3);
+
+    //split at an invalid index
+    cm_errno = 0;
+    ret = cm_lst_split(&l, 1, &dst);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    cm_del_lst(&dst);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_lst_sort() [empty fixture]
+START_TEST(test_lst_sort) {
+
+    cm_lst_node * nodes[TEST_LEN_FULL];
+    int values[TEST_LEN_FULL] = {5, 1003, 9, 2, 7, 3, 0, 8, 2003, 6};
+
+    //sort an empty and a single node list
+    cm_lst_sort(&l, _compare_data);
+    _assert_values(&l, NULL, 0);
+
+    d.x = 4;
+    cm_lst_apd(&l, &d);
+    cm_lst_sort(&l, _compare_data);
+    _assert_values(&l, (int []) {4}, 1);
+    cm_lst_emp(&l);
+
+    //sort two nodes
+    d.x = 1;
+    cm_lst_apd(&l, &d);
+    d.x = 0;
+    cm_lst_apd(&l, &d);
+    cm_lst_sort(&l, _compare_data);
+    _assert_values(&l, (int []) {0, 1}, 2);
+    cm_lst_emp(&l);
+
+    //sort a list whose length is not a power of two
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        d.x = values[i];
+        nodes[i] = cm_lst_apd(&l, &d);
+    }
+
+    cm_lst_get_p(&l, 5);
+    cm_lst_sort(&l, _compare_data);
+
+    //equal elements keep their order
+    _assert_values(&l, (int []) {0, 2, 1003, 3, 2003, 5, 6, 7, 8, 9}, 
+                   TEST_LEN_FULL);
+
+    //the nodes themselves are reused
+    ck_assert_ptr_eq(l.head, nodes[6]);
+    ck_assert_ptr_eq(l.head->prev, nodes[2]);
+
+    //indexing still works after the cursor was reset
+    ck_assert_int_eq(((data *) cm_lst_get_p(&l, 5))->x, 5);
+
+    //sort an already sorted list
+    cm_lst_sort(&l, _compare_data);
+    _assert_values(&l, (int []) {0, 2, 1003, 3, 2003, 5, 6, 7, 8, 9}, 
+                   TEST_LEN_FULL);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_lst_foreach() & cm_lst_foreach_rev() [full fixture]
+START_TEST(test_lst_foreach) {
+
+    int i;
+    cm_lst_node * node;
+
+    //visit every node in order
+    i = 0;
+    cm_lst_foreach(&l, node) {
+        ck_assert_int_eq(GET_NODE_DATA(node)->x, i);
+        ++i;
+    }
+    ck_assert_int_eq(i, TEST_LEN_FULL);
+
+    //visit every node in reverse order
+    i = TEST_LEN_FULL;
+    cm_lst_foreach_rev(&l, node) {
+        --i;
+        ck_assert_int_eq(GET_NODE_DATA(node)->x, i);
+    }
+    ck_assert_int_eq(i, 0);
+
+    //remove the current node while visiting
+    cm_lst_foreach(&l, node) {
+        if (GET_NODE_DATA(node)->x % 2) cm_lst_rem_n(&l, node);
+    }
+    _assert_values(&l, (int []) {0, 2, 4, 6, 8}, TEST_LEN_FULL / 2);
+
+    cm_lst_foreach_rev(&l, node) {
+        if (GET_NODE_DATA(node)->x != 4) cm_lst_rem_n(&l, node);
+    }
+    _assert_values(&l, (int []) {4}, 1);
+
+    //a single node list does not loop
+    i = 0;
+    cm_lst_foreach_rev(&l, node) ++i;
+    ck_assert_int_eq(i, 1);
+
+    //an empty list is not visited
+    cm_lst_emp(&l);
+    cm_lst_foreach(&l, node) ck_abort();
+    cm_lst_foreach_rev(&l, node) ck_abort();
+
+    return;
+
+} END_TEST
+
+
+
 /*
  *  --- [SUITE] ---
  */
@@ -1042,8 +1561,11 @@ Suite * lst_suite() {
 
     //test cases
     TCase * tc_new_lst;
+    TCase * tc_new_lst_inl;
+    TCase * tc_new_lst_arn;
     TCase * tc_del_lst;
     TCase * tc_lst_apd;
+    TCase * tc_lst_apd_slot;
     TCase * tc_lst_get;
     TCase * tc_lst_get_p;
     TCase * tc_lst_get_n;
@@ -1056,7 +1578,14 @@ Suite * lst_suite() {
     TCase * tc_lst_uln_n;
     TCase * tc_lst_rem;
     TCase * tc_lst_rem_n;
+    TCase * tc_lst_splice;
+    TCase * tc_lst_split;
+    TCase * tc_lst_sort;
     TCase * tc_lst_emp;
+    TCase * tc_lst_cursor;
+    TCase * tc_lst_foreach;
+    TCase * tc_lst_inl;
+    TCase * tc_lst_arn;
 
     Suite * s = suite_create("list");
     
@@ -1065,6 +1594,14 @@ Suite * lst_suite() {
     tc_new_lst = tcase_create("new_lst");
     tcase_add_test(tc_new_lst, test_new_lst);
     
+    //cm_new_lst_inl()
+    tc_new_lst_inl = tcase_create("new_lst_inl");
+    tcase_add_test(tc_new_lst_inl, test_new_lst_inl);
+
+    //cm_new_lst_arn()
+    tc_new_lst_arn = tcase_create("new_lst_arn");
+    tcase_add_test(tc_new_lst_arn, test_new_lst_arn);
+    
     //cm_del_lst()
     tc_del_lst = tcase_create("del_lst");
     tcase_add_checked_fixture(tc_del_lst, _setup_stub, NULL);
@@ -1075,6 +1612,11 @@ Suite * lst_suite() {
     tcase_add_checked_fixture(tc_lst_apd, _setup_emp, teardown);   
     tcase_add_test(tc_lst_apd, test_lst_apd);
 
+    //cm_lst_apd_slot()
+    tc_lst_apd_slot = tcase_create("list_apd_slot");
+    tcase_add_checked_fixture(tc_lst_apd_slot, _setup_emp, teardown);
+    tcase_add_test(tc_lst_apd_slot, test_lst_apd_slot);
+
     //cm_lst_get()
     tc_lst_get = tcase_create("list_get");
     tcase_add_checked_fixture(tc_lst_get, _setup_full, teardown);
@@ -1135,16 +1677,66 @@ Suite * lst_suite() {
     tcase_add_checked_fixture(tc_lst_rem_n, _setup_full, teardown);
     tcase_add_test(tc_lst_rem_n, test_lst_rem_n);
 
+    //cm_lst_splice() & cm_lst_cat()
+    tc_lst_splice = tcase_create("list_splice");
+    tcase_add_checked_fixture(tc_lst_splice, _setup_full, teardown);
+    tcase_add_test(tc_lst_splice, test_lst_splice);
+
+    //cm_lst_split() & cm_lst_split_n()
+    tc_lst_split = tcase_create("list_split");
+    tcase_add_checked_fixture(tc_lst_split, _setup_full, teardown);
+    tcase_add_test(tc_lst_split, test_lst_split);
+
+    //cm_lst_sort()
+    tc_lst_sort = tcase_create("list_sort");
+    tcase_add_checked_fixture(tc_lst_sort, _setup_emp, teardown);
+    tcase_add_test(tc_lst_sort, test_lst_sort);
+
     //cm_lst_emp()
     tc_lst_emp = tcase_create("list_emp");
     tcase_add_checked_fixture(tc_lst_emp, _setup_full, teardown);
     tcase_add_test(tc_lst_emp, test_lst_emp);
 
+    //traversal cursor
+    tc_lst_cursor = tcase_create("list_cursor");
+    tcase_add_checked_fixture(tc_lst_cursor, _setup_full, teardown);
+    tcase_add_test(tc_lst_cursor, test_lst_cursor);
+
+    //cm_lst_foreach() & cm_lst_foreach_rev()
+    tc_lst_foreach = tcase_create("list_foreach");
+    tcase_add_checked_fixture(tc_lst_foreach, _setup_full, teardown);
+    tcase_add_test(tc_lst_foreach, test_lst_foreach);
+
+    //inline lists, reusing the tests above
+    tc_lst_inl = tcase_create("list_inl");
+    tcase_add_checked_fixture(tc_lst_inl, _setup_full_inl, teardown);
+    tcase_add_test(tc_lst_inl, test_lst_get);
+    tcase_add_test(tc_lst_inl, test_lst_set);
+    tcase_add_test(tc_lst_inl, test_lst_ins);
+    tcase_add_test(tc_lst_inl, test_lst_uln);
+    tcase_add_test(tc_lst_inl, test_lst_rem);
+    tcase_add_test(tc_lst_inl, test_lst_rem_n);
+    tcase_add_test(tc_lst_inl, test_lst_emp);
+
+    //arena lists, reusing the tests above
+    tc_lst_arn = tcase_create("list_arn");
+    tcase_add_checked_fixture(tc_lst_arn, _setup_full_arn, teardown);
+    tcase_add_test(tc_lst_arn, test_lst_get);
+    tcase_add_test(tc_lst_arn, test_lst_set);
+    tcase_add_test(tc_lst_arn, test_lst_ins);
+    tcase_add_test(tc_lst_arn, test_lst_rem);
+    tcase_add_test(tc_lst_arn, test_lst_rem_n);
+    tcase_add_test(tc_lst_arn, test_lst_emp);
+    tcase_add_test(tc_lst_arn, test_lst_foreach);
+
 
     //add test cases to list suite
     suite_add_tcase(s, tc_new_lst);
+    suite_add_tcase(s, tc_new_lst_inl);
+    suite_add_tcase(s, tc_new_lst_arn);
     suite_add_tcase(s, tc_del_lst);
     suite_add_tcase(s, tc_lst_apd);
+    suite_add_tcase(s, tc_lst_apd_slot);
     suite_add_tcase(s, tc_lst_get);
     suite_add_tcase(s, tc_lst_get_p);
     suite_add_tcase(s, tc_lst_get_n);
@@ -1157,7 +1749,14 @@ Suite * lst_suite() {
     suite_add_tcase(s, tc_lst_uln_n);
     suite_add_tcase(s, tc_lst_rem);
     suite_add_tcase(s, tc_lst_rem_n);
+    suite_add_tcase(s, tc_lst_splice);
+    suite_add_tcase(s, tc_lst_split);
+    suite_add_tcase(s, tc_lst_sort);
     suite_add_tcase(s, tc_lst_emp);
+    suite_add_tcase(s, tc_lst_cursor);
+    suite_add_tcase(s, tc_lst_foreach);
+    suite_add_tcase(s, tc_lst_inl);
+    suite_add_tcase(s, tc_lst_arn);
 
     return s;
 }
@@ -0,0 +1,351 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+//system headers
+#include <unistd.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "test_data.h"
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/prbt.h"
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *      Persistent trees are tested through exported functions. Versions
+ *      are walked after changes to check both their structure and that
+ *      other versions were left as they were.
+ */
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//globals
+#define TEST_LEN 2000
+
+static cm_prbt t;
+static data d;
+
+
+
+static enum cm_rbt_side _compare(const void * b_1, const void * b_2) {
+
+    const data * d_1 = b_1, * d_2 = b_2;
+
+    if (d_1->x > d_2->x) return MORE;
+    if (d_1->x < d_2->x) return LESS;
+
+    return EQUAL;
+}
+
+
+
+//empty persistent tree setup
+static void _setup_emp() {
+
+    cm_new_prbt(&t, sizeof(d), sizeof(d), _compare);
+    d.x = 0;
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_prbt(&t);
+    d.x = -1;
+
+    return;
+}
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+/*
+ *  Check a subtree holds keys in (lo, hi), leans left, has no red node
+ *  with a red child, and is balanced. Returns its black height.
+ */
+
+static int _assert_node(const _prbt_node * node, const long lo, const long hi) {
+
+    int key, left_height, right_height;
+
+    if (node == NULL) return 1;
+
+    key = ((data *) node->mem)->x;
+    ck_assert_int_gt(key, lo);
+    ck_assert_int_lt(key, hi);
+    ck_assert_int_ge(node->refs, 1);
+
+    ck_assert(!PRBT_IS_RED(node->right));
+    if (node->colour == RED) ck_assert(!PRBT_IS_RED(node->left));
+
+    left_height = _assert_node(node->left, lo, key);
+    right_height = _assert_node(node->right, key, hi);
+    ck_assert_int_eq(left_height, right_height);
+
+    return left_height + (node->colour == BLACK ? 1 : 0);
+}
+
+
+
+//check the structure of a version, and that its data is mul times each key
+static void _assert_version(const cm_prbt * tree, const int len,
+                            const int mul) {
+
+    int count = 0, last = -1;
+    cm_prbt_iter iter;
+
+    ck_assert_int_eq(tree->size, len);
+    if (tree->root != NULL) ck_assert_int_eq(tree->root->colour, BLACK);
+    _assert_node(tree->root, -1, (long) TEST_LEN * 4);
+
+    cm_prbt_foreach(tree, iter) {
+        ck_assert_int_gt(((data *) iter.key)->x, last);
+        ck_assert_int_eq(((data *) iter.data)->x,
+                         ((data *) iter.key)->x * mul);
+        last = ((data *) iter.key)->x;
+        ++count;
+    }
+    ck_assert_int_eq(count, len);
+
+    return;
+}
+
+
+
+//set a key whose data is mul times the key
+static void _set(cm_prbt * tree, int key, int mul) {
+
+    data k = {.x = key}, e = {.x = key * mul};
+
+    ck_assert_int_eq(cm_prbt_set(tree, &k, &e), 0);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_prbt_set(), cm_prbt_get() & cm_prbt_rem() [empty fixture]
+START_TEST(test_prbt_set_rem) {
+
+    int ret;
+    data buf;
+
+    //look up a key in an empty tree
+    cm_errno = 0;
+    ret = cm_prbt_get(&t, &d, &buf);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //insert keys out of order
+    for (int i = 0; i < TEST_LEN; ++i) {
+        _set(&t, (i * 37) % TEST_LEN, 10);
+        if (i % 200 == 0) _assert_version(&t, i + 1, 10);
+    }
+    _assert_version(&t, TEST_LEN, 10);
+
+    //setting a present key replaces its data
+    for (int i = 0; i < TEST_LEN; ++i) _set(&t, i, -1);
+    _assert_version(&t, TEST_LEN, -1);
+
+    //remove a key that is not present
+    d.x = TEST_LEN;
+    cm_errno = 0;
+    ret = cm_prbt_rem(&t, &d);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //remove every third key out of order
+    for (int i = 0; i < TEST_LEN; ++i) {
+        d.x = (i * 37) % TEST_LEN;
+        if (d.x % 3 != 0) continue;
+        ret = cm_prbt_rem(&t, &d);
+        ck_assert_int_eq(ret, 0);
+        if (i % 200 == 0) _assert_version(&t, t.size, -1);
+    }
+    _assert_version(&t, TEST_LEN - ((TEST_LEN + 2) / 3), -1);
+
+    for (d.x = 0; d.x < TEST_LEN; ++d.x) {
+        ret = cm_prbt_get(&t, &d, &buf);
+        ck_assert_int_eq(ret, d.x % 3 ? 0 : -1);
+        if (!ret) ck_assert_int_eq(buf.x, -d.x);
+    }
+
+    //remove the rest from both ends
+    for (int i = 0; i < TEST_LEN / 2; ++i) {
+        d.x = i;
+        cm_prbt_rem(&t, &d);
+        d.x = TEST_LEN - 1 - i;
+        cm_prbt_rem(&t, &d);
+    }
+    _assert_version(&t, 0, -1);
+    ck_assert_ptr_null(t.root);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_prbt_snap() [empty fixture]
+START_TEST(test_prbt_snap) {
+
+    cm_prbt snap, snap_2;
+    data buf;
+
+    for (int i = 0; i < TEST_LEN; ++i) _set(&t, i, 10);
+
+    //a snapshot shares the whole tree
+    cm_prbt_snap(&t, &snap);
+    ck_assert_ptr_eq(snap.root, t.root);
+    ck_assert_int_eq(t.root->refs, 2);
+
+    //updating the greatest key copies only the right spine
+    _set(&t, TEST_LEN - 1, -1);
+    ck_assert_ptr_ne(t.root, snap.root);
+    ck_assert_ptr_eq(t.root->left, snap.root->left);
+    ck_assert_int_eq(t.root->left->refs, 2);
+
+    //change every key of the tree, leaving the snapshot as it was
+    for (int i = 0; i < TEST_LEN; ++i) _set(&t, i, -1);
+    for (d.x = 0; d.x < TEST_LEN; d.x += 2) cm_prbt_rem(&t, &d);
+    for (int i = TEST_LEN; i < TEST_LEN * 2; ++i) _set(&t, i, -1);
+
+    _assert_version(&snap, TEST_LEN, 10);
+    _assert_version(&t, TEST_LEN + TEST_LEN / 2, -1);
+
+    //snapshots are versions, so they may be updated and snapshotted too
+    cm_prbt_snap(&snap, &snap_2);
+    d.x = 0;
+    ck_assert_int_eq(cm_prbt_rem(&snap, &d), 0);
+    _assert_version(&snap, TEST_LEN - 1, 10);
+    _assert_version(&snap_2, TEST_LEN, 10);
+
+    ck_assert_int_eq(cm_prbt_get(&snap_2, &d, &buf), 0);
+    ck_assert_int_eq(buf.x, 0);
+    ck_assert_int_eq(cm_prbt_get(&snap, &d, &buf), -1);
+
+    //versions may be deleted in any order
+    cm_del_prbt(&snap);
+    _assert_version(&snap_2, TEST_LEN, 10);
+    cm_del_prbt(&snap_2);
+    _assert_version(&t, TEST_LEN + TEST_LEN / 2, -1);
+
+    return;
+
+} END_TEST
+
+
+
+//many versions of random updates [empty fixture]
+START_TEST(test_prbt_random) {
+
+    bool present[TEST_LEN] = {false}, was_present[TEST_LEN];
+    cm_prbt snap;
+    int len = 0, was_len, key;
+    unsigned int seed = 1;
+    data buf;
+
+    cm_prbt_snap(&t, &snap);
+    was_len = 0;
+    for (int i = 0; i < TEST_LEN; ++i) was_present[i] = false;
+
+    for (int round = 0; round < 20; ++round) {
+
+        for (int i = 0; i < TEST_LEN / 2; ++i) {
+
+            seed = seed * 1103515245 + 12345;
+            key = (int) ((seed >> 8) % TEST_LEN);
+            d.x = key;
+
+            if (present[key] && (seed & 1)) {
+                ck_assert_int_eq(cm_prbt_rem(&t, &d), 0);
+                present[key] = false;
+                --len;
+            } else {
+                if (!present[key]) ++len;
+                _set(&t, key, 10);
+                present[key] = true;
+            }
+        }
+
+        _assert_version(&t, len, 10);
+        _assert_version(&snap, was_len, 10);
+
+        for (d.x = 0; d.x < TEST_LEN; ++d.x) {
+            ck_assert_int_eq(cm_prbt_get(&snap, &d, &buf),
+                             was_present[d.x] ? 0 : -1);
+        }
+
+        //move the snapshot to the current version
+        cm_del_prbt(&snap);
+        cm_prbt_snap(&t, &snap);
+        was_len = len;
+        for (int i = 0; i < TEST_LEN; ++i) was_present[i] = present[i];
+    }
+
+    cm_del_prbt(&snap);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * prbt_suite() {
+
+    //test cases
+    TCase * tc_prbt_set_rem;
+    TCase * tc_prbt_snap;
+    TCase * tc_prbt_random;
+
+    Suite * s = suite_create("persistent rb_tree");
+
+
+    //cm_prbt_set(), cm_prbt_get() & cm_prbt_rem()
+    tc_prbt_set_rem = tcase_create("prbt_set_rem");
+    tcase_add_checked_fixture(tc_prbt_set_rem, _setup_emp, _teardown);
+    tcase_add_test(tc_prbt_set_rem, test_prbt_set_rem);
+
+    //cm_prbt_snap()
+    tc_prbt_snap = tcase_create("prbt_snap");
+    tcase_add_checked_fixture(tc_prbt_snap, _setup_emp, _teardown);
+    tcase_add_test(tc_prbt_snap, test_prbt_snap);
+
+    //many versions of random updates
+    tc_prbt_random = tcase_create("prbt_random");
+    tcase_add_checked_fixture(tc_prbt_random, _setup_emp, _teardown);
+    tcase_add_test(tc_prbt_random, test_prbt_random);
+
+
+    //add test cases to persistent red-black tree suite
+    suite_add_tcase(s, tc_prbt_set_rem);
+    suite_add_tcase(s, tc_prbt_snap);
+    suite_add_tcase(s, tc_prbt_random);
+
+    return s;
+}
@@ -0,0 +1,351 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+#include <pthread.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "test_data.h"
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/que.h"
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *      Queues are tested through exported functions, first from a single
+ *      thread and then from many producers and consumers at once.
+ */
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//element pushed by producer threads
+typedef struct {
+
+    int producer;
+    int seq;
+
+} que_data;
+
+
+//globals
+#define TEST_LEN_FULL 100
+#define TEST_PRODUCERS 8
+#define TEST_CONSUMERS 4
+#define TEST_PUSHES 20000
+
+static cm_mpsc sq;
+static cm_mpmc mq;
+
+static int consumed;
+
+
+
+static void _setup_mpsc() {
+
+    int ret = cm_new_mpsc(&sq, sizeof(que_data));
+    ck_assert_int_eq(ret, 0);
+
+    return;
+}
+
+
+
+static void _teardown_mpsc() {
+
+    cm_del_mpsc(&sq);
+
+    return;
+}
+
+
+
+static void _setup_mpmc() {
+
+    int ret = cm_new_mpmc(&mq, sizeof(que_data));
+    ck_assert_int_eq(ret, 0);
+    consumed = 0;
+
+    return;
+}
+
+
+
+static void _teardown_mpmc() {
+
+    cm_del_mpmc(&mq);
+
+    return;
+}
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static void * _mpsc_producer(void * arg) {
+
+    que_data e = {.producer = (int) (long) arg};
+
+    for (e.seq = 0; e.seq < TEST_PUSHES; ++e.seq) {
+        cm_mpsc_push(&sq, &e);
+    }
+
+    return NULL;
+}
+
+
+
+static void * _mpmc_producer(void * arg) {
+
+    que_data e = {.producer = (int) (long) arg};
+
+    for (e.seq = 0; e.seq < TEST_PUSHES; ++e.seq) {
+        cm_mpmc_push(&mq, &e);
+    }
+
+    return NULL;
+}
+
+
+
+//pop until every element was consumed, checking per-producer ordering
+static void * _mpmc_consumer(void * arg) {
+
+    que_data e;
+    int last_seq[TEST_PRODUCERS];
+    long popped = 0;
+
+    (void) arg;
+
+    for (int i = 0; i < TEST_PRODUCERS; ++i) last_seq[i] = -1;
+
+    while (__atomic_load_n(&consumed, __ATOMIC_RELAXED)
+           < TEST_PRODUCERS * TEST_PUSHES) {
+
+        if (cm_mpmc_pop(&mq, &e)) continue;
+
+        //a consumer sees each producer's elements in the order pushed
+        if (e.seq <= last_seq[e.producer]) return (void *) -1;
+        last_seq[e.producer] = e.seq;
+
+        __atomic_add_fetch(&consumed, 1, __ATOMIC_RELAXED);
+        popped++;
+    }
+
+    return (void *) popped;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_mpsc_push() & cm_mpsc_pop() [mpsc fixture]
+START_TEST(test_mpsc) {
+
+    int ret;
+    que_data e;
+
+    //pop from an empty queue
+    cm_errno = 0;
+    ret = cm_mpsc_pop(&sq, &e);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_EMPTY);
+
+    //elements come out in the order they were pushed
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        e.seq = i;
+        ret = cm_mpsc_push(&sq, &e);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        ret = cm_mpsc_pop(&sq, &e);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(e.seq, i);
+    }
+
+    ret = cm_mpsc_pop(&sq, &e);
+    ck_assert_int_eq(ret, -1);
+
+    //leave elements behind for cm_del_mpsc() to free
+    cm_mpsc_push(&sq, &e);
+
+    return;
+
+} END_TEST
+
+
+
+//concurrent producers [mpsc fixture]
+START_TEST(test_mpsc_threads) {
+
+    int ret;
+    que_data e;
+    pthread_t producers[TEST_PRODUCERS];
+    int last_seq[TEST_PRODUCERS];
+
+    for (long i = 0; i < TEST_PRODUCERS; ++i) {
+        last_seq[i] = -1;
+        ret = pthread_create(&producers[i], NULL, _mpsc_producer, (void *) i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    //consume every element, checking per-producer ordering
+    for (int i = 0; i < TEST_PRODUCERS * TEST_PUSHES; ) {
+
+        if (cm_mpsc_pop(&sq, &e)) continue;
+
+        ck_assert_int_eq(e.seq, last_seq[e.producer] + 1);
+        last_seq[e.producer] = e.seq;
+        ++i;
+    }
+
+    for (int i = 0; i < TEST_PRODUCERS; ++i) {
+        pthread_join(producers[i], NULL);
+        ck_assert_int_eq(last_seq[i], TEST_PUSHES - 1);
+    }
+
+    ret = cm_mpsc_pop(&sq, &e);
+    ck_assert_int_eq(ret, -1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_mpmc_push() & cm_mpmc_pop() [mpmc fixture]
+START_TEST(test_mpmc) {
+
+    int ret;
+    que_data e;
+
+    //pop from an empty queue
+    cm_errno = 0;
+    ret = cm_mpmc_pop(&mq, &e);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_EMPTY);
+
+    //elements come out in the order they were pushed
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        e.seq = i;
+        ret = cm_mpmc_push(&mq, &e);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        ret = cm_mpmc_pop(&mq, &e);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(e.seq, i);
+    }
+
+    ret = cm_mpmc_pop(&mq, &e);
+    ck_assert_int_eq(ret, -1);
+
+    //leave elements behind for cm_del_mpmc() to free
+    cm_mpmc_push(&mq, &e);
+
+    return;
+
+} END_TEST
+
+
+
+//concurrent producers and consumers [mpmc fixture]
+START_TEST(test_mpmc_threads) {
+
+    int ret;
+    void * popped;
+    long total = 0;
+    pthread_t producers[TEST_PRODUCERS], consumers[TEST_CONSUMERS];
+
+    for (long i = 0; i < TEST_CONSUMERS; ++i) {
+        ret = pthread_create(&consumers[i], NULL, _mpmc_consumer, NULL);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (long i = 0; i < TEST_PRODUCERS; ++i) {
+        ret = pthread_create(&producers[i], NULL, _mpmc_producer, (void *) i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (int i = 0; i < TEST_PRODUCERS; ++i) {
+        pthread_join(producers[i], NULL);
+    }
+
+    //every element is popped exactly once
+    for (int i = 0; i < TEST_CONSUMERS; ++i) {
+        pthread_join(consumers[i], &popped);
+        ck_assert_int_ne((long) popped, -1);
+        total += (long) popped;
+    }
+
+    ck_assert_int_eq(total, TEST_PRODUCERS * TEST_PUSHES);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * que_suite() {
+
+    //test cases
+    TCase * tc_mpsc;
+    TCase * tc_mpsc_threads;
+    TCase * tc_mpmc;
+    TCase * tc_mpmc_threads;
+
+    Suite * s = suite_create("queue");
+
+
+    //cm_mpsc_push() & cm_mpsc_pop()
+    tc_mpsc = tcase_create("mpsc");
+    tcase_add_checked_fixture(tc_mpsc, _setup_mpsc, _teardown_mpsc);
+    tcase_add_test(tc_mpsc, test_mpsc);
+
+    //concurrent producers
+    tc_mpsc_threads = tcase_create("mpsc_threads");
+    tcase_add_checked_fixture(tc_mpsc_threads, _setup_mpsc, _teardown_mpsc);
+    tcase_set_timeout(tc_mpsc_threads, 30);
+    tcase_add_test(tc_mpsc_threads, test_mpsc_threads);
+
+    //cm_mpmc_push() & cm_mpmc_pop()
+    tc_mpmc = tcase_create("mpmc");
+    tcase_add_checked_fixture(tc_mpmc, _setup_mpmc, _teardown_mpmc);
+    tcase_add_test(tc_mpmc, test_mpmc);
+
+    //concurrent producers and consumers
+    tc_mpmc_threads = tcase_create("mpmc_threads");
+    tcase_add_checked_fixture(tc_mpmc_threads, _setup_mpmc, _teardown_mpmc);
+    tcase_set_timeout(tc_mpmc_threads, 30);
+    tcase_add_test(tc_mpmc_threads, test_mpmc_threads);
+
+
+    //add test cases to queue suite
+    suite_add_tcase(s, tc_mpsc);
+    suite_add_tcase(s, tc_mpsc_threads);
+    suite_add_tcase(s, tc_mpmc);
+    suite_add_tcase(s, tc_mpmc_threads);
+
+    return s;
+}
@@ -1,11 +1,14 @@
 //standard library
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 
 //system headers
 #include <time.h>
 #include <unistd.h>
 #include <limits.h>
+#include <stdint.h>
+#include <pthread.h>
 
 //external libraries
 #include <check.h>
@@ -39,6 +42,15 @@
 static cm_rbt t;
 static data d;
 
+//keys whose byte order is their numeric order
+typedef struct {
+    cm_byte b[4];
+} be_key;
+
+//type-specialised trees
+CM_RBT_DEFINE(irbt, int, data, CM_RBT_CMP_NUM)
+CM_RBT_DEFINE(brbt, be_key, data, CM_RBT_CMP_MEM)
+
 
 
 enum cm_rbt_side compare(const void * b_1, const void * b_2) {
@@ -68,6 +80,41 @@ static void _setup_emp() {
 
 
 
+//empty inline red-black tree setup
+static void _setup_emp_inl() {
+
+    cm_new_rbt_inl(&t, sizeof(d), sizeof(d), compare);
+    d.x = 0;
+
+    return;
+}
+
+
+
+//empty arena red-black tree setup
+static void _setup_emp_arn() {
+
+    int ret = cm_new_rbt_arn(&t, sizeof(d), sizeof(d), compare);
+    ck_assert_int_eq(ret, 0);
+    d.x = 0;
+
+    return;
+}
+
+
+
+//concurrent tree setup
+static void _setup_emp_sync() {
+
+    int ret = cm_new_rbt_sync(&t, sizeof(d), sizeof(d), compare);
+    ck_assert_int_eq(ret, 0);
+    d.x = 0;
+
+    return;
+}
+
+
+
 //initialiser of stub node
 static void _setup_stub_node(cm_rbt_node * node, cm_rbt_node * left, 
                              cm_rbt_node * right, cm_rbt_node * parent, 
@@ -77,9 +124,9 @@ static void _setup_stub_node(cm_rbt_node * node, cm_rbt_node * left,
     //set relevant fields
     node->left = left;
     node->right = right;
-    node->parent = parent;
-    node->parent_side = parent_side;
-    node->colour = colour;
+    RBT_SET_PARENT(node, parent);
+    RBT_SET_SIDE(node, parent_side);
+    RBT_SET_COLOUR(node, colour);
 
     return;
 }
@@ -221,7 +268,7 @@ static void _assert_node(cm_rbt_node * n, int n_data,
         
         if (left_data != DATA_NULL) {
             ck_assert_ptr_nonnull(n->left);
-            ck_assert(n->left->parent_side == LESS);
+            ck_assert(cm_rbt_parent_side(n->left) == LESS);
             temp_data = GET_NODE_DATA(n->left);
             ck_assert_int_eq(temp_data->x, left_data);
     
@@ -235,7 +282,7 @@ static void _assert_node(cm_rbt_node * n, int n_data,
     
         if (right_data != DATA_NULL) {
             ck_assert_ptr_nonnull(n->right);
-            ck_assert(n->right->parent_side == MORE);
+            ck_assert(cm_rbt_parent_side(n->right) == MORE);
             temp_data = GET_NODE_DATA(n->right);
             ck_assert_int_eq(temp_data->x, right_data);
     
@@ -248,21 +295,21 @@ static void _assert_node(cm_rbt_node * n, int n_data,
     if (parent_data != DATA_NOCHECK) {
     
         if (parent_data != DATA_NULL) {
-            ck_assert_ptr_nonnull(n->parent);
+            ck_assert_ptr_nonnull(cm_rbt_parent(n));
         
-            if (n->parent_side == LESS) {
-                ck_assert_ptr_eq(n->parent->left, n);
+            if (cm_rbt_parent_side(n) == LESS) {
+                ck_assert_ptr_eq(cm_rbt_parent(n)->left, n);
             }
 
-            if (n->parent_side == MORE) {
-                ck_assert_ptr_eq(n->parent->right, n);
+            if (cm_rbt_parent_side(n) == MORE) {
+                ck_assert_ptr_eq(cm_rbt_parent(n)->right, n);
             }
 
-            temp_data = GET_NODE_DATA(n->parent);
+            temp_data = GET_NODE_DATA(cm_rbt_parent(n));
             ck_assert_int_eq(temp_data->x, parent_data);
     
         } else {
-            ck_assert_ptr_null(n->parent);
+            ck_assert_ptr_null(cm_rbt_parent(n));
             ck_assert_ptr_eq(t.root, n);
         }
     }
@@ -299,7 +346,7 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
     ck_assert_ptr_nonnull(n);
     temp_data = GET_NODE_DATA(n);
     ck_assert_int_eq(temp_data->x, n_data); 
-    if (n->parent_side == ROOT) ck_assert_ptr_eq(t.root, n);
+    if (cm_rbt_parent_side(n) == ROOT) ck_assert_ptr_eq(t.root, n);
 
     
     //parent
@@ -307,15 +354,15 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         
         ck_assert_ptr_nonnull(fix_data->parent);
 
-        if (n->parent_side == LESS) {
+        if (cm_rbt_parent_side(n) == LESS) {
             ck_assert_ptr_eq(fix_data->parent->left, n);
         }
 
-        if (n->parent_side == MORE) {
+        if (cm_rbt_parent_side(n) == MORE) {
             ck_assert_ptr_eq(fix_data->parent->right, n);
         }
 
-        if (fix_data->parent->parent_side == ROOT) {
+        if (cm_rbt_parent_side(fix_data->parent) == ROOT) {
             ck_assert_ptr_eq(t.root, fix_data->parent);
             ck_assert_ptr_null(fix_data->grandparent);
             ck_assert_ptr_null(fix_data->uncle);
@@ -339,19 +386,19 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         ck_assert_ptr_nonnull(fix_data->parent);
         ck_assert_ptr_nonnull(fix_data->grandparent);
 
-        if (fix_data->parent->parent_side == LESS) {
+        if (cm_rbt_parent_side(fix_data->parent) == LESS) {
             ck_assert_ptr_eq(fix_data->grandparent->left, fix_data->parent);
         }
 
-        if (fix_data->parent->parent_side == MORE) {
+        if (cm_rbt_parent_side(fix_data->parent) == MORE) {
             ck_assert_ptr_eq(fix_data->grandparent->right, fix_data->parent);
         }
 
-        if (fix_data->grandparent->parent_side == ROOT) {
+        if (cm_rbt_parent_side(fix_data->grandparent) == ROOT) {
             ck_assert_ptr_eq(t.root, fix_data->grandparent);
         } 
 
-        ck_assert(fix_data->parent->parent_side != ROOT);
+        ck_assert(cm_rbt_parent_side(fix_data->parent) != ROOT);
         temp_data = GET_NODE_DATA(fix_data->grandparent);
         ck_assert_int_eq(temp_data->x, grandparent_data);
     
@@ -370,15 +417,15 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         ck_assert_ptr_nonnull(fix_data->parent);
         ck_assert_ptr_nonnull(fix_data->grandparent);
 
-        if (fix_data->uncle->parent_side == LESS) {
+        if (cm_rbt_parent_side(fix_data->uncle) == LESS) {
             ck_assert_ptr_eq(fix_data->grandparent->left, fix_data->uncle);
         }
 
-        if (fix_data->uncle->parent_side == MORE) {
+        if (cm_rbt_parent_side(fix_data->uncle) == MORE) {
             ck_assert_ptr_eq(fix_data->grandparent->right, fix_data->uncle);
         }
 
-        ck_assert(fix_data->uncle->parent_side != ROOT);
+        ck_assert(cm_rbt_parent_side(fix_data->uncle) != ROOT);
         temp_data = GET_NODE_DATA(fix_data->uncle);
         ck_assert_int_eq(temp_data->x, uncle_data);
 
@@ -394,15 +441,15 @@ static void _assert_fix_data(struct _rbt_fix_data * fix_data,
         ck_assert_ptr_nonnull(fix_data->sibling);
         ck_assert_ptr_nonnull(fix_data->parent);
     
-        if (fix_data->sibling->parent_side == LESS) {
+        if (cm_rbt_parent_side(fix_data->sibling) == LESS) {
             ck_assert_ptr_eq(fix_data->parent->left, fix_data->sibling);
         }
 
-        if (fix_data->sibling->parent_side == MORE) {
+        if (cm_rbt_parent_side(fix_data->sibling) == MORE) {
             ck_assert_ptr_eq(fix_data->parent->right, fix_data->sibling);
         }
 
-        ck_assert(fix_data->sibling->parent_side != ROOT);
+        ck_assert(cm_rbt_parent_side(fix_data->sibling) != ROOT);
         temp_data = GET_NODE_DATA(fix_data->sibling);
         ck_assert_int_eq(temp_data->x, sibling_data);
     
@@ -488,7 +535,7 @@ START_TEST(test__new_node) {
     ck_assert_ptr_nonnull(n);
     ck_assert_ptr_nonnull(n->key);
     ck_assert_ptr_nonnull(n->data);
-    ck_assert(n->colour == RED);
+    ck_assert(cm_rbt_colour(n) == RED);
 
     _rbt_del_node(n);
 
@@ -875,9 +922,9 @@ START_TEST(test__ins_case_1) {
 
     //setup
     node = t.root->right->left->right;
-    t.root->right->colour = BLACK;
-    t.root->right->left->colour = RED;
-    t.root->right->right->colour = RED;
+    RBT_SET_COLOUR(t.root->right, BLACK);
+    RBT_SET_COLOUR(t.root->right->left, RED);
+    RBT_SET_COLOUR(t.root->right->right, RED);
     _set_fix_data(&f_data, t.root->right->left, t.root->right, 
                   t.root->right->right, NULL);
     
@@ -885,9 +932,9 @@ START_TEST(test__ins_case_1) {
     _rbt_ins_case_1(&t, &node, &f_data);
     
     //assert result
-    ck_assert(t.root->right->colour == RED);
-    ck_assert(t.root->right->left->colour == BLACK);
-    ck_assert(t.root->right->right->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right) == RED);
+    ck_assert(cm_rbt_colour(t.root->right->left) == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->right) == BLACK);
     
     ck_assert_ptr_eq(node, t.root->right);
 
@@ -905,14 +952,14 @@ START_TEST(test__ins_case_2) {
 
     //setup
     node = t.root->left;
-    t.root->colour = RED;
+    RBT_SET_COLOUR(t.root, RED);
     _set_fix_data(&f_data, t.root, NULL, NULL, NULL);
 
     //run test
     _rbt_ins_case_2(&t, &node, &f_data);
 
     //assert result
-    ck_assert(t.root->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root) == BLACK);
 
     return;
 
@@ -928,9 +975,9 @@ START_TEST(test__ins_case_3) {
 
     //setup
     node = t.root->right->left->right;
-    t.root->right->left->colour = RED;
-    t.root->right->colour = BLACK;
-    t.root->right->right->colour = BLACK;
+    RBT_SET_COLOUR(t.root->right->left, RED);
+    RBT_SET_COLOUR(t.root->right, BLACK);
+    RBT_SET_COLOUR(t.root->right->right, BLACK);
     _set_fix_data(&f_data, t.root->right->left,
                   t.root->right, t.root->right->right, NULL);
 
@@ -960,10 +1007,10 @@ START_TEST(test__ins_case_4) {
     //setup
     t.root->right->left->left = t.root->right->left->right;
     t.root->right->left->right = NULL;
-    t.root->right->left->left->parent_side = LESS;
+    RBT_SET_SIDE(t.root->right->left->left, LESS);
     node = t.root->right->left->left;
-    t.root->right->colour = BLACK;
-    t.root->right->left->colour = BLACK;
+    RBT_SET_COLOUR(t.root->right, BLACK);
+    RBT_SET_COLOUR(t.root->right->left, BLACK);
     _set_fix_data(&f_data, t.root->right->left, t.root->right,
                   t.root->right->right, NULL);
 
@@ -978,8 +1025,8 @@ START_TEST(test__ins_case_4) {
     
     ck_assert_ptr_eq(node, t.root->right->left);
     
-    ck_assert(t.root->right->colour == BLACK);
-    ck_assert(t.root->right->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right) == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->right) == RED);
 
     return;
 
@@ -995,9 +1042,9 @@ START_TEST(test__rem_case_1) {
     
     //setup
     node = t.root->right->right;
-    t.root->right->left->right->colour = BLACK;
-    t.root->right->left->colour = RED;
-    t.root->right->colour = BLACK;
+    RBT_SET_COLOUR(t.root->right->left->right, BLACK);
+    RBT_SET_COLOUR(t.root->right->left, RED);
+    RBT_SET_COLOUR(t.root->right, BLACK);
     _set_fix_data(&f_data, t.root->right, t.root, 
                   t.root->left, t.root->right->left);
     
@@ -1011,8 +1058,8 @@ START_TEST(test__rem_case_1) {
     _assert_node(t.root->right->right->left, 6, DATA_NULL, DATA_NULL, 2);
     _assert_node(t.root->right->right->right, 5, DATA_NULL, DATA_NULL, 2);
     
-    ck_assert(t.root->right->colour == BLACK);
-    ck_assert(t.root->right->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right) == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->right) == RED);
 
     return;
 } END_TEST
@@ -1027,7 +1074,7 @@ START_TEST(test__rem_case_2) {
 
     //setup
     node = t.root->right->right;
-    t.root->right->left->right->colour = BLACK;
+    RBT_SET_COLOUR(t.root->right->left->right, BLACK);
     _set_fix_data(&f_data, t.root->right, t.root,
                   t.root->left, t.root->right->left);    
 
@@ -1035,7 +1082,7 @@ START_TEST(test__rem_case_2) {
     _rbt_rem_case_2(&t, &node, &f_data);
 
     //assert result
-    ck_assert(t.root->right->left->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right->left) == RED);
 
     //t.root->right->left->left = NULL;
     return;
@@ -1066,8 +1113,8 @@ START_TEST(test__rem_case_3) {
 
     ck_assert_ptr_eq(node, t.root->right->right);
     
-    ck_assert(t.root->right->left->colour == BLACK);
-    ck_assert(t.root->right->left->left->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right->left) == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->left->left) == RED);
 
     return;
 
@@ -1085,7 +1132,7 @@ START_TEST(test__rem_case_4) {
     node = t.root->right->right;
     t.root->right->left->left = t.root->right->left->right;
     t.root->right->left->right = NULL;
-    t.root->right->left->left->parent_side = LESS;
+    RBT_SET_SIDE(t.root->right->left->left, LESS);
     _set_fix_data(&f_data, t.root->right, t.root,
                   t.root->left, t.root->right->left);
 
@@ -1101,9 +1148,9 @@ START_TEST(test__rem_case_4) {
 
     ck_assert_ptr_eq(node, t.root);
 
-    ck_assert(t.root->right->colour == RED);
-    ck_assert(t.root->right->left->colour == BLACK);
-    ck_assert(t.root->right->right->colour = BLACK);
+    ck_assert(cm_rbt_colour(t.root->right) == RED);
+    ck_assert(cm_rbt_colour(t.root->right->left) == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->right) == BLACK);
 
     return;
 
@@ -1132,7 +1179,7 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 20);
     
     _assert_node(t.root, 20, DATA_NULL, DATA_NULL, DATA_NULL);
-    ck_assert(t.root->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root) == BLACK);
 
 
     //case 2
@@ -1141,9 +1188,9 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 25);
     
     _assert_node(t.root, 20, DATA_NULL, 25, DATA_NULL);
-    ck_assert(t.root->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root) == BLACK);
     _assert_node(t.root->right, 25, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right) == RED);
 
     
     //case 4
@@ -1152,11 +1199,11 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 30);
     
     _assert_node(t.root, 25, 20, 30, DATA_NULL);
-    ck_assert(t.root->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root) == BLACK);
     _assert_node(t.root->left, 20, DATA_NULL, DATA_NULL, 25);
-    ck_assert(t.root->left->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->left) == RED);
     _assert_node(t.root->right, 30, DATA_NULL, DATA_NULL, 25);
-    ck_assert(t.root->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right) == RED);
 
 
     //case 1
@@ -1165,10 +1212,10 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 22);
 
     _assert_node(t.root->left, 20, DATA_NULL, 22, 25);
-    ck_assert(t.root->left->colour == BLACK);
-    ck_assert(t.root->right->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->left) == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right) == BLACK);
     _assert_node(t.root->left->right, 22, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->left->right) == RED);
 
 
     //case 3, case 4
@@ -1177,11 +1224,11 @@ START_TEST(test_rbt_set) {
     _assert_node_fast(ret, 21);
     
     _assert_node(t.root->left, 21, 20, 22, 25);
-    ck_assert(t.root->left->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->left) == BLACK);
     _assert_node(t.root->left->left, 20, DATA_NULL, DATA_NULL, 21);
-    ck_assert(t.root->left->left->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->left->left) == RED);
     _assert_node(t.root->left->right, 22, DATA_NULL, DATA_NULL, 21);
-    ck_assert(t.root->left->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->left->right) == RED);
 
     return;
     
@@ -1189,6 +1236,44 @@ START_TEST(test_rbt_set) {
 
 
 
+//cm_rbt_set_slot [empty fixture]
+START_TEST(test_rbt_set_slot) {
+
+    data * slot;
+
+    //new key, root insert
+    d.x = 20;
+    slot = cm_rbt_set_slot(&t, &d.x);
+    ck_assert_ptr_nonnull(slot);
+    slot->x = 20;
+    _assert_node(t.root, 20, DATA_NULL, DATA_NULL, DATA_NULL);
+
+    //new key, fix applied
+    d.x = 25;
+    slot = cm_rbt_set_slot(&t, &d.x);
+    ck_assert_ptr_nonnull(slot);
+    slot->x = 25;
+
+    d.x = 30;
+    slot = cm_rbt_set_slot(&t, &d.x);
+    ck_assert_ptr_nonnull(slot);
+    slot->x = 30;
+    _assert_node(t.root, 25, 20, 30, DATA_NULL);
+    ck_assert_int_eq(t.size, 3);
+
+    //existing key returns the existing data
+    d.x = 25;
+    slot = cm_rbt_set_slot(&t, &d.x);
+    ck_assert_ptr_eq(slot, t.root->data);
+    ck_assert_int_eq(slot->x, 25);
+    ck_assert_int_eq(t.size, 3);
+
+    return;
+
+} END_TEST
+
+
+
 //cm_rbt_rem [sorted stub fixture]
 START_TEST(test_rbt_rem) {
 
@@ -1208,11 +1293,11 @@ START_TEST(test_rbt_rem) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root->right, 50, 40, 55, 20);
-    ck_assert(t.root->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right) == RED);
     _assert_node(t.root->right->left, 40, DATA_NULL, 45, 50);
-    ck_assert(t.root->right->left->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->left) == BLACK);
     _assert_node(t.root->right->right, 55, DATA_NULL, DATA_NULL, 50);
-    ck_assert(t.root->right->right->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->right) == BLACK);
     _assert_node(t.root->right->left->right, 45, DATA_NULL, DATA_NULL, 40);
 
 
@@ -1222,13 +1307,13 @@ START_TEST(test_rbt_rem) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root, 20, 10, 45, DATA_NULL);
-    ck_assert(t.root->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root) == BLACK);
     _assert_node(t.root->right, 45, 40, 50, 20);
-    ck_assert(t.root->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->right) == RED);
     _assert_node(t.root->right->left, 40, DATA_NULL, DATA_NULL, 45);
-    ck_assert(t.root->right->left->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->left) == BLACK);
     _assert_node(t.root->right->right, 50, DATA_NULL, DATA_NULL, 45);
-    ck_assert(t.root->right->right->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right->right) == BLACK);
 
 
     //case 1 & 2 (red parent)
@@ -1245,13 +1330,13 @@ START_TEST(test_rbt_rem) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root, 45, 20, 50, DATA_NULL);
-    ck_assert(t.root->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root) == BLACK);
     _assert_node(t.root->left, 20, DATA_NULL, 40, 45);
-    ck_assert(t.root->left->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->left) == BLACK);
     _assert_node(t.root->right, 50, DATA_NULL, DATA_NULL, 45);
-    ck_assert(t.root->right->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right) == BLACK);
     _assert_node(t.root->left->right, 40, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->left->right) == RED);
 
 
     //2 children (root, no fixes)
@@ -1266,15 +1351,15 @@ START_TEST(test_rbt_rem) {
     ck_assert_int_eq(ret, 0);
 
     _assert_node(t.root, 40, 20, 50, DATA_NULL);
-    ck_assert(t.root->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root) == BLACK);
     _assert_node(t.root->left, 20, 15, 30, 40);
-    ck_assert(t.root->left->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->left) == RED);
     _assert_node(t.root->right, 50, DATA_NULL, DATA_NULL, 40);
-    ck_assert(t.root->right->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->right) == BLACK);
     _assert_node(t.root->left->left, 15, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->left->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->left->left) == BLACK);
     _assert_node(t.root->left->right, 30, DATA_NULL, DATA_NULL, 20);
-    ck_assert(t.root->left->right->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->left->right) == BLACK);
 
     //2 children (non-root, fixes)
     d.x = 20;
@@ -1283,9 +1368,9 @@ START_TEST(test_rbt_rem) {
 
     _assert_node(t.root, 40, 15, 50, DATA_NULL);
     _assert_node(t.root->left, 15, DATA_NULL, 30, 40);
-    ck_assert(t.root->left->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->left) == BLACK);
     _assert_node(t.root->left->right, 30, DATA_NULL, DATA_NULL, 15);
-    ck_assert(t.root->left->right->colour == RED);
+    ck_assert(cm_rbt_colour(t.root->left->right) == RED);
 
     //1 child
     d.x = 15;
@@ -1294,7 +1379,7 @@ START_TEST(test_rbt_rem) {
 
     _assert_node(t.root, 40, 30, 50, DATA_NULL);
     _assert_node(t.root->left, 30, DATA_NULL, DATA_NULL, 40);
-    ck_assert(t.root->left->colour == BLACK);
+    ck_assert(cm_rbt_colour(t.root->left) == BLACK);
     
     return;
     
@@ -1318,7 +1403,7 @@ START_TEST(test_rbt_uln) {
     ret = cm_rbt_uln(&t, &d.x);
     ck_assert_ptr_nonnull(ret);
 
-    ck_assert_ptr_null(ret->parent);
+    ck_assert_ptr_null(cm_rbt_parent(ret));
     ck_assert_ptr_null(ret->left);
     ck_assert_ptr_null(ret->right);
 
@@ -1345,183 +1430,1538 @@ START_TEST(test_rbt_emp) {
 
 
 
-//cm_del_rbt_node [no fixture]
-START_TEST(test_del_rbt_node) {
+//cm_rbt_foreach() & cm_rbt_foreach_rev() [empty fixture]
+START_TEST(test_rbt_foreach) {
+
+    int i;
+    cm_rbt_node * node;
+
+    //an empty tree is not visited
+    cm_rbt_foreach(&t, node) ck_abort();
+    cm_rbt_foreach_rev(&t, node) ck_abort();
+
+    //insert keys out of order
+    for (i = 0; i < 100; ++i) {
+        d.x = (i * 37) % 100;
+        cm_rbt_set(&t, &d.x, &d);
+    }
+
+    //visit every node in key order
+    i = 0;
+    cm_rbt_foreach(&t, node) {
+        ck_assert_int_eq(((data *) node->key)->x, i);
+        ++i;
+    }
+    ck_assert_int_eq(i, 100);
+
+    //visit every node in reverse key order
+    cm_rbt_foreach_rev(&t, node) {
+        --i;
+        ck_assert_int_eq(((data *) node->key)->x, i);
+    }
+    ck_assert_int_eq(i, 0);
+
+    //remove the current node while visiting
+    cm_rbt_foreach(&t, node) {
+        if (((data *) node->key)->x % 2) cm_rbt_rem(&t, node->key);
+    }
+    ck_assert_int_eq(t.size, 50);
+
+    cm_rbt_foreach(&t, node) {
+        ck_assert_int_eq(((data *) node->key)->x, i);
+        i += 2;
+    }
+    ck_assert_int_eq(i, 100);
+
+    cm_rbt_foreach_rev(&t, node) {
+        if (((data *) node->key)->x >= 50) cm_rbt_rem(&t, node->key);
+    }
+    ck_assert_int_eq(t.size, 25);
+    ck_assert_int_eq(((data *) cm_rbt_last_n(&t)->key)->x, 48);
+
+    return;
 
-    /*
-     *  Using ASAN to check for leaks here.
-     */
-        
-    //setup test
-    cm_rbt_node * n = malloc(sizeof(cm_rbt_node));
-    n->key = malloc(sizeof(d));
-    n->data = malloc(sizeof(d));
-    
-    //run test
-    cm_del_rbt_node(n);
-    
 } END_TEST
 
 
 
-Suite * rbt_suite() {
+//assert the key of a navigation result, -1 if none was found
+static void _assert_nav(cm_rbt_node * node, const int key) {
 
-    //test cases
-    TCase * tc_new_cm_rbt;
-    TCase * tc_del_cm_rbt;
+    if (key == -1) {
+        ck_assert_ptr_null(node);
+        ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+    } else {
+        ck_assert_ptr_nonnull(node);
+        ck_assert_int_eq(((data *) node->key)->x, key);
+    }
 
-    //internal test cases for debug builds
-    #ifdef DEBUG
-    TCase * tc__new_node;
-    TCase * tc__del_node;
-    TCase * tc__left_rotate;
-    TCase * tc__right_rotate;
-    TCase * tc__transplant;
-    TCase * tc__left_max;
-    TCase * tc__get_colour;
-    TCase * tc__populate_fix_data;
-    TCase * tc__determine_ins_case;
-    TCase * tc__determine_rem_case;
-    TCase * tc__ins_case_1;
-    TCase * tc__ins_case_2;
-    TCase * tc__ins_case_3;
-    TCase * tc__ins_case_4;
-    TCase * tc__rem_case_1;
-    TCase * tc__rem_case_2;
-    TCase * tc__rem_case_3;
-    TCase * tc__rem_case_4;
-    #endif
+    return;
+}
 
-    //test cases (cont.)
-    TCase * tc_rbt_set;
-    TCase * tc_rbt_rem;
-    TCase * tc_rbt_uln;
-    TCase * tc_rbt_emp;
-    TCase * tc_del_rbt_node;
 
-    Suite * s = suite_create("rb_tree");
 
+//cm_rbt_floor(), cm_rbt_ceil(), cm_rbt_next() & cm_rbt_prev() [empty fixture]
+START_TEST(test_rbt_nav) {
 
-    //tc_new_cm_rbt()
-    tc_new_cm_rbt = tcase_create("new_cm_rbt");
-    tcase_add_test(tc_new_cm_rbt, test_new_cm_rbt);
+    int i;
+    cm_rbt_node * node;
 
-    //tc_del_cm_rbt()
-    tc_del_cm_rbt = tcase_create("del_cm_rbt");
-    tcase_add_checked_fixture(tc_del_cm_rbt, _setup_stub, NULL);
-    tcase_add_test(tc_del_cm_rbt, test_del_cm_rbt);
+    //an empty tree has no neighbours
+    d.x = 0;
+    _assert_nav(cm_rbt_floor(&t, &d), -1);
+    _assert_nav(cm_rbt_ceil(&t, &d), -1);
+    cm_rbt_foreach_range(&t, &d, &d, node) ck_abort();
+
+    //insert the even keys out of order
+    for (i = 0; i < 50; ++i) {
+        d.x = ((i * 37) % 50) * 2;
+        cm_rbt_set(&t, &d, &d);
+    }
 
-    #ifdef DEBUG
-    //tc__new_node()
-    tc__new_node = tcase_create("_new_node");
-    tcase_add_test(tc__new_node, test__new_node);
-    
-    //tc__del_node()
-    tc__del_node = tcase_create("_del_node");
-    tcase_add_test(tc__del_node, test__del_node);
+    //present keys
+    d.x = 50;
+    _assert_nav(cm_rbt_floor(&t, &d), 50);
+    _assert_nav(cm_rbt_ceil(&t, &d), 50);
+    _assert_nav(cm_rbt_next(&t, &d), 52);
+    _assert_nav(cm_rbt_prev(&t, &d), 48);
+
+    //absent keys
+    d.x = 51;
+    _assert_nav(cm_rbt_floor(&t, &d), 50);
+    _assert_nav(cm_rbt_ceil(&t, &d), 52);
+    _assert_nav(cm_rbt_next(&t, &d), 52);
+    _assert_nav(cm_rbt_prev(&t, &d), 50);
+
+    //past either end
+    d.x = -1;
+    _assert_nav(cm_rbt_floor(&t, &d), -1);
+    _assert_nav(cm_rbt_ceil(&t, &d), 0);
+    d.x = 0;
+    _assert_nav(cm_rbt_prev(&t, &d), -1);
+    d.x = 98;
+    _assert_nav(cm_rbt_next(&t, &d), -1);
+    d.x = 99;
+    _assert_nav(cm_rbt_floor(&t, &d), 98);
+    _assert_nav(cm_rbt_ceil(&t, &d), -1);
+
+    //visit the keys in [11, 21)
+    i = 12;
+    cm_rbt_foreach_range(&t, &(data) {11}, &(data) {21}, node) {
+        ck_assert_int_eq(((data *) node->key)->x, i);
+        i += 2;
+    }
+    ck_assert_int_eq(i, 22);
 
-    //tc__left_rotate()
-    tc__left_rotate = tcase_create("_left_rotate");
-    tcase_add_checked_fixture(tc__left_rotate, _setup_stub, _teardown);
-    tcase_add_test(tc__left_rotate, test__left_rotate);
+    //the upper bound is excluded
+    i = 10;
+    cm_rbt_foreach_range(&t, &(data) {10}, &(data) {20}, node) {
+        ck_assert_int_eq(((data *) node->key)->x, i);
+        i += 2;
+    }
+    ck_assert_int_eq(i, 20);
 
-    //tc__right_rotate()
-    tc__right_rotate = tcase_create("_right_rotate");
-    tcase_add_checked_fixture(tc__right_rotate, _setup_stub, _teardown);
-    tcase_add_test(tc__right_rotate, test__right_rotate);
-    
-    //tc__transplant()
-    tc__transplant = tcase_create("_transplant");
-    tcase_add_checked_fixture(tc__transplant, _setup_stub, _teardown);
-    tcase_add_test(tc__transplant, test__transplant);
-    
-    //tc__left_max()
-    tc__left_max = tcase_create("_left_max");
-    tcase_add_checked_fixture(tc__left_max, _setup_stub, _teardown);
-    tcase_add_test(tc__left_max, test__left_max);
+    //ranges holding no keys
+    cm_rbt_foreach_range(&t, &(data) {11}, &(data) {12}, node) ck_abort();
+    cm_rbt_foreach_range(&t, &(data) {99}, &(data) {200}, node) ck_abort();
 
-    //tc__get_colour()
-    tc__get_colour = tcase_create("_get_colour");
-    tcase_add_checked_fixture(tc__get_colour, _setup_stub, _teardown);
-    tcase_add_test(tc__get_colour, test__get_colour);
+    return;
 
-    //tc__populate_fix_data()
-    tc__populate_fix_data = tcase_create("_populate_fix_data");
-    tcase_add_checked_fixture(tc__populate_fix_data, _setup_stub, _teardown);
-    tcase_add_test(tc__populate_fix_data, test__populate_fix_data);
+} END_TEST
 
-    //tc__determine_ins_case()
-    tc__determine_ins_case = tcase_create("_determine_ins_case");
-    tcase_add_test(tc__determine_ins_case, test__determine_ins_case);
 
-    //tc__determine_rem_case()
-    tc__determine_rem_case = tcase_create("_determine_rem_case");
-    tcase_add_test(tc__determine_rem_case, test__determine_rem_case);
 
-    //tc__ins_case_1
-    tc__ins_case_1 = tcase_create("_ins_case_1");
-    tcase_add_checked_fixture(tc__ins_case_1, _setup_stub, _teardown);
-    tcase_add_test(tc__ins_case_1, test__ins_case_1);
+//cm_new_rbt_ost(), cm_rbt_rank() & cm_rbt_select() [no fixture]
+START_TEST(test_rbt_ost) {
 
-    //tc__ins_case_2
-    tc__ins_case_2 = tcase_create("_ins_case_2");
-    tcase_add_checked_fixture(tc__ins_case_2, _setup_stub, _teardown);
-    tcase_add_test(tc__ins_case_2, test__ins_case_2);
-    
-    //tc__ins_case_3
-    tc__ins_case_3 = tcase_create("_ins_case_3");
-    tcase_add_checked_fixture(tc__ins_case_3, _setup_stub, _teardown);
-    tcase_add_test(tc__ins_case_3, test__ins_case_3);
-    
-    //tc__ins_case_4
-    tc__ins_case_4 = tcase_create("_ins_case_4");
-    tcase_add_checked_fixture(tc__ins_case_4, _setup_stub, _teardown);
-    tcase_add_test(tc__ins_case_4, test__ins_case_4);
+    int ret;
+    cm_rbt_node * node;
 
-    //tc__rem_case_1
-    tc__rem_case_1 = tcase_create("_rem_case_1");
-    tcase_add_checked_fixture(tc__rem_case_1, _setup_stub, _teardown);
-    tcase_add_test(tc__rem_case_1, test__rem_case_1);
-    
-    //tc__rem_case_2
-    tc__rem_case_2 = tcase_create("_rem_case_2");
-    tcase_add_checked_fixture(tc__rem_case_2, _setup_stub, _teardown);
-    tcase_add_test(tc__rem_case_2, test__rem_case_2);
-    
-    //tc__rem_case_3
-    tc__rem_case_3 = tcase_create("_rem_case_3");
-    tcase_add_checked_fixture(tc__rem_case_3, _setup_stub, _teardown);
-    tcase_add_test(tc__rem_case_3, test__rem_case_3);
-    
-    //tc__rem_case_4
-    tc__rem_case_4 = tcase_create("_rem_case_4");
-    tcase_add_checked_fixture(tc__rem_case_4, _setup_stub, _teardown);
-    tcase_add_test(tc__rem_case_4, test__rem_case_4);
-    #endif
+    //order statistics need subtree sizes
+    cm_new_rbt(&t, sizeof(d), sizeof(d), compare);
+    cm_errno = 0;
+    ck_assert_int_eq(cm_rbt_rank(&t, &d), -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+    cm_del_rbt(&t);
 
-    //tc_rbt_set
-    tc_rbt_set = tcase_create("rb_tree_set");
-    tcase_add_checked_fixture(tc_rbt_set, _setup_emp, _teardown);
-    tcase_add_test(tc_rbt_set, test_rbt_set);
+    cm_new_rbt_ost(&t, sizeof(d), sizeof(d), compare);
 
-    //tc_rbt_rem
-    tc_rbt_rem = tcase_create("rb_tree_rem");
-    tcase_add_checked_fixture(tc_rbt_rem, _setup_sorted_stub, _teardown);
-    tcase_add_test(tc_rbt_rem, test_rbt_rem);
+    cm_errno = 0;
+    ck_assert_ptr_null(cm_rbt_select(&t, 0));
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
 
-    //tc_rbt_uln
-    tc_rbt_uln = tcase_create("rb_tree_uln");
-    tcase_add_checked_fixture(tc_rbt_uln, _setup_sorted_stub, _teardown);
-    tcase_add_test(tc_rbt_uln, test_rbt_uln);
+    //insert the even keys out of order
+    for (int i = 0; i < 500; ++i) {
+        d.x = ((i * 37) % 500) * 2;
+        cm_rbt_set(&t, &d, &d);
+    }
 
-    //tc_rbt_emp
-    tc_rbt_emp = tcase_create("rb_tree_emp");
-    tcase_add_checked_fixture(tc_rbt_emp, _setup_stub, _teardown);
-    tcase_add_test(tc_rbt_emp, test_rbt_emp);
+    for (int i = 0; i < 500; ++i) {
 
-    //tc_del_rbt_node
-    tc_del_rbt_node = tcase_create("del_rbt_node");
-    tcase_add_test(tc_del_rbt_node, test_del_rbt_node);
+        node = cm_rbt_select(&t, i);
+        ck_assert_int_eq(((data *) node->key)->x, i * 2);
+
+        //present and absent keys
+        d.x = i * 2;
+        ck_assert_int_eq(cm_rbt_rank(&t, &d), i);
+        d.x = i * 2 + 1;
+        ck_assert_int_eq(cm_rbt_rank(&t, &d), i + 1);
+    }
+
+    //negative indeces count from the greatest key
+    ck_assert_int_eq(((data *) cm_rbt_select(&t, -1)->key)->x, 998);
+    cm_errno = 0;
+    ck_assert_ptr_null(cm_rbt_select(&t, 500));
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    //remove the keys that are multiples of 4
+    for (d.x = 0; d.x < 1000; d.x += 4) {
+        ret = cm_rbt_rem(&t, &d);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (int i = 0; i < 250; ++i) {
+        node = cm_rbt_select(&t, i);
+        ck_assert_int_eq(((data *) node->key)->x, i * 4 + 2);
+        ck_assert_int_eq(cm_rbt_rank(&t, node->key), i);
+    }
+
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//sum the data of a subtree
+static void _sum_aug(void * aug, const void * key, const void * node_data,
+                     const void * left_aug, const void * right_aug) {
+
+    long sum = ((const data *) node_data)->x;
+
+    (void) key;
+
+    if (left_aug != NULL) sum += *(const long *) left_aug;
+    if (right_aug != NULL) sum += *(const long *) right_aug;
+
+    *(long *) aug = sum;
+
+    return;
+}
+
+
+
+//cm_new_rbt_aug() & cm_rbt_upd_n() [no fixture]
+START_TEST(test_rbt_aug) {
+
+    long sum = 0;
+    data * slot;
+
+    cm_new_rbt_aug(&t, sizeof(d), sizeof(d), compare, sizeof(long), _sum_aug);
+
+    //the root holds the sum of every node
+    for (int i = 0; i < 200; ++i) {
+        d.x = (i * 37) % 200;
+        cm_rbt_set(&t, &d, &d);
+        sum += d.x;
+        ck_assert_int_eq(*(long *) cm_rbt_aug(&t, t.root), sum);
+    }
+
+    //replacing data updates the sums
+    d.x = 10;
+    cm_rbt_set(&t, &d, &(data) {1010});
+    sum += 1000;
+    ck_assert_int_eq(*(long *) cm_rbt_aug(&t, t.root), sum);
+
+    //data changed in place is accounted for once its node is updated
+    slot = cm_rbt_set_slot(&t, &(data) {500});
+    slot->x = 500;
+    cm_rbt_upd_n(&t, cm_rbt_get_n(&t, &(data) {500}));
+    sum += 500;
+    ck_assert_int_eq(*(long *) cm_rbt_aug(&t, t.root), sum);
+
+    //removals
+    for (d.x = 0; d.x < 200; d.x += 3) {
+        cm_rbt_rem(&t, &d);
+        sum -= d.x == 10 ? 1010 : d.x;
+        ck_assert_int_eq(*(long *) cm_rbt_aug(&t, t.root), sum);
+    }
+
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//check the red-black properties of a subtree and return its black height
+static int _assert_black_height(const cm_rbt_node * node) {
+
+    int left_height, right_height;
+
+    if (node == NULL) return 1;
+
+    if (node->left != NULL) {
+        ck_assert_ptr_eq(cm_rbt_parent(node->left), node);
+        ck_assert_int_eq(cm_rbt_parent_side(node->left), LESS);
+        ck_assert_int_eq(compare(node->left->key, node->key), LESS);
+    }
+    if (node->right != NULL) {
+        ck_assert_ptr_eq(cm_rbt_parent(node->right), node);
+        ck_assert_int_eq(cm_rbt_parent_side(node->right), MORE);
+        ck_assert_int_eq(compare(node->right->key, node->key), MORE);
+    }
+
+    //red nodes have no red children
+    if (cm_rbt_colour(node) == RED) {
+        ck_assert(node->left == NULL || cm_rbt_colour(node->left) == BLACK);
+        ck_assert(node->right == NULL || cm_rbt_colour(node->right) == BLACK);
+    }
+
+    left_height = _assert_black_height(node->left);
+    right_height = _assert_black_height(node->right);
+    ck_assert_int_eq(left_height, right_height);
+
+    return left_height + (cm_rbt_colour(node) == BLACK ? 1 : 0);
+}
+
+
+
+//cm_rbt_from_sorted() [empty fixture]
+START_TEST(test_rbt_from_sorted) {
+
+    int ret, i;
+    data keys[300];
+    cm_rbt_node * node;
+
+    for (i = 0; i < 300; ++i) keys[i].x = i * 2;
+
+    //every size up to a few full levels
+    for (int n = 0; n <= 70; ++n) {
+
+        ret = cm_rbt_from_sorted(&t, keys, keys, n);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(t.size, n);
+        if (n > 0) ck_assert_int_eq(cm_rbt_colour(t.root), BLACK);
+        _assert_black_height(t.root);
+
+        i = 0;
+        cm_rbt_foreach(&t, node) {
+            ck_assert_int_eq(((data *) node->key)->x, i * 2);
+            ck_assert_int_eq(((data *) node->data)->x, i * 2);
+            ++i;
+        }
+        ck_assert_int_eq(i, n);
+    }
+
+    //the built tree takes insertions and removals like any other
+    ret = cm_rbt_from_sorted(&t, keys, keys, 300);
+    ck_assert_int_eq(ret, 0);
+
+    for (d.x = 1; d.x < 600; d.x += 4) cm_rbt_set(&t, &d, &d);
+    for (d.x = 0; d.x < 600; d.x += 3) cm_rbt_rem(&t, &d);
+    _assert_black_height(t.root);
+
+    //keys out of order or repeated are rejected, leaving the tree as it was
+    i = t.size;
+    keys[10].x = keys[9].x;
+    cm_errno = 0;
+    ret = cm_rbt_from_sorted(&t, keys, keys, 300);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ORDER);
+    ck_assert_int_eq(t.size, i);
+
+    return;
+
+} END_TEST
+
+
+
+//create an empty tree of the same kind as another
+static void _new_like(cm_rbt * tree, const cm_rbt * like) {
+
+    if (like->aug != NULL) {
+        cm_new_rbt_aug(tree, like->key_sz, like->data_sz, like->compare,
+                       like->aug_sz, like->aug);
+    } else if (like->mode == CM_RBT_INLINE) {
+        cm_new_rbt_inl(tree, like->key_sz, like->data_sz, like->compare);
+    } else {
+        cm_new_rbt(tree, like->key_sz, like->data_sz, like->compare);
+    }
+
+    return;
+}
+
+
+
+/*
+ *  Check a tree is balanced and holds exactly the keys in [0, len) marked 
+ *  present. Unless sign is 0, the data of each key must be sign * key.
+ */
+
+static void _assert_keys(const cm_rbt * tree, const bool * present, 
+                         const int len, const int sign) {
+
+    int count = 0, expected = 0, key = -1;
+    cm_rbt_node * node;
+
+    if (tree->root != NULL) {
+        ck_assert_int_eq(cm_rbt_colour(tree->root), BLACK);
+        ck_assert_int_eq(cm_rbt_parent_side(tree->root), ROOT);
+    }
+    _assert_black_height(tree->root);
+
+    cm_rbt_foreach(tree, node) {
+        ck_assert_int_gt(((data *) node->key)->x, key);
+        key = ((data *) node->key)->x;
+        ck_assert(key >= 0 && key < len && present[key]);
+        if (sign != 0) ck_assert_int_eq(((data *) node->data)->x, key * sign);
+        ++count;
+    }
+
+    for (int i = 0; i < len; ++i) expected += present[i] ? 1 : 0;
+    ck_assert_int_eq(count, expected);
+    ck_assert_int_eq(tree->size, expected);
+
+    return;
+}
+
+
+
+//insert the keys in [0, len) marked present, with data sign * key
+static void _set_keys(cm_rbt * tree, const bool * present, 
+                      const int len, const int sign) {
+
+    data e;
+
+    for (int i = 0; i < len; ++i) {
+        if (!present[i]) continue;
+        d.x = i;
+        e.x = i * sign;
+        cm_rbt_set(tree, &d, &e);
+    }
+
+    return;
+}
+
+
+
+//cm_rbt_split() & cm_rbt_join() [empty fixture]
+START_TEST(test_rbt_split_join) {
+
+    int ret;
+    bool present[1000], left[1000], right[1000];
+    cm_rbt other;
+    int keys[] = {-1, 0, 1, 2, 499, 500, 998, 999, 1000};
+
+    _new_like(&other, &t);
+
+    //split an empty tree
+    d.x = 5;
+    ret = cm_rbt_split(&t, &d, &other);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(t.size + other.size, 0);
+
+    //even keys only, so splits fall both on and between keys
+    for (int i = 0; i < 1000; ++i) present[i] = i % 2 == 0;
+    _set_keys(&t, present, 1000, 1);
+
+    for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); ++k) {
+
+        for (int i = 0; i < 1000; ++i) {
+            left[i] = present[i] && i < keys[k];
+            right[i] = present[i] && i >= keys[k];
+        }
+
+        d.x = keys[k];
+        ret = cm_rbt_split(&t, &d, &other);
+        ck_assert_int_eq(ret, 0);
+        _assert_keys(&t, left, 1000, 1);
+        _assert_keys(&other, right, 1000, 1);
+
+        //joining the halves restores the tree and empties the other
+        ret = cm_rbt_join(&t, &other);
+        ck_assert_int_eq(ret, 0);
+        _assert_keys(&t, present, 1000, 1);
+        ck_assert_ptr_null(other.root);
+        ck_assert_int_eq(other.size, 0);
+    }
+
+    //join trees of very different heights, in both directions
+    d.x = 1;
+    ret = cm_rbt_split(&t, &d, &other);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(t.size, 1);
+    ret = cm_rbt_join(&t, &other);
+    ck_assert_int_eq(ret, 0);
+    _assert_keys(&t, present, 1000, 1);
+
+    d.x = 998;
+    ret = cm_rbt_split(&t, &d, &other);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(other.size, 1);
+    ret = cm_rbt_join(&t, &other);
+    ck_assert_int_eq(ret, 0);
+    _assert_keys(&t, present, 1000, 1);
+
+    //the trees are left as they were if the keys overlap
+    d.x = 3;
+    cm_rbt_set(&other, &d, &d);
+    cm_errno = 0;
+    ret = cm_rbt_join(&t, &other);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_ORDER);
+    ck_assert_int_eq(other.size, 1);
+    _assert_keys(&t, present, 1000, 1);
+
+    //a tree can not be joined with itself
+    cm_errno = 0;
+    ret = cm_rbt_join(&t, &t);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+
+    cm_del_rbt(&other);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_rbt_union(), cm_rbt_intersect() & cm_rbt_diff() [empty fixture]
+START_TEST(test_rbt_set_ops) {
+
+    int ret;
+    unsigned int seed = 1;
+    bool a[1000], b[1000], expected[1000];
+    cm_rbt other;
+
+    //pairs of sizes, including empty and very uneven trees
+    int sizes[][2] = {{0, 0}, {0, 300}, {300, 0}, {1, 1000}, 
+                      {1000, 1}, {20, 900}, {500, 500}, {900, 900}};
+
+    _new_like(&other, &t);
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (int op = 0; op < 3; ++op) {
+
+            //draw each key into either set with the set's chance
+            for (int i = 0; i < 1000; ++i) {
+                seed = seed * 1103515245 + 12345;
+                a[i] = (int) ((seed >> 8) % 1000) < sizes[s][0];
+                seed = seed * 1103515245 + 12345;
+                b[i] = (int) ((seed >> 8) % 1000) < sizes[s][1];
+            }
+
+            //the data of each tree tells them apart
+            _set_keys(&t, a, 1000, 1);
+            _set_keys(&other, b, 1000, -1);
+
+            switch (op) {
+
+                case 0:
+                    for (int i = 0; i < 1000; ++i) expected[i] = a[i] || b[i];
+                    ret = cm_rbt_union(&t, &other);
+                    break;
+
+                case 1:
+                    for (int i = 0; i < 1000; ++i) expected[i] = a[i] && b[i];
+                    ret = cm_rbt_intersect(&t, &other);
+                    break;
+
+                default:
+                    for (int i = 0; i < 1000; ++i) expected[i] = a[i] && !b[i];
+                    ret = cm_rbt_diff(&t, &other);
+                    break;
+
+            } //end switch
+
+            ck_assert_int_eq(ret, 0);
+            _assert_keys(&t, expected, 1000, 0);
+            ck_assert_ptr_null(other.root);
+            ck_assert_int_eq(other.size, 0);
+
+            //keys present in both trees keep the data of the first
+            for (int i = 0; i < 1000; ++i) {
+                if (!expected[i]) continue;
+                d.x = i;
+                ck_assert_int_eq(((data *) cm_rbt_get_p(&t, &d))->x, 
+                                 a[i] ? i : -i);
+            }
+
+            cm_rbt_emp(&t);
+        }
+    }
+
+    cm_del_rbt(&other);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_rbt_rem_range() [empty fixture]
+START_TEST(test_rbt_rem_range) {
+
+    int ret;
+    bool present[1000];
+    data lo, hi;
+    int ranges[][3] = {{100, 200, 100}, {150, 300, 100}, {300, 300, 0}, 
+                       {500, 400, 0}, {900, 5000, 100}, {-10, 5, 5}, 
+                       {601, 602, 1}, {601, 602, 0}};
+
+    //remove from an empty tree
+    d.x = 0;
+    ret = cm_rbt_rem_range(&t, &d, &d);
+    ck_assert_int_eq(ret, 0);
+
+    for (int i = 0; i < 1000; ++i) present[i] = true;
+    _set_keys(&t, present, 1000, 1);
+
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); ++r) {
+
+        lo.x = ranges[r][0];
+        hi.x = ranges[r][1];
+        ret = cm_rbt_rem_range(&t, &lo, &hi);
+        ck_assert_int_eq(ret, ranges[r][2]);
+
+        for (int i = ranges[r][0]; i < ranges[r][1]; ++i) {
+            if (i >= 0 && i < 1000) present[i] = false;
+        }
+        _assert_keys(&t, present, 1000, 1);
+    }
+
+    //the tree takes insertions after a range is removed
+    for (int i = 100; i < 300; ++i) present[i] = true;
+    _set_keys(&t, present, 1000, 1);
+    _assert_keys(&t, present, 1000, 1);
+
+    //remove every key
+    lo.x = -1;
+    hi.x = 1000;
+    ret = cm_rbt_rem_range(&t, &lo, &hi);
+    ck_assert_int_eq(ret, 1000 - 5 - 100 - 1);
+    ck_assert_ptr_null(t.root);
+    ck_assert_int_eq(t.size, 0);
+
+    return;
+
+} END_TEST
+
+
+
+//split, join & set operations on order statistic trees [no fixture]
+START_TEST(test_rbt_split_join_ost) {
+
+    int ret;
+    bool present[600], odd[600];
+    cm_rbt other;
+
+    cm_new_rbt_ost(&t, sizeof(d), sizeof(d), compare);
+    _new_like(&other, &t);
+
+    for (int i = 0; i < 600; ++i) {
+        present[i] = i < 400;
+        odd[i] = i % 2 == 1;
+    }
+    _set_keys(&t, present, 600, 1);
+
+    //subtree sizes stay correct as nodes move between trees
+    d.x = 150;
+    ret = cm_rbt_split(&t, &d, &other);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(t.size, 150);
+    ck_assert_int_eq(other.size, 250);
+    ck_assert_int_eq(RBT_SUB_SIZE(&other, other.root), 250);
+    ck_assert_int_eq(((data *) cm_rbt_select(&other, 0)->key)->x, 150);
+    ck_assert_int_eq(cm_rbt_rank(&other, &d), 0);
+
+    ret = cm_rbt_join(&t, &other);
+    ck_assert_int_eq(ret, 0);
+    for (int i = 0; i < 400; ++i) {
+        ck_assert_int_eq(((data *) cm_rbt_select(&t, i)->key)->x, i);
+    }
+
+    //only trees of the same kind exchange nodes
+    cm_del_rbt(&other);
+    cm_new_rbt(&other, sizeof(d), sizeof(d), compare);
+    cm_errno = 0;
+    ret = cm_rbt_union(&t, &other);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+    cm_del_rbt(&other);
+
+    //keep the odd keys below 400
+    _new_like(&other, &t);
+    _set_keys(&other, odd, 600, 1);
+    ret = cm_rbt_intersect(&t, &other);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(RBT_SUB_SIZE(&t, t.root), 200);
+    for (int i = 0; i < 200; ++i) {
+        ck_assert_int_eq(((data *) cm_rbt_select(&t, i)->key)->x, i * 2 + 1);
+    }
+
+    cm_del_rbt(&other);
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_rbt_get_hint() & cm_rbt_set_hint() [empty fixture]
+START_TEST(test_rbt_hint) {
+
+    data e;
+    cm_rbt_node * node, * hint = NULL;
+
+    //insert ascending keys, each next to the last
+    for (d.x = 0; d.x < 400; d.x += 2) {
+        node = cm_rbt_set_hint(&t, hint, &d, &d);
+        ck_assert_ptr_nonnull(node);
+        ck_assert_int_eq(((data *) node->key)->x, d.x);
+        hint = node;
+    }
+    ck_assert_int_eq(t.size, 200);
+    _assert_black_height(t.root);
+
+    //insert descending keys between them
+    for (d.x = 399; d.x > 0; d.x -= 4) {
+        hint = cm_rbt_set_hint(&t, hint, &d, &d);
+        ck_assert_ptr_nonnull(hint);
+    }
+    ck_assert_int_eq(t.size, 300);
+    _assert_black_height(t.root);
+
+    //from any hint, every key is found exactly as from the root
+    cm_rbt_foreach(&t, hint) {
+        for (d.x = -1; d.x <= 400; ++d.x) {
+            cm_errno = 0;
+            node = cm_rbt_get_hint(&t, hint, &d);
+            ck_assert_ptr_eq(node, cm_rbt_get_n(&t, &d));
+            if (node == NULL) ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+        }
+    }
+
+    //setting a present key through a hint updates its data
+    hint = cm_rbt_first_n(&t);
+    d.x = 200;
+    e.x = -200;
+    node = cm_rbt_set_hint(&t, hint, &d, &e);
+    ck_assert_int_eq(((data *) node->data)->x, -200);
+    ck_assert_int_eq(t.size, 300);
+
+    //a NULL hint searches from the root
+    ck_assert_ptr_eq(cm_rbt_get_hint(&t, NULL, &d), node);
+
+    return;
+
+} END_TEST
+
+
+
+#define TEST_SYNC_THREADS 8
+#define TEST_SYNC_KEYS 4000
+
+//insert a range of keys, flip the sign of their data, then remove the evens
+static void * _sync_writer(void * arg) {
+
+    data key, val;
+    int base = (int) (long) arg * TEST_SYNC_KEYS;
+
+    for (int i = 0; i < TEST_SYNC_KEYS; ++i) {
+        key.x = val.x = base + i;
+        if (cm_rbt_set_sync(&t, &key, &val)) return (void *) -1;
+    }
+
+    for (int i = 0; i < TEST_SYNC_KEYS; ++i) {
+        key.x = base + i;
+        val.x = -key.x;
+        if (cm_rbt_set_sync(&t, &key, &val)) return (void *) -1;
+    }
+
+    for (int i = 0; i < TEST_SYNC_KEYS; i += 2) {
+        key.x = base + i;
+        if (cm_rbt_rem_sync(&t, &key)) return (void *) -1;
+    }
+
+    return NULL;
+}
+
+
+
+//look keys up while writers run, checking found data matches the key
+static void * _sync_reader(void * arg) {
+
+    data key, buf;
+
+    (void) arg;
+
+    for (int round = 0; round < 4; ++round) {
+        for (key.x = 0; key.x < TEST_SYNC_KEYS * 2; ++key.x) {
+            if (cm_rbt_get_sync(&t, &key, &buf) == 0
+                && buf.x != key.x && buf.x != -key.x) return (void *) -1;
+        }
+    }
+
+    return NULL;
+}
+
+
+
+//cm_rbt_get_sync(), cm_rbt_set_sync() & cm_rbt_rem_sync() [sync fixture]
+START_TEST(test_rbt_sync) {
+
+    int ret;
+    void * status;
+    data buf;
+    pthread_t writers[2], readers[TEST_SYNC_THREADS];
+
+    //a single thread sees its own writes
+    cm_errno = 0;
+    ret = cm_rbt_get_sync(&t, &d, &buf);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    d.x = 5;
+    ck_assert_int_eq(cm_rbt_set_sync(&t, &d, &d), 0);
+    ck_assert_int_eq(cm_rbt_get_sync(&t, &d, &buf), 0);
+    ck_assert_int_eq(buf.x, 5);
+    ck_assert_int_eq(cm_rbt_rem_sync(&t, &d), 0);
+
+    cm_errno = 0;
+    ck_assert_int_eq(cm_rbt_rem_sync(&t, &d), -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //two writers and many readers at once
+    for (long i = 0; i < 2; ++i) {
+        ret = pthread_create(&writers[i], NULL, _sync_writer, (void *) i);
+        ck_assert_int_eq(ret, 0);
+    }
+    for (int i = 0; i < TEST_SYNC_THREADS; ++i) {
+        ret = pthread_create(&readers[i], NULL, _sync_reader, NULL);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        pthread_join(writers[i], &status);
+        ck_assert_ptr_null(status);
+    }
+    for (int i = 0; i < TEST_SYNC_THREADS; ++i) {
+        pthread_join(readers[i], &status);
+        ck_assert_ptr_null(status);
+    }
+
+    //exactly the odd keys remain, with their final data
+    ck_assert_int_eq(t.size, TEST_SYNC_KEYS);
+    _assert_black_height(t.root);
+
+    for (d.x = 0; d.x < TEST_SYNC_KEYS * 2; ++d.x) {
+        ret = cm_rbt_get_sync(&t, &d, &buf);
+        ck_assert_int_eq(ret, d.x % 2 ? 0 : -1);
+        if (ret == 0) ck_assert_int_eq(buf.x, -d.x);
+    }
+
+    return;
+
+} END_TEST
+
+
+
+//assert that a concurrent tree rejected a plain mutator
+static void _assert_mismatch(const int failed) {
+
+    ck_assert(failed);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+    cm_errno = 0;
+
+    return;
+}
+
+
+
+//plain mutators on a concurrent tree [sync fixture]
+START_TEST(test_rbt_sync_plain) {
+
+    int i;
+    data keys[2];
+    cm_rbt_node * node;
+
+    for (d.x = 0; d.x < 10; ++d.x) cm_rbt_set_sync(&t, &d, &d);
+    d.x = 5;
+    node = cm_rbt_get_n(&t, &d);
+    ck_assert_ptr_nonnull(node);
+
+    //every plain mutator is rejected and leaves the tree alone
+    keys[0].x = 20;
+    keys[1].x = 21;
+    d.x = 15;
+    cm_errno = 0;
+    _assert_mismatch(cm_rbt_set(&t, &d, &d) == NULL);
+    _assert_mismatch(cm_rbt_set_hint(&t, node, &d, &d) == NULL);
+    _assert_mismatch(cm_rbt_set_slot(&t, &d) == NULL);
+    _assert_mismatch(cm_rbt_ins_at(&t, node, MORE, &d, &d) == NULL);
+    _assert_mismatch(cm_rbt_from_sorted(&t, keys, keys, 2) == -1);
+
+    d.x = 5;
+    _assert_mismatch(cm_rbt_rem(&t, &d) == -1);
+    _assert_mismatch(cm_rbt_rem_n(&t, node) == -1);
+    _assert_mismatch(cm_rbt_rem_range(&t, &keys[0], &keys[1]) == -1);
+    _assert_mismatch(cm_rbt_uln(&t, &d) == NULL);
+    _assert_mismatch(cm_rbt_uln_n(&t, node) == NULL);
+
+    cm_rbt_emp(&t);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_MISMATCH);
+
+    //the tree still holds every key, in order
+    ck_assert_int_eq(t.size, 10);
+    _assert_black_height(t.root);
+
+    i = 0;
+    cm_rbt_foreach(&t, node) {
+        ck_assert_int_eq(((data *) node->key)->x, i);
+        ++i;
+    }
+    ck_assert_int_eq(i, 10);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_rbt_from_sorted() into an augmented tree [no fixture]
+START_TEST(test_rbt_from_sorted_aug) {
+
+    int ret;
+    data keys[100];
+
+    for (int i = 0; i < 100; ++i) keys[i].x = i * 2;
+
+    //subtree sizes are computed as the tree is built, data is left unset
+    cm_new_rbt_ost(&t, sizeof(d), sizeof(d), compare);
+    ret = cm_rbt_from_sorted(&t, keys, NULL, 100);
+    ck_assert_int_eq(ret, 0);
+
+    for (int i = 0; i < 100; ++i) {
+        ck_assert_int_eq(((data *) cm_rbt_select(&t, i)->key)->x, i * 2);
+        ck_assert_int_eq(cm_rbt_rank(&t, &keys[i]), i);
+    }
+
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//check the greatest end kept by each node of an interval tree
+static uintptr_t _assert_max_end(const cm_rbt_node * node) {
+
+    uintptr_t max_end;
+
+    if (node == NULL) return 0;
+
+    max_end = ((cm_rbt_itv *) node->key)->end;
+    if (node->left != NULL) {
+        uintptr_t left_end = _assert_max_end(node->left);
+        if (left_end > max_end) max_end = left_end;
+    }
+    if (node->right != NULL) {
+        uintptr_t right_end = _assert_max_end(node->right);
+        if (right_end > max_end) max_end = right_end;
+    }
+
+    ck_assert_uint_eq(RBT_MAX_END(&t, node), max_end);
+
+    return max_end;
+}
+
+
+
+//compare overlap queries against a scan of every interval
+static void _assert_overlaps(const cm_rbt_itv * itvs, const bool * present,
+                             const int len, const cm_rbt_itv * query) {
+
+    int expected = 0, found = 0;
+    cm_rbt_itv * itv, * last = NULL;
+    cm_rbt_node * node;
+
+    for (int i = 0; i < len; ++i) {
+        if (present[i] && itvs[i].start < query->end 
+            && itvs[i].end > query->start) ++expected;
+    }
+
+    cm_rbt_foreach_overlap(&t, query, node) {
+
+        itv = node->key;
+        ck_assert(itv->start < query->end && itv->end > query->start);
+
+        //overlaps are visited in key order
+        if (last != NULL) {
+            ck_assert(last->start < itv->start 
+                      || (last->start == itv->start && last->end < itv->end));
+        }
+        last = itv;
+        ++found;
+    }
+
+    ck_assert_int_eq(found, expected);
+
+    return;
+}
+
+
+
+//cm_new_rbt_itv() & cm_rbt_foreach_overlap() [no fixture]
+START_TEST(test_rbt_itv) {
+
+    #define TEST_ITVS 500
+    cm_rbt_itv itvs[TEST_ITVS], query;
+    bool present[TEST_ITVS];
+    unsigned int seed = 1;
+    cm_rbt_node * node;
+
+    cm_new_rbt_itv(&t, sizeof(d));
+    ck_assert(t.mode == CM_RBT_INLINE);
+
+    //an empty tree overlaps nothing
+    query = (cm_rbt_itv) {0, UINTPTR_MAX};
+    cm_rbt_foreach_overlap(&t, &query, node) ck_abort();
+
+    //insert intervals of varying lengths
+    for (int i = 0; i < TEST_ITVS; ++i) {
+
+        seed = seed * 1103515245 + 12345;
+        itvs[i].start = (seed >> 8) % 10000;
+        itvs[i].end = itvs[i].start + 1 + (seed >> 4) % (i % 10 ? 50 : 2000);
+
+        //duplicate intervals share a node
+        present[i] = cm_rbt_get_n(&t, &itvs[i]) == NULL;
+        ck_assert_ptr_nonnull(cm_rbt_set(&t, &itvs[i], &d));
+    }
+    _assert_max_end(t.root);
+
+    //stabbing and overlap queries
+    for (uintptr_t start = 0; start < 11000; start += 97) {
+        query = (cm_rbt_itv) {start, start + 1};
+        _assert_overlaps(itvs, present, TEST_ITVS, &query);
+        query = (cm_rbt_itv) {start, start + 300};
+        _assert_overlaps(itvs, present, TEST_ITVS, &query);
+    }
+
+    //remove every other interval
+    for (int i = 0; i < TEST_ITVS; i += 2) {
+        if (!present[i]) continue;
+        ck_assert_int_eq(cm_rbt_rem(&t, &itvs[i]), 0);
+        present[i] = false;
+    }
+    _assert_max_end(t.root);
+
+    for (uintptr_t start = 0; start < 11000; start += 89) {
+        query = (cm_rbt_itv) {start, start + 1};
+        _assert_overlaps(itvs, present, TEST_ITVS, &query);
+        query = (cm_rbt_itv) {start, start + 500};
+        _assert_overlaps(itvs, present, TEST_ITVS, &query);
+    }
+
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//CM_RBT_DEFINE() & built-in comparators [no fixture]
+START_TEST(test_rbt_define) {
+
+    int ret;
+    data buf, * p;
+    be_key bk;
+    cm_rbt_node * node;
+
+    //generated functions on int keys
+    irbt_new(&t);
+    ck_assert(t.mode == CM_RBT_INLINE);
+
+    for (int i = 0; i < 100; ++i) {
+        d.x = (i * 37) % 100;
+        ck_assert_ptr_nonnull(irbt_set(&t, d.x, &d));
+    }
+    ck_assert_int_eq(t.size, 100);
+
+    ret = irbt_get(&t, 42, &buf);
+    ck_assert_int_eq(ret, 0);
+    ck_assert_int_eq(buf.x, 42);
+
+    //setting an existing key updates its data
+    d.x = 4200;
+    irbt_set(&t, 42, &d);
+    ck_assert_int_eq(irbt_get_p(&t, 42)->x, 4200);
+    ck_assert_int_eq(t.size, 100);
+
+    p = irbt_set_slot(&t, 100);
+    p->x = 100;
+    ck_assert_int_eq(irbt_get_p(&t, 100)->x, 100);
+
+    ck_assert_int_eq(*(int *) irbt_floor(&t, 1000)->key, 100);
+    ck_assert_int_eq(*(int *) irbt_ceil(&t, -5)->key, 0);
+
+    //remove the odd keys
+    for (int i = 1; i <= 100; i += 2) {
+        ret = irbt_rem(&t, i);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    cm_errno = 0;
+    ck_assert_ptr_null(irbt_get_n(&t, 1));
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+    ck_assert_int_eq(irbt_rem(&t, 1), -1);
+
+    //the tree is an ordinary tree
+    ck_assert_ptr_eq(cm_rbt_get_n(&t, &(int) {50}), irbt_get_n(&t, 50));
+    ret = 0;
+    cm_rbt_foreach(&t, node) {
+        ck_assert_int_eq(*(int *) node->key, ret);
+        ret += 2;
+    }
+    ck_assert_int_eq(ret, 102);
+
+    cm_del_rbt(&t);
+
+    //generated functions on memcmp keys
+    brbt_new(&t);
+
+    for (int i = 0; i < 1000; ++i) {
+        d.x = (i * 37) % 1000;
+        bk = (be_key) {{0, 0, (cm_byte) (d.x >> 8), (cm_byte) d.x}};
+        brbt_set(&t, bk, &d);
+    }
+
+    ret = 0;
+    cm_rbt_foreach(&t, node) {
+        ck_assert_int_eq(((data *) node->data)->x, ret);
+        ++ret;
+    }
+    ck_assert_int_eq(ret, 1000);
+
+    bk = (be_key) {{0, 0, 3, 0}};
+    ck_assert_int_eq(brbt_get_p(&t, bk)->x, 0x300);
+
+    cm_del_rbt(&t);
+
+    //built-in comparators for ordinary trees
+    cm_new_rbt(&t, sizeof(int), sizeof(d), cm_rbt_cmp_int);
+
+    for (d.x = 9; d.x >= -9; --d.x) cm_rbt_set(&t, &d.x, &d);
+    ck_assert_int_eq(*(int *) cm_rbt_first_n(&t)->key, -9);
+    ck_assert_int_eq(*(int *) cm_rbt_last_n(&t)->key, 9);
+
+    //remove nodes directly
+    ret = cm_rbt_rem_n(&t, cm_rbt_first_n(&t));
+    ck_assert_int_eq(ret, 0);
+    node = cm_rbt_uln_n(&t, cm_rbt_last_n(&t));
+    ck_assert_int_eq(*(int *) node->key, 9);
+    cm_del_rbt_node(node);
+    ck_assert_int_eq(t.size, 17);
+
+    cm_del_rbt(&t);
+
+    ck_assert_int_eq(cm_rbt_cmp_uptr(&(uintptr_t) {1}, &(uintptr_t) {2}), 
+                     LESS);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_new_rbt_inl() [no fixture]
+START_TEST(test_new_rbt_inl) {
+
+    cm_rbt_node * n, * uln_node;
+
+    //run test
+    cm_new_rbt_inl(&t, sizeof(d), sizeof(d), compare);
+
+    //assert result
+    ck_assert_int_eq(t.size, 0);
+    ck_assert_ptr_null(t.root);
+    ck_assert(t.mode == CM_RBT_INLINE);
+
+    //the colour and side are packed into the parent pointer
+    ck_assert_int_eq(offsetof(cm_rbt_node, parent_bits) + sizeof(uintptr_t),
+                     5 * sizeof(void *));
+
+    //the key and data follow the node in the same allocation
+    for (d.x = 0; d.x < 100; ++d.x) {
+        n = cm_rbt_set(&t, &d.x, &d);
+        ck_assert_ptr_nonnull(n);
+        ck_assert_ptr_eq(n->key, n->inl);
+        ck_assert((cm_byte *) n->data > (cm_byte *) n->key);
+        ck_assert_int_eq((uintptr_t) n->key % 16, 0);
+        ck_assert_int_eq((uintptr_t) n->data % 16, 0);
+        ck_assert_int_eq(((data *) n->data)->x, d.x);
+    }
+
+    //unlinked inline nodes are freed as a single allocation
+    d.x = 25;
+    uln_node = cm_rbt_uln(&t, &d.x);
+    ck_assert_int_eq(((data *) uln_node->data)->x, 25);
+    cm_del_rbt_node(uln_node);
+
+    //cleanup
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_new_rbt_arn() [no fixture]
+START_TEST(test_new_rbt_arn) {
+
+    int ret;
+    cm_rbt_node * n, * uln_node;
+
+    //run test
+    ret = cm_new_rbt_arn(&t, sizeof(d), sizeof(d), compare);
+    ck_assert_int_eq(ret, 0);
+
+    //assert result
+    ck_assert_int_eq(t.size, 0);
+    ck_assert_ptr_null(t.root);
+    ck_assert(t.mode == CM_RBT_ARENA);
+    ck_assert_ptr_nonnull(t.arn);
+
+    //the key and data follow the node in the same allocation
+    for (d.x = 0; d.x < 100; ++d.x) {
+        n = cm_rbt_set(&t, &d.x, &d);
+        ck_assert_ptr_nonnull(n);
+        ck_assert((cm_byte *) n->key > (cm_byte *) n);
+        ck_assert((cm_byte *) n->data > (cm_byte *) n->key);
+        ck_assert_int_eq((uintptr_t) n->key % 16, 0);
+        ck_assert_int_eq(((data *) n->data)->x, d.x);
+    }
+
+    //removed nodes are reused by later insertions
+    d.x = 50;
+    n = cm_rbt_get_n(&t, &d.x);
+    ret = cm_rbt_rem(&t, &d.x);
+    ck_assert_int_eq(ret, 0);
+
+    d.x = 1000;
+    ck_assert_ptr_eq(cm_rbt_set(&t, &d.x, &d), n);
+
+    //unlinked nodes stay valid until the tree is emptied
+    d.x = 25;
+    uln_node = cm_rbt_uln(&t, &d.x);
+    ck_assert_int_eq(((data *) uln_node->data)->x, 25);
+
+    //emptying frees the chunks, after which the tree is reusable
+    cm_rbt_emp(&t);
+    ck_assert_ptr_null(t.root);
+    ck_assert_int_eq(t.size, 0);
+
+    for (d.x = 0; d.x < 10; ++d.x) cm_rbt_set(&t, &d.x, &d);
+    ck_assert_int_eq(t.size, 10);
+
+    //cleanup
+    cm_del_rbt(&t);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_del_rbt_node [no fixture]
+START_TEST(test_del_rbt_node) {
+
+    /*
+     *  Using ASAN to check for leaks here.
+     */
+        
+    //setup test
+    cm_rbt_node * n = malloc(sizeof(cm_rbt_node));
+    n->key = malloc(sizeof(d));
+    n->data = malloc(sizeof(d));
+    
+    //run test
+    cm_del_rbt_node(n);
+    
+} END_TEST
+
+
+
+Suite * rbt_suite() {
+
+    //test cases
+    TCase * tc_new_cm_rbt;
+    TCase * tc_del_cm_rbt;
+
+    //internal test cases for debug builds
+    #ifdef DEBUG
+    TCase * tc__new_node;
+    TCase * tc__del_node;
+    TCase * tc__left_rotate;
+    TCase * tc__right_rotate;
+    TCase * tc__transplant;
+    TCase * tc__left_max;
+    TCase * tc__get_colour;
+    TCase * tc__populate_fix_data;
+    TCase * tc__determine_ins_case;
+    TCase * tc__determine_rem_case;
+    TCase * tc__ins_case_1;
+    TCase * tc__ins_case_2;
+    TCase * tc__ins_case_3;
+    TCase * tc__ins_case_4;
+    TCase * tc__rem_case_1;
+    TCase * tc__rem_case_2;
+    TCase * tc__rem_case_3;
+    TCase * tc__rem_case_4;
+    #endif
+
+    //test cases (cont.)
+    TCase * tc_rbt_set;
+    TCase * tc_rbt_set_slot;
+    TCase * tc_rbt_rem;
+    TCase * tc_rbt_uln;
+    TCase * tc_rbt_emp;
+    TCase * tc_rbt_foreach;
+    TCase * tc_del_rbt_node;
+    TCase * tc_new_rbt_arn;
+    TCase * tc_rbt_nav;
+    TCase * tc_rbt_define;
+    TCase * tc_rbt_itv;
+    TCase * tc_rbt_ost;
+    TCase * tc_rbt_aug;
+    TCase * tc_rbt_from_sorted;
+    TCase * tc_rbt_hint;
+    TCase * tc_rbt_split_join;
+    TCase * tc_rbt_sync;
+    TCase * tc_new_rbt_inl;
+    TCase * tc_rbt_inl;
+    TCase * tc_rbt_arn;
+
+    Suite * s = suite_create("rb_tree");
+
+
+    //tc_new_cm_rbt()
+    tc_new_cm_rbt = tcase_create("new_cm_rbt");
+    tcase_add_test(tc_new_cm_rbt, test_new_cm_rbt);
+
+    //tc_del_cm_rbt()
+    tc_del_cm_rbt = tcase_create("del_cm_rbt");
+    tcase_add_checked_fixture(tc_del_cm_rbt, _setup_stub, NULL);
+    tcase_add_test(tc_del_cm_rbt, test_del_cm_rbt);
+
+    #ifdef DEBUG
+    //tc__new_node()
+    tc__new_node = tcase_create("_new_node");
+    tcase_add_test(tc__new_node, test__new_node);
+    
+    //tc__del_node()
+    tc__del_node = tcase_create("_del_node");
+    tcase_add_test(tc__del_node, test__del_node);
+
+    //tc__left_rotate()
+    tc__left_rotate = tcase_create("_left_rotate");
+    tcase_add_checked_fixture(tc__left_rotate, _setup_stub, _teardown);
+    tcase_add_test(tc__left_rotate, test__left_rotate);
+
+    //tc__right_rotate()
+    tc__right_rotate = tcase_create("_right_rotate");
+    tcase_add_checked_fixture(tc__right_rotate, _setup_stub, _teardown);
+    tcase_add_test(tc__right_rotate, test__right_rotate);
+    
+    //tc__transplant()
+    tc__transplant = tcase_create("_transplant");
+    tcase_add_checked_fixture(tc__transplant, _setup_stub, _teardown);
+    tcase_add_test(tc__transplant, test__transplant);
+    
+    //tc__left_max()
+    tc__left_max = tcase_create("_left_max");
+    tcase_add_checked_fixture(tc__left_max, _setup_stub, _teardown);
+    tcase_add_test(tc__left_max, test__left_max);
+
+    //tc__get_colour()
+    tc__get_colour = tcase_create("_get_colour");
+    tcase_add_checked_fixture(tc__get_colour, _setup_stub, _teardown);
+    tcase_add_test(tc__get_colour, test__get_colour);
+
+    //tc__populate_fix_data()
+    tc__populate_fix_data = tcase_create("_populate_fix_data");
+    tcase_add_checked_fixture(tc__populate_fix_data, _setup_stub, _teardown);
+    tcase_add_test(tc__populate_fix_data, test__populate_fix_data);
+
+    //tc__determine_ins_case()
+    tc__determine_ins_case = tcase_create("_determine_ins_case");
+    tcase_add_test(tc__determine_ins_case, test__determine_ins_case);
+
+    //tc__determine_rem_case()
+    tc__determine_rem_case = tcase_create("_determine_rem_case");
+    tcase_add_test(tc__determine_rem_case, test__determine_rem_case);
+
+    //tc__ins_case_1
+    tc__ins_case_1 = tcase_create("_ins_case_1");
+    tcase_add_checked_fixture(tc__ins_case_1, _setup_stub, _teardown);
+    tcase_add_test(tc__ins_case_1, test__ins_case_1);
+
+    //tc__ins_case_2
+    tc__ins_case_2 = tcase_create("_ins_case_2");
+    tcase_add_checked_fixture(tc__ins_case_2, _setup_stub, _teardown);
+    tcase_add_test(tc__ins_case_2, test__ins_case_2);
+    
+    //tc__ins_case_3
+    tc__ins_case_3 = tcase_create("_ins_case_3");
+    tcase_add_checked_fixture(tc__ins_case_3, _setup_stub, _teardown);
+    tcase_add_test(tc__ins_case_3, test__ins_case_3);
+    
+    //tc__ins_case_4
+    tc__ins_case_4 = tcase_create("_ins_case_4");
+    tcase_add_checked_fixture(tc__ins_case_4, _setup_stub, _teardown);
+    tcase_add_test(tc__ins_case_4, test__ins_case_4);
+
+    //tc__rem_case_1
+    tc__rem_case_1 = tcase_create("_rem_case_1");
+    tcase_add_checked_fixture(tc__rem_case_1, _setup_stub, _teardown);
+    tcase_add_test(tc__rem_case_1, test__rem_case_1);
+    
+    //tc__rem_case_2
+    tc__rem_case_2 = tcase_create("_rem_case_2");
+    tcase_add_checked_fixture(tc__rem_case_2, _setup_stub, _teardown);
+    tcase_add_test(tc__rem_case_2, test__rem_case_2);
+    
+    //tc__rem_case_3
+    tc__rem_case_3 = tcase_create("_rem_case_3");
+    tcase_add_checked_fixture(tc__rem_case_3, _setup_stub, _teardown);
+    tcase_add_test(tc__rem_case_3, test__rem_case_3);
+    
+    //tc__rem_case_4
+    tc__rem_case_4 = tcase_create("_rem_case_4");
+    tcase_add_checked_fixture(tc__rem_case_4, _setup_stub, _teardown);
+    tcase_add_test(tc__rem_case_4, test__rem_case_4);
+    #endif
+
+    //tc_rbt_set
+    tc_rbt_set = tcase_create("rb_tree_set");
+    tcase_add_checked_fixture(tc_rbt_set, _setup_emp, _teardown);
+    tcase_add_test(tc_rbt_set, test_rbt_set);
+
+    //tc_rbt_set_slot
+    tc_rbt_set_slot = tcase_create("rb_tree_set_slot");
+    tcase_add_checked_fixture(tc_rbt_set_slot, _setup_emp, _teardown);
+    tcase_add_test(tc_rbt_set_slot, test_rbt_set_slot);
+
+    //tc_rbt_rem
+    tc_rbt_rem = tcase_create("rb_tree_rem");
+    tcase_add_checked_fixture(tc_rbt_rem, _setup_sorted_stub, _teardown);
+    tcase_add_test(tc_rbt_rem, test_rbt_rem);
+
+    //tc_rbt_uln
+    tc_rbt_uln = tcase_create("rb_tree_uln");
+    tcase_add_checked_fixture(tc_rbt_uln, _setup_sorted_stub, _teardown);
+    tcase_add_test(tc_rbt_uln, test_rbt_uln);
+
+    //tc_rbt_emp
+    tc_rbt_emp = tcase_create("rb_tree_emp");
+    tcase_add_checked_fixture(tc_rbt_emp, _setup_stub, _teardown);
+    tcase_add_test(tc_rbt_emp, test_rbt_emp);
+
+    //tc_rbt_foreach
+    tc_rbt_foreach = tcase_create("rb_tree_foreach");
+    tcase_add_checked_fixture(tc_rbt_foreach, _setup_emp, _teardown);
+    tcase_add_test(tc_rbt_foreach, test_rbt_foreach);
+
+    //tc_del_rbt_node
+    tc_del_rbt_node = tcase_create("del_rbt_node");
+    tcase_add_test(tc_del_rbt_node, test_del_rbt_node);
+
+    //tc_rbt_nav
+    tc_rbt_nav = tcase_create("rb_tree_nav");
+    tcase_add_checked_fixture(tc_rbt_nav, _setup_emp, _teardown);
+    tcase_add_test(tc_rbt_nav, test_rbt_nav);
+
+    //tc_rbt_define
+    tc_rbt_define = tcase_create("rb_tree_define");
+    tcase_add_test(tc_rbt_define, test_rbt_define);
+
+    //tc_rbt_itv
+    tc_rbt_itv = tcase_create("rb_tree_itv");
+    tcase_add_test(tc_rbt_itv, test_rbt_itv);
+
+    //tc_rbt_ost
+    tc_rbt_ost = tcase_create("rb_tree_ost");
+    tcase_add_test(tc_rbt_ost, test_rbt_ost);
+    tcase_add_test(tc_rbt_ost, test_rbt_from_sorted_aug);
+    tcase_add_test(tc_rbt_ost, test_rbt_split_join_ost);
+
+    //tc_rbt_aug
+    tc_rbt_aug = tcase_create("rb_tree_aug");
+    tcase_add_test(tc_rbt_aug, test_rbt_aug);
+
+    //tc_rbt_from_sorted
+    tc_rbt_from_sorted = tcase_create("rb_tree_from_sorted");
+    tcase_add_checked_fixture(tc_rbt_from_sorted, _setup_emp, _teardown);
+    tcase_add_test(tc_rbt_from_sorted, test_rbt_from_sorted);
+
+    //tc_rbt_hint
+    tc_rbt_hint = tcase_create("rb_tree_hint");
+    tcase_add_checked_fixture(tc_rbt_hint, _setup_emp, _teardown);
+    tcase_add_test(tc_rbt_hint, test_rbt_hint);
+
+    //cm_rbt_split(), cm_rbt_join(), set operations & cm_rbt_rem_range()
+    tc_rbt_split_join = tcase_create("rb_tree_split_join");
+    tcase_add_checked_fixture(tc_rbt_split_join, _setup_emp, _teardown);
+    tcase_add_test(tc_rbt_split_join, test_rbt_split_join);
+    tcase_add_test(tc_rbt_split_join, test_rbt_set_ops);
+    tcase_add_test(tc_rbt_split_join, test_rbt_rem_range);
+
+    //tc_new_rbt_inl
+    tc_new_rbt_inl = tcase_create("new_rbt_inl");
+    tcase_add_test(tc_new_rbt_inl, test_new_rbt_inl);
+
+    //inline trees, reusing the tests above
+    tc_rbt_inl = tcase_create("rb_tree_inl");
+    tcase_add_checked_fixture(tc_rbt_inl, _setup_emp_inl, _teardown);
+    tcase_add_test(tc_rbt_inl, test_rbt_set);
+    tcase_add_test(tc_rbt_inl, test_rbt_set_slot);
+    tcase_add_test(tc_rbt_inl, test_rbt_foreach);
+    tcase_add_test(tc_rbt_inl, test_rbt_nav);
+    tcase_add_test(tc_rbt_inl, test_rbt_from_sorted);
+    tcase_add_test(tc_rbt_inl, test_rbt_hint);
+    tcase_add_test(tc_rbt_inl, test_rbt_split_join);
+    tcase_add_test(tc_rbt_inl, test_rbt_set_ops);
+    tcase_add_test(tc_rbt_inl, test_rbt_rem_range);
+
+    //tc_new_rbt_arn
+    tc_new_rbt_arn = tcase_create("new_rbt_arn");
+    tcase_add_test(tc_new_rbt_arn, test_new_rbt_arn);
+
+    //arena trees, reusing the tests above
+    tc_rbt_arn = tcase_create("rb_tree_arn");
+    tcase_add_checked_fixture(tc_rbt_arn, _setup_emp_arn, _teardown);
+    tcase_add_test(tc_rbt_arn, test_rbt_set);
+    tcase_add_test(tc_rbt_arn, test_rbt_set_slot);
+    tcase_add_test(tc_rbt_arn, test_rbt_foreach);
+    tcase_add_test(tc_rbt_arn, test_rbt_from_sorted);
+    tcase_add_test(tc_rbt_arn, test_rbt_hint);
+    tcase_add_test(tc_rbt_arn, test_rbt_rem_range);
+
+    //concurrent trees, reusing the tests above from a single thread
+    tc_rbt_sync = tcase_create("rb_tree_sync");
+    tcase_add_checked_fixture(tc_rbt_sync, _setup_emp_sync, _teardown);
+    tcase_set_timeout(tc_rbt_sync, 30);
+    tcase_add_test(tc_rbt_sync, test_rbt_sync);
+    tcase_add_test(tc_rbt_sync, test_rbt_sync_plain);
 
 
     //add test cases to red-black tree suite
@@ -1551,10 +2991,25 @@ Suite * rbt_suite() {
 
     //add test cases to red-black tree suite (cont.)
     suite_add_tcase(s, tc_rbt_set);
+    suite_add_tcase(s, tc_rbt_set_slot);
     suite_add_tcase(s, tc_rbt_rem);
     suite_add_tcase(s, tc_rbt_uln);
     suite_add_tcase(s, tc_rbt_emp);
+    suite_add_tcase(s, tc_rbt_foreach);
     suite_add_tcase(s, tc_del_rbt_node);
+    suite_add_tcase(s, tc_rbt_nav);
+    suite_add_tcase(s, tc_rbt_define);
+    suite_add_tcase(s, tc_rbt_itv);
+    suite_add_tcase(s, tc_rbt_ost);
+    suite_add_tcase(s, tc_rbt_aug);
+    suite_add_tcase(s, tc_rbt_from_sorted);
+    suite_add_tcase(s, tc_rbt_hint);
+    suite_add_tcase(s, tc_rbt_split_join);
+    suite_add_tcase(s, tc_new_rbt_inl);
+    suite_add_tcase(s, tc_rbt_inl);
+    suite_add_tcase(s, tc_new_rbt_arn);
+    suite_add_tcase(s, tc_rbt_arn);
+    suite_add_tcase(s, tc_rbt_sync);
 
     return s;
 }
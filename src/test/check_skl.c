@@ -0,0 +1,318 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+#include <pthread.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "test_data.h"
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/skl.h"
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *      The skip list is tested through exported functions, first from a
+ *      single thread and then from many writers and readers at once.
+ */
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//globals
+#define TEST_LEN_FULL 100
+#define TEST_THREADS 8
+#define TEST_KEYS 5000
+
+static cm_skl sl;
+static data d;
+
+
+
+static enum cm_rbt_side _compare(const void * b_1, const void * b_2) {
+
+    const data * d_1 = b_1, * d_2 = b_2;
+
+    if (d_1->x > d_2->x) return MORE;
+    if (d_1->x < d_2->x) return LESS;
+
+    return EQUAL;
+}
+
+
+
+//empty skip list setup
+static void _setup_emp() {
+
+    int ret = cm_new_skl(&sl, sizeof(d), sizeof(d), _compare);
+    ck_assert_int_eq(ret, 0);
+    d.x = 0;
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_skl(&sl);
+    d.x = -1;
+
+    return;
+}
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+//keys of the bottom level must be strictly increasing
+static void _assert_sorted(int len) {
+
+    int count = 0, last = -1;
+    _skl_node * node = sl.head->next[0];
+
+    while (node != NULL) {
+        ck_assert_int_gt(((data *) node->key)->x, last);
+        last = ((data *) node->key)->x;
+        node = node->next[0];
+        ++count;
+    }
+
+    ck_assert_int_eq(count, len);
+    ck_assert_int_eq(sl.size, len);
+
+    return;
+}
+
+
+
+//insert every key of a thread's range, then remove the even ones
+static void * _writer(void * arg) {
+
+    data e;
+    long id = (long) arg;
+
+    for (int i = 0; i < TEST_KEYS; ++i) {
+        e.x = (int) (i * TEST_THREADS + id);
+        if (cm_skl_ins(&sl, &e, &e)) return (void *) -1;
+    }
+
+    for (int i = 0; i < TEST_KEYS; i += 2) {
+        e.x = (int) (i * TEST_THREADS + id);
+        if (cm_skl_rem(&sl, &e)) return (void *) -1;
+    }
+
+    return NULL;
+}
+
+
+
+//race other threads to insert the same keys
+static void * _racer(void * arg) {
+
+    data e;
+    long won = 0;
+
+    (void) arg;
+
+    for (e.x = 0; e.x < TEST_KEYS; ++e.x) {
+        if (cm_skl_ins(&sl, &e, &e) == 0) ++won;
+    }
+
+    return (void *) won;
+}
+
+
+
+//look keys up while writers run, checking found data matches the key
+static void * _reader(void * arg) {
+
+    data key, buf;
+
+    (void) arg;
+
+    for (int i = 0; i < TEST_KEYS * TEST_THREADS; ++i) {
+        key.x = i;
+        if (cm_skl_get(&sl, &key, &buf) == 0 && buf.x != key.x) {
+            return (void *) -1;
+        }
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_skl_ins(), cm_skl_get() & cm_skl_rem() [empty fixture]
+START_TEST(test_skl) {
+
+    int ret;
+    data buf;
+
+    //look up a key in an empty skip list
+    cm_errno = 0;
+    ret = cm_skl_get(&sl, &d, &buf);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //insert keys out of order
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        d.x = (i * 37) % TEST_LEN_FULL;
+        ret = cm_skl_ins(&sl, &d, &d);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    _assert_sorted(TEST_LEN_FULL);
+
+    //a key can only be inserted once
+    d.x = 50;
+    ret = cm_skl_ins(&sl, &d, &d);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_DUPLICATE);
+
+    //every key is found with its data
+    for (d.x = 0; d.x < TEST_LEN_FULL; ++d.x) {
+        ret = cm_skl_get(&sl, &d, &buf);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(buf.x, d.x);
+    }
+
+    //remove the even keys
+    for (d.x = 0; d.x < TEST_LEN_FULL; d.x += 2) {
+        ret = cm_skl_rem(&sl, &d);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    _assert_sorted(TEST_LEN_FULL / 2);
+
+    for (d.x = 0; d.x < TEST_LEN_FULL; ++d.x) {
+        ret = cm_skl_get(&sl, &d, &buf);
+        ck_assert_int_eq(ret, d.x % 2 ? 0 : -1);
+    }
+
+    //remove a key that is not present
+    cm_errno = 0;
+    d.x = 0;
+    ret = cm_skl_rem(&sl, &d);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_KEY);
+
+    //a removed key can be inserted again
+    ret = cm_skl_ins(&sl, &d, &d);
+    ck_assert_int_eq(ret, 0);
+    _assert_sorted(TEST_LEN_FULL / 2 + 1);
+
+    return;
+
+} END_TEST
+
+
+
+//concurrent writers and readers [empty fixture]
+START_TEST(test_skl_threads) {
+
+    int ret;
+    void * status;
+    long won = 0;
+    data buf;
+    pthread_t writers[TEST_THREADS], readers[TEST_THREADS];
+
+    for (long i = 0; i < TEST_THREADS; ++i) {
+        ret = pthread_create(&writers[i], NULL, _writer, (void *) i);
+        ck_assert_int_eq(ret, 0);
+        ret = pthread_create(&readers[i], NULL, _reader, NULL);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (int i = 0; i < TEST_THREADS; ++i) {
+        pthread_join(writers[i], &status);
+        ck_assert_ptr_null(status);
+        pthread_join(readers[i], &status);
+        ck_assert_ptr_null(status);
+    }
+
+    //exactly the odd keys of every writer remain
+    _assert_sorted(TEST_KEYS / 2 * TEST_THREADS);
+
+    for (int i = 0; i < TEST_KEYS * TEST_THREADS; ++i) {
+        d.x = i;
+        ret = cm_skl_get(&sl, &d, &buf);
+        ck_assert_int_eq(ret, (i / TEST_THREADS) % 2 ? 0 : -1);
+    }
+
+    //remove every key, then race threads to insert the same keys
+    for (int i = 0; i < TEST_KEYS * TEST_THREADS; ++i) {
+        d.x = i;
+        cm_skl_rem(&sl, &d);
+    }
+
+    _assert_sorted(0);
+
+    for (long i = 0; i < TEST_THREADS; ++i) {
+        ret = pthread_create(&writers[i], NULL, _racer, NULL);
+        ck_assert_int_eq(ret, 0);
+    }
+
+    for (int i = 0; i < TEST_THREADS; ++i) {
+        pthread_join(writers[i], &status);
+        won += (long) status;
+    }
+
+    //each key was inserted by exactly one thread
+    ck_assert_int_eq(won, TEST_KEYS);
+    _assert_sorted(TEST_KEYS);
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * skl_suite() {
+
+    //test cases
+    TCase * tc_skl;
+    TCase * tc_skl_threads;
+
+    Suite * s = suite_create("skip list");
+
+
+    //cm_skl_ins(), cm_skl_get() & cm_skl_rem()
+    tc_skl = tcase_create("skip_list");
+    tcase_add_checked_fixture(tc_skl, _setup_emp, _teardown);
+    tcase_add_test(tc_skl, test_skl);
+
+    //concurrent writers and readers
+    tc_skl_threads = tcase_create("skip_list_threads");
+    tcase_add_checked_fixture(tc_skl_threads, _setup_emp, _teardown);
+    tcase_set_timeout(tc_skl_threads, 30);
+    tcase_add_test(tc_skl_threads, test_skl_threads);
+
+
+    //add test cases to skip list suite
+    suite_add_tcase(s, tc_skl);
+    suite_add_tcase(s, tc_skl_threads);
+
+    return s;
+}
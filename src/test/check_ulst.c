@@ -0,0 +1,516 @@
+//standard library
+#include <stdio.h>
+#include <stdlib.h>
+
+//system headers
+#include <unistd.h>
+
+//external libraries
+#include <check.h>
+
+//local headers
+#include "test_data.h"
+#include "suites.h"
+
+//test target headers
+#include "../lib/cmore.h"
+#include "../lib/ulst.h"
+
+
+/*
+ *  [BASIC TEST]
+ *
+ *      Unrolled lists are tested through exported functions, checking
+ *      the layout of the nodes after every operation.
+ */
+
+
+/*
+ *  --- [FIXTURES] ---
+ */
+
+//globals
+#define TEST_LEN_FULL 100
+static cm_ulst l;
+static data d;
+
+//expected contents of the list
+static int expected[TEST_LEN_FULL * 2];
+static int expected_len;
+
+
+
+//empty list setup
+static void _setup_emp() {
+
+    cm_new_ulst(&l, sizeof(d));
+    d.x = 0;
+    expected_len = 0;
+
+    return;
+}
+
+
+
+//populated list setup
+static void _setup_full() {
+
+    _setup_emp();
+
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        d.x = i;
+        cm_ulst_apd(&l, &d);
+        expected[expected_len++] = i;
+    }
+
+    return;
+}
+
+
+
+static void _teardown() {
+
+    cm_del_ulst(&l);
+    d.x = -1;
+
+    return;
+}
+
+
+
+/*
+ *  --- [HELPERS] ---
+ */
+
+static void _expected_ins(const int index, const int value) {
+
+    for (int i = expected_len; i > index; --i) {
+        expected[i] = expected[i - 1];
+    }
+
+    expected[index] = value;
+    expected_len++;
+
+    return;
+}
+
+
+
+static void _expected_rem(const int index) {
+
+    for (int i = index; i < expected_len - 1; ++i) {
+        expected[i] = expected[i + 1];
+    }
+
+    expected_len--;
+
+    return;
+}
+
+
+
+//check the contents of the list and the layout of its nodes
+static void _assert_state() {
+
+    int count = 0;
+    cm_ulst_node * node = l.head;
+
+    ck_assert_int_eq(l.len, expected_len);
+    if (expected_len == 0) {
+        ck_assert_ptr_null(l.head);
+        return;
+    }
+
+    do {
+
+        //no node is empty or overfull
+        ck_assert_int_gt(node->len, 0);
+        ck_assert_int_le(node->len, l.node_cap);
+        ck_assert_ptr_eq(node->next->prev, node);
+
+        //every node but the tail is at least half full
+        if (node->next != l.head) ck_assert_int_ge(node->len, l.node_cap / 2);
+
+        for (int i = 0; i < node->len; ++i) {
+            ck_assert_int_eq(((data *) cm_ulst_elem(&l, node, i))->x,
+                             expected[count + i]);
+        }
+
+        count += node->len;
+        node = node->next;
+
+    } while (node != l.head);
+
+    ck_assert_int_eq(count, expected_len);
+
+    return;
+}
+
+
+
+/*
+ *  --- [UNIT TESTS] ---
+ */
+
+//cm_new_ulst() [no fixture]
+START_TEST(test_new_ulst) {
+
+    cm_ulst ul;
+
+    //small elements fill the target node size
+    cm_new_ulst(&ul, sizeof(int));
+    ck_assert_int_eq(ul.len, 0);
+    ck_assert_ptr_null(ul.head);
+    ck_assert_ptr_null(ul.cursor);
+    ck_assert_int_eq(ul.node_cap, ULST_NODE_DATA_SZ / sizeof(int));
+
+    //large elements still share a node
+    cm_new_ulst(&ul, ULST_NODE_DATA_SZ);
+    ck_assert_int_eq(ul.node_cap, ULST_MIN_NODE_CAP);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ulst_apd() [empty fixture]
+START_TEST(test_ulst_apd) {
+
+    data * e;
+
+    //append to empty list
+    e = cm_ulst_apd(&l, &d);
+    ck_assert_ptr_nonnull(e);
+    ck_assert_int_eq(e->x, 0);
+    expected[expected_len++] = 0;
+    _assert_state();
+
+    //append until several nodes are full
+    for (int i = 1; i < l.node_cap * 3 + 1; ++i) {
+        d.x = i;
+        cm_ulst_apd(&l, &d);
+        expected[expected_len++] = i;
+    }
+    _assert_state();
+
+    //appending leaves every node but the tail full
+    ck_assert_int_eq(l.head->len, l.node_cap);
+    ck_assert_int_eq(l.head->prev->len, 1);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ulst_get(), cm_ulst_get_p() & cm_ulst_get_n() [full fixture]
+START_TEST(test_ulst_get) {
+
+    int ret, pos;
+    data * e;
+    cm_ulst_node * n;
+
+    //get every element forwards, then backwards
+    for (int i = 0; i < TEST_LEN_FULL; ++i) {
+        ret = cm_ulst_get(&l, i, &d);
+        ck_assert_int_eq(ret, 0);
+        ck_assert_int_eq(d.x, i);
+    }
+
+    for (int i = -1; i > -TEST_LEN_FULL; --i) {
+        e = cm_ulst_get_p(&l, i);
+        ck_assert_int_eq(e->x, TEST_LEN_FULL + i);
+    }
+
+    //get the node and position of an element
+    n = cm_ulst_get_n(&l, l.node_cap + 1, &pos);
+    ck_assert_ptr_eq(n, l.head->next);
+    ck_assert_int_eq(pos, 1);
+    ck_assert_ptr_eq(l.cursor, n);
+    ck_assert_int_eq(l.cursor_idx, l.node_cap);
+
+    //get invalid index (+ve index)
+    cm_errno = 0;
+    ret = cm_ulst_get(&l, TEST_LEN_FULL, &d);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    //get invalid index (-ve index)
+    cm_errno = 0;
+    e = cm_ulst_get_p(&l, -TEST_LEN_FULL);
+    ck_assert_ptr_null(e);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ulst_set() [full fixture]
+START_TEST(test_ulst_set) {
+
+    data * e;
+
+    //set start, middle, and end
+    d.x = 500;
+    e = cm_ulst_set(&l, 0, &d);
+    ck_assert_int_eq(e->x, 500);
+    expected[0] = 500;
+
+    d.x = 501;
+    cm_ulst_set(&l, TEST_LEN_FULL / 2, &d);
+    expected[TEST_LEN_FULL / 2] = 501;
+
+    d.x = 502;
+    cm_ulst_set(&l, -1, &d);
+    expected[TEST_LEN_FULL - 1] = 502;
+
+    _assert_state();
+
+    //set invalid index
+    cm_errno = 0;
+    e = cm_ulst_set(&l, TEST_LEN_FULL, &d);
+    ck_assert_ptr_null(e);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ulst_ins() [full fixture]
+START_TEST(test_ulst_ins) {
+
+    data * e;
+
+    //insert into a full node, splitting it
+    d.x = 1000;
+    e = cm_ulst_ins(&l, 3, &d);
+    ck_assert_int_eq(e->x, 1000);
+    _expected_ins(3, 1000);
+    _assert_state();
+
+    //insert at the start, end, and with negative indeces
+    d.x = 1001;
+    cm_ulst_ins(&l, 0, &d);
+    _expected_ins(0, 1001);
+
+    d.x = 1002;
+    cm_ulst_ins(&l, l.len, &d);
+    _expected_ins(expected_len, 1002);
+
+    d.x = 1003;
+    cm_ulst_ins(&l, -1, &d);
+    _expected_ins(expected_len, 1003);
+
+    d.x = 1004;
+    cm_ulst_ins(&l, -10, &d);
+    _expected_ins(expected_len + 1 - 10, 1004);
+    _assert_state();
+
+    //insert repeatedly at the same spot
+    for (int i = 0; i < TEST_LEN_FULL / 2; ++i) {
+        d.x = 2000 + i;
+        cm_ulst_ins(&l, 40, &d);
+        _expected_ins(40, 2000 + i);
+    }
+    _assert_state();
+
+    //insert at an invalid index
+    cm_errno = 0;
+    e = cm_ulst_ins(&l, l.len + 1, &d);
+    ck_assert_ptr_null(e);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ulst_rem() [full fixture]
+START_TEST(test_ulst_rem) {
+
+    int ret;
+
+    //remove from the start, end, and middle
+    ret = cm_ulst_rem(&l, 0);
+    ck_assert_int_eq(ret, 0);
+    _expected_rem(0);
+
+    cm_ulst_rem(&l, -1);
+    _expected_rem(expected_len - 1);
+
+    cm_ulst_rem(&l, 50);
+    _expected_rem(50);
+    _assert_state();
+
+    //remove repeatedly from one node, merging it with its neighbours
+    for (int i = 0; i < TEST_LEN_FULL / 2; ++i) {
+        cm_ulst_rem(&l, 10);
+        _expected_rem(10);
+        _assert_state();
+    }
+
+    //remove every other element
+    for (int i = expected_len - 1; i >= 0; i -= 2) {
+        cm_ulst_rem(&l, i);
+        _expected_rem(i);
+    }
+    _assert_state();
+
+    //remove the rest
+    while (l.len > 0) {
+        cm_ulst_rem(&l, l.len - 1);
+        _expected_rem(expected_len - 1);
+    }
+    _assert_state();
+
+    //remove from an empty list
+    cm_errno = 0;
+    ret = cm_ulst_rem(&l, 0);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ulst_ins_n() & cm_ulst_rem_n() [full fixture]
+START_TEST(test_ulst_ins_rem_n) {
+
+    int ret, pos;
+    data * e;
+    cm_ulst_node * n;
+
+    //insert through a node handle
+    n = cm_ulst_get_n(&l, 5, &pos);
+    d.x = 3000;
+    e = cm_ulst_ins_n(&l, n, pos, &d);
+    ck_assert_int_eq(e->x, 3000);
+    _expected_ins(5, 3000);
+    _assert_state();
+
+    //the element is found by index afterwards
+    e = cm_ulst_get_p(&l, 5);
+    ck_assert_int_eq(e->x, 3000);
+
+    //remove through a node handle
+    n = cm_ulst_get_n(&l, 60, &pos);
+    ret = cm_ulst_rem_n(&l, n, pos);
+    ck_assert_int_eq(ret, 0);
+    _expected_rem(60);
+    _assert_state();
+
+    //use an invalid position
+    n = cm_ulst_get_n(&l, 0, &pos);
+    cm_errno = 0;
+    e = cm_ulst_ins_n(&l, n, n->len + 1, &d);
+    ck_assert_ptr_null(e);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    cm_errno = 0;
+    ret = cm_ulst_rem_n(&l, n, n->len);
+    ck_assert_int_eq(ret, -1);
+    ck_assert_int_eq(cm_errno, CM_ERR_USER_INDEX);
+
+    return;
+
+} END_TEST
+
+
+
+//cm_ulst_emp() [full fixture]
+START_TEST(test_ulst_emp) {
+
+    cm_ulst_emp(&l);
+    expected_len = 0;
+    _assert_state();
+
+    //the list is usable after emptying
+    cm_ulst_apd(&l, &d);
+    expected[expected_len++] = d.x;
+    _assert_state();
+
+    return;
+
+} END_TEST
+
+
+
+/*
+ *  --- [SUITE] ---
+ */
+
+Suite * ulst_suite() {
+
+    //test cases
+    TCase * tc_new_ulst;
+    TCase * tc_ulst_apd;
+    TCase * tc_ulst_get;
+    TCase * tc_ulst_set;
+    TCase * tc_ulst_ins;
+    TCase * tc_ulst_rem;
+    TCase * tc_ulst_ins_rem_n;
+    TCase * tc_ulst_emp;
+
+    Suite * s = suite_create("unrolled list");
+
+
+    //cm_new_ulst()
+    tc_new_ulst = tcase_create("new_ulst");
+    tcase_add_test(tc_new_ulst, test_new_ulst);
+
+    //cm_ulst_apd()
+    tc_ulst_apd = tcase_create("unrolled_list_apd");
+    tcase_add_checked_fixture(tc_ulst_apd, _setup_emp, _teardown);
+    tcase_add_test(tc_ulst_apd, test_ulst_apd);
+
+    //cm_ulst_get(), cm_ulst_get_p() & cm_ulst_get_n()
+    tc_ulst_get = tcase_create("unrolled_list_get");
+    tcase_add_checked_fixture(tc_ulst_get, _setup_full, _teardown);
+    tcase_add_test(tc_ulst_get, test_ulst_get);
+
+    //cm_ulst_set()
+    tc_ulst_set = tcase_create("unrolled_list_set");
+    tcase_add_checked_fixture(tc_ulst_set, _setup_full, _teardown);
+    tcase_add_test(tc_ulst_set, test_ulst_set);
+
+    //cm_ulst_ins()
+    tc_ulst_ins = tcase_create("unrolled_list_ins");
+    tcase_add_checked_fixture(tc_ulst_ins, _setup_full, _teardown);
+    tcase_add_test(tc_ulst_ins, test_ulst_ins);
+
+    //cm_ulst_rem()
+    tc_ulst_rem = tcase_create("unrolled_list_rem");
+    tcase_add_checked_fixture(tc_ulst_rem, _setup_full, _teardown);
+    tcase_add_test(tc_ulst_rem, test_ulst_rem);
+
+    //cm_ulst_ins_n() & cm_ulst_rem_n()
+    tc_ulst_ins_rem_n = tcase_create("unrolled_list_ins_rem_n");
+    tcase_add_checked_fixture(tc_ulst_ins_rem_n, _setup_full, _teardown);
+    tcase_add_test(tc_ulst_ins_rem_n, test_ulst_ins_rem_n);
+
+    //cm_ulst_emp()
+    tc_ulst_emp = tcase_create("unrolled_list_emp");
+    tcase_add_checked_fixture(tc_ulst_emp, _setup_full, _teardown);
+    tcase_add_test(tc_ulst_emp, test_ulst_emp);
+
+
+    //add test cases to unrolled list suite
+    suite_add_tcase(s, tc_new_ulst);
+    suite_add_tcase(s, tc_ulst_apd);
+    suite_add_tcase(s, tc_ulst_get);
+    suite_add_tcase(s, tc_ulst_set);
+    suite_add_tcase(s, tc_ulst_ins);
+    suite_add_tcase(s, tc_ulst_rem);
+    suite_add_tcase(s, tc_ulst_ins_rem_n);
+    suite_add_tcase(s, tc_ulst_emp);
+
+    return s;
+}
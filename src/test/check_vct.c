@@ -192,6 +192,34 @@ START_TEST(test_vct_apd) {
 
 
 
+//cm_vct_apd_slot() [empty fixture]
+START_TEST(test_vct_apd_slot) {
+
+    data * slot;
+
+    //append to empty vector
+    slot = cm_vct_apd_slot(&v);
+    ck_assert_ptr_nonnull(slot);
+    slot->x = 0;
+    _assert_state(1, VECTOR_DEFAULT_SIZE, 0, 0);
+
+    //append until the vector has to grow
+    for (int i = 1; i < VECTOR_DEFAULT_SIZE + 1; ++i) {
+
+        slot = cm_vct_apd_slot(&v);
+        ck_assert_ptr_nonnull(slot);
+        slot->x = i;
+        _assert_state(i + 1, VECTOR_DEFAULT_SIZE
+                             * _power(2, (i / VECTOR_DEFAULT_SIZE)), i, i);
+
+    } //end for
+
+    return;
+
+} END_TEST
+
+
+
 //_grow() [empty fixture]
 START_TEST(test__grow) {
 
@@ -629,6 +657,39 @@ START_TEST(test_vct_emp) {
 
 
 
+//cm_vct_foreach() & cm_vct_foreach_rev() [full fixture]
+START_TEST(test_vct_foreach) {
+
+    int i;
+    data * e;
+
+    //visit every element in order
+    i = 0;
+    cm_vct_foreach(&v, e) {
+        ck_assert_int_eq(e->x, i);
+        ++i;
+    }
+    ck_assert_int_eq(i, TEST_LEN_FULL);
+
+    //visit every element in reverse order
+    i = TEST_LEN_FULL;
+    cm_vct_foreach_rev(&v, e) {
+        --i;
+        ck_assert_int_eq(e->x, i);
+    }
+    ck_assert_int_eq(i, 0);
+
+    //an empty vector is not visited
+    cm_vct_emp(&v);
+    cm_vct_foreach(&v, e) ck_abort();
+    cm_vct_foreach_rev(&v, e) ck_abort();
+
+    return;
+
+} END_TEST;
+
+
+
 /*
  *  --- [SUITE] ---
  */
@@ -639,6 +700,7 @@ Suite * vct_suite() {
     TCase * tc_new_vct;
     TCase * tc_del_vct;
     TCase * tc_vct_apd;
+    TCase * tc_vct_apd_slot;
     TCase * tc__grow;
     TCase * tc_vct_get;
     TCase * tc_vct_get_p;
@@ -647,6 +709,7 @@ Suite * vct_suite() {
     TCase * tc_vct_rem;
     TCase * tc_vct_fit;
     TCase * tc_vct_emp;
+    TCase * tc_vct_foreach;
 
     Suite * s = suite_create("vector");
     
@@ -665,6 +728,11 @@ Suite * vct_suite() {
     tcase_add_checked_fixture(tc_vct_apd, _setup_emp, _teardown);   
     tcase_add_test(tc_vct_apd, test_vct_apd);
     
+    //cm_vct_apd_slot()
+    tc_vct_apd_slot = tcase_create("vector_apd_slot");
+    tcase_add_checked_fixture(tc_vct_apd_slot, _setup_emp, _teardown);
+    tcase_add_test(tc_vct_apd_slot, test_vct_apd_slot);
+    
     //_grow()
     tc__grow = tcase_create("_grow");
     tcase_add_checked_fixture(tc__grow, _setup_emp, _teardown);
@@ -705,11 +773,17 @@ Suite * vct_suite() {
     tcase_add_checked_fixture(tc_vct_emp, _setup_full, _teardown);
     tcase_add_test(tc_vct_emp, test_vct_emp);
 
+    //cm_vct_foreach() & cm_vct_foreach_rev()
+    tc_vct_foreach = tcase_create("vector_foreach");
+    tcase_add_checked_fixture(tc_vct_foreach, _setup_full, _teardown);
+    tcase_add_test(tc_vct_foreach, test_vct_foreach);
+
 
     //add test cases to vector suite
     suite_add_tcase(s, tc_new_vct);
     suite_add_tcase(s, tc_del_vct);
     suite_add_tcase(s, tc_vct_apd);
+    suite_add_tcase(s, tc_vct_apd_slot);
     suite_add_tcase(s, tc__grow);
     suite_add_tcase(s, tc_vct_get);
     suite_add_tcase(s, tc_vct_get_p);
@@ -718,6 +792,7 @@ Suite * vct_suite() {
     suite_add_tcase(s, tc_vct_rem);
     suite_add_tcase(s, tc_vct_fit);
     suite_add_tcase(s, tc_vct_emp);
+    suite_add_tcase(s, tc_vct_foreach);
 
     return s;
 }
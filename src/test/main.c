@@ -55,7 +55,14 @@ static void _run_unit_tests() {
 
     Suite * s_vct;
     Suite * s_lst;
+    Suite * s_ilst;
+    Suite * s_ulst;
+    Suite * s_que;
     Suite * s_rbt;
+    Suite * s_skl;
+    Suite * s_lru;
+    Suite * s_btr;
+    Suite * s_prbt;
     Suite * s_error;
 
     SRunner * sr;
@@ -63,12 +70,26 @@ static void _run_unit_tests() {
     //initialise test suites
     s_vct = vct_suite();
     s_lst = lst_suite();
+    s_ilst = ilst_suite();
+    s_ulst = ulst_suite();
+    s_que = que_suite();
     s_rbt = rbt_suite(); 
+    s_skl = skl_suite();
+    s_lru = lru_suite();
+    s_btr = btr_suite();
+    s_prbt = prbt_suite();
 
     //create suite runner
     sr = srunner_create(s_vct);
     srunner_add_suite(sr, s_lst);
+    srunner_add_suite(sr, s_ilst);
+    srunner_add_suite(sr, s_ulst);
+    srunner_add_suite(sr, s_que);
     srunner_add_suite(sr, s_rbt);
+    srunner_add_suite(sr, s_skl);
+    srunner_add_suite(sr, s_lru);
+    srunner_add_suite(sr, s_btr);
+    srunner_add_suite(sr, s_prbt);
 
     //run tests
     srunner_run_all(sr, CK_VERBOSE);
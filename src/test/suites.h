@@ -7,8 +7,15 @@
 
 //unit test suites
 Suite * lst_suite();
+Suite * ilst_suite();
+Suite * ulst_suite();
+Suite * que_suite();
 Suite * vct_suite();
 Suite * rbt_suite();
+Suite * skl_suite();
+Suite * lru_suite();
+Suite * btr_suite();
+Suite * prbt_suite();
 
 //other tests
 void rbt_explore();